@@ -17,6 +17,8 @@
 #include <compressed/detail/scoped_timer.h>
 
 #include "memory_sampling.h"
+#include "regression.h"
+#include "synthetic.h"
 
 
 static const std::filesystem::path s_images_path = std::filesystem::current_path() / "images";
@@ -203,6 +205,17 @@ void bench_image_iteration_compressed_get_decompressed(benchmark::State& state,
 
 auto main(int argc, char** argv) -> int
 {
+	// Strip the regression-harness flags (--bench_save/--bench_baseline/--bench_compare/
+	// --bench_threshold) before handing the rest to google benchmark.
+	auto options = bench_regression::parse_args(argc, argv);
+	if (options.compare_mode)
+	{
+		// Pure compare mode, diff two stored result files without running anything.
+		auto baseline = bench_regression::load_results(options.compare_baseline);
+		auto current = bench_regression::load_results(options.compare_current);
+		return bench_regression::compare_results(baseline, current, options.threshold) > 0 ? 1 : 0;
+	}
+
 	compressed::detail::Instrumentor::Get().BeginSession("Benchmarks");
 
 	for (const auto& image : get_images())
@@ -218,8 +231,26 @@ auto main(int argc, char** argv) -> int
 		benchmark::RegisterBenchmark(std::format("Modify image get decompressed: {}", image.filename().string()), &bench_image_iteration_compressed_get_decompressed<half>, image)->Unit(benchmark::kMillisecond)->Iterations(5);
 	}
 
+	// Synthetic, machine-independent sweep over codec x block_size x chunk_size.
+	bench_synthetic::register_benchmarks();
+	// Half-float shuffle filter against the plain byte shuffle on f16 bit patterns.
+	bench_synthetic::register_half_filter_benchmarks();
+
 	benchmark::Initialize(&argc, argv);
-	benchmark::RunSpecifiedBenchmarks();
+	bench_regression::capturing_reporter reporter;
+	benchmark::RunSpecifiedBenchmarks(&reporter);
 
 	compressed::detail::Instrumentor::Get().EndSession();
+
+	if (!options.save_path.empty())
+	{
+		bench_regression::save_results(options.save_path, reporter.results());
+	}
+	if (!options.baseline_path.empty())
+	{
+		// Gate this run against the stored baseline, a nonzero exit fails the CI job.
+		auto baseline = bench_regression::load_results(options.baseline_path);
+		return bench_regression::compare_results(baseline, reporter.results(), options.threshold) > 0 ? 1 : 0;
+	}
+	return 0;
 }
\ No newline at end of file
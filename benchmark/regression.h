@@ -0,0 +1,262 @@
+#pragma once
+
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "nlohmann/json.hpp"
+
+
+/// Regression harness around the benchmark runs: serializes the per-benchmark results to a
+/// JSON baseline and diffs two such files (or the current run against a stored baseline) with
+/// a configurable failure threshold, so CI can gate on e.g. `image::read` getting >20% slower.
+namespace bench_regression
+{
+
+	/// The measurements we track per benchmark, everything else google benchmark reports is
+	/// too noisy to gate on.
+	struct result
+	{
+		double real_time_ms = 0.0;
+		double peak_memory_mb = 0.0;
+		/// Negative if the benchmark does not report a compression ratio.
+		double compression_ratio = -1.0;
+	};
+
+	/// Results keyed by the registered benchmark name, which already encodes the image
+	/// (e.g. "Read with compressed::image: foo.exr").
+	using result_map = std::map<std::string, result>;
+
+
+	/// Console reporter that additionally captures the per-run timings and counters so they
+	/// can be serialized after the run, the console output is unchanged.
+	class capturing_reporter final : public benchmark::ConsoleReporter
+	{
+	public:
+		void ReportRuns(const std::vector<Run>& runs) override
+		{
+			for (const auto& run : runs)
+			{
+				result res;
+				// GetAdjustedRealTime applies the registered time unit, all our benchmarks
+				// register with kMillisecond.
+				res.real_time_ms = run.GetAdjustedRealTime();
+				if (auto it = run.counters.find("Memory_Max_MB"); it != run.counters.end())
+				{
+					res.peak_memory_mb = it->second;
+				}
+				if (auto it = run.counters.find("Compression_Ratio"); it != run.counters.end())
+				{
+					res.compression_ratio = it->second;
+				}
+				m_Results[run.benchmark_name()] = res;
+			}
+			ConsoleReporter::ReportRuns(runs);
+		}
+
+		const result_map& results() const noexcept
+		{
+			return m_Results;
+		}
+
+	private:
+		result_map m_Results;
+	};
+
+
+	/// Serialize the results to the given path, overwriting any existing file.
+	inline void save_results(const std::filesystem::path& path, const result_map& results)
+	{
+		nlohmann::ordered_json document;
+		document["schema_version"] = 1;
+		auto& entries = document["benchmarks"];
+		entries = nlohmann::ordered_json::object();
+		for (const auto& [name, res] : results)
+		{
+			entries[name] = {
+				{ "real_time_ms", res.real_time_ms },
+				{ "peak_memory_mb", res.peak_memory_mb },
+				{ "compression_ratio", res.compression_ratio },
+			};
+		}
+
+		std::ofstream stream(path);
+		if (!stream)
+		{
+			throw std::runtime_error(std::format("Failed to open '{}' for writing benchmark results", path.string()));
+		}
+		stream << document.dump(4) << std::endl;
+		std::cout << std::format("Saved {} benchmark results to '{}'", results.size(), path.string()) << std::endl;
+	}
+
+	/// Load a result file previously written by `save_results`.
+	inline result_map load_results(const std::filesystem::path& path)
+	{
+		std::ifstream stream(path);
+		if (!stream)
+		{
+			throw std::runtime_error(std::format("Failed to open benchmark result file '{}'", path.string()));
+		}
+		auto document = nlohmann::ordered_json::parse(stream);
+
+		result_map results;
+		for (const auto& [name, entry] : document.at("benchmarks").items())
+		{
+			result res;
+			res.real_time_ms = entry.at("real_time_ms").get<double>();
+			res.peak_memory_mb = entry.at("peak_memory_mb").get<double>();
+			res.compression_ratio = entry.at("compression_ratio").get<double>();
+			results[name] = res;
+		}
+		return results;
+	}
+
+
+	namespace detail
+	{
+
+		/// The relative change from `baseline` to `current` where positive means worse, for
+		/// metrics where smaller is better (time, memory).
+		inline double relative_increase(double baseline, double current)
+		{
+			if (baseline <= 0.0)
+			{
+				return 0.0;
+			}
+			return (current - baseline) / baseline;
+		}
+
+	} // detail
+
+
+	/// Diff `current` against `baseline` and report every benchmark whose runtime or peak
+	/// memory regressed by more than `threshold` (a fraction, 0.2 == 20%), or whose
+	/// compression ratio dropped by more than it. Benchmarks present in only one of the two
+	/// sets are reported but never fail the comparison, CI baselines routinely trail newly
+	/// added benchmarks.
+	///
+	/// \return The number of benchmarks that regressed past the threshold.
+	inline size_t compare_results(const result_map& baseline, const result_map& current, double threshold)
+	{
+		size_t num_regressed = 0;
+		for (const auto& [name, current_result] : current)
+		{
+			auto it = baseline.find(name);
+			if (it == baseline.end())
+			{
+				std::cout << std::format("[  new   ] {}", name) << std::endl;
+				continue;
+			}
+			const auto& baseline_result = it->second;
+
+			const double time_delta = detail::relative_increase(baseline_result.real_time_ms, current_result.real_time_ms);
+			const double memory_delta = detail::relative_increase(baseline_result.peak_memory_mb, current_result.peak_memory_mb);
+			// For the compression ratio bigger is better so the comparison flips.
+			const double ratio_delta = detail::relative_increase(current_result.compression_ratio, baseline_result.compression_ratio);
+			const bool has_ratio = baseline_result.compression_ratio > 0.0 && current_result.compression_ratio > 0.0;
+
+			const bool regressed =
+				time_delta > threshold ||
+				memory_delta > threshold ||
+				(has_ratio && ratio_delta > threshold);
+			num_regressed += regressed ? 1 : 0;
+
+			std::cout << std::format(
+				"[{}] {}: time {:.2f}ms -> {:.2f}ms ({:+.1f}%), peak mem {:.2f}MB -> {:.2f}MB ({:+.1f}%)",
+				regressed ? "REGRESSED" : "   ok   ",
+				name,
+				baseline_result.real_time_ms, current_result.real_time_ms, time_delta * 100.0,
+				baseline_result.peak_memory_mb, current_result.peak_memory_mb, memory_delta * 100.0
+			);
+			if (has_ratio)
+			{
+				std::cout << std::format(
+					", compression ratio {:.3f} -> {:.3f}",
+					baseline_result.compression_ratio, current_result.compression_ratio
+				);
+			}
+			std::cout << std::endl;
+		}
+		for (const auto& [name, baseline_result] : baseline)
+		{
+			if (!current.contains(name))
+			{
+				std::cout << std::format("[missing ] {}", name) << std::endl;
+			}
+		}
+
+		std::cout << std::format(
+			"{} of {} benchmarks regressed past the {:.0f}% threshold",
+			num_regressed, current.size(), threshold * 100.0
+		) << std::endl;
+		return num_regressed;
+	}
+
+
+	/// The harness flags stripped out of argv by `parse_args`, everything else goes to
+	/// google benchmark untouched.
+	struct options
+	{
+		/// Write this run's results here (--bench_save=FILE).
+		std::filesystem::path save_path{};
+		/// Compare this run against a stored baseline and fail on regression (--bench_baseline=FILE).
+		std::filesystem::path baseline_path{};
+		/// Pure compare mode, diff two result files without running anything (--bench_compare=OLD,NEW).
+		std::filesystem::path compare_baseline{};
+		std::filesystem::path compare_current{};
+		bool compare_mode = false;
+		/// Relative regression threshold (--bench_threshold=0.2).
+		double threshold = 0.2;
+	};
+
+	/// Parse and strip the harness' own `--bench_*` flags from argv so the remaining flags can
+	/// be handed to `benchmark::Initialize` as usual.
+	inline options parse_args(int& argc, char** argv)
+	{
+		options opts;
+		int write_index = 1;
+		for (int read_index = 1; read_index < argc; ++read_index)
+		{
+			std::string arg = argv[read_index];
+			if (arg.starts_with("--bench_save="))
+			{
+				opts.save_path = arg.substr(std::strlen("--bench_save="));
+			}
+			else if (arg.starts_with("--bench_baseline="))
+			{
+				opts.baseline_path = arg.substr(std::strlen("--bench_baseline="));
+			}
+			else if (arg.starts_with("--bench_threshold="))
+			{
+				opts.threshold = std::stod(arg.substr(std::strlen("--bench_threshold=")));
+			}
+			else if (arg.starts_with("--bench_compare="))
+			{
+				auto value = arg.substr(std::strlen("--bench_compare="));
+				auto separator = value.find(',');
+				if (separator == std::string::npos)
+				{
+					throw std::invalid_argument("--bench_compare expects two comma-separated result files, e.g. --bench_compare=baseline.json,current.json");
+				}
+				opts.compare_baseline = value.substr(0, separator);
+				opts.compare_current = value.substr(separator + 1);
+				opts.compare_mode = true;
+			}
+			else
+			{
+				argv[write_index++] = argv[read_index];
+			}
+		}
+		argc = write_index;
+		return opts;
+	}
+
+} // bench_regression
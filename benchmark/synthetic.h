@@ -0,0 +1,297 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <memory>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <compressed/channel.h>
+#include <compressed/constants.h>
+#include <compressed/enums.h>
+
+
+namespace bench_synthetic
+{
+
+	namespace detail
+	{
+
+		/// Small deterministic LCG so the generated images are identical across machines and runs,
+		/// unlike benchmarking whatever files happen to sit in ./images/.
+		struct lcg
+		{
+			explicit lcg(uint64_t seed) : m_State(seed) {}
+
+			uint32_t next()
+			{
+				m_State = m_State * 6364136223846793005ULL + 1442695040888963407ULL;
+				return static_cast<uint32_t>(m_State >> 32);
+			}
+
+		private:
+			uint64_t m_State;
+		};
+
+		inline const char* codec_name(compressed::enums::codec codec)
+		{
+			switch (codec)
+			{
+			case compressed::enums::codec::blosclz: return "blosclz";
+			case compressed::enums::codec::lz4: return "lz4";
+			case compressed::enums::codec::lz4hc: return "lz4hc";
+			case compressed::enums::codec::zstd: return "zstd";
+			}
+			return "unknown";
+		}
+
+	} // detail
+
+
+	/// Smooth diagonal gradient, the best case for any codec as neighbouring values are
+	/// highly correlated.
+	inline std::vector<float> gradient(size_t width, size_t height)
+	{
+		std::vector<float> data(width * height);
+		for (size_t y = 0; y < height; ++y)
+		{
+			for (size_t x = 0; x < width; ++x)
+			{
+				data[y * width + x] = static_cast<float>(x + y) / static_cast<float>(width + height - 2);
+			}
+		}
+		return data;
+	}
+
+
+	/// Noise with a controlled number of random bits per value. `random_bits` steers the entropy:
+	/// 0 yields a constant image, 23 yields a fully random mantissa that barely compresses at all.
+	/// The values lie in [1, 2) so the exponent bits stay constant and only the mantissa varies.
+	inline std::vector<float> noise(size_t width, size_t height, uint32_t random_bits)
+	{
+		const uint32_t mantissa_mask = random_bits >= 23
+			? 0x007fffffu
+			: ((1u << random_bits) - 1u) << (23 - random_bits);
+
+		detail::lcg rng(0x5EED);
+		std::vector<float> data(width * height);
+		for (auto& value : data)
+		{
+			const uint32_t bits = 0x3f800000u | (rng.next() & mantissa_mask);
+			float as_float;
+			std::memcpy(&as_float, &bits, sizeof(as_float));
+			value = as_float;
+		}
+		return data;
+	}
+
+
+	/// Cryptomatte-like sparse coverage data: mostly zero with rectangular patches of a handful of
+	/// constant 'id' values scattered across the image.
+	inline std::vector<float> sparse_ids(size_t width, size_t height, size_t num_patches)
+	{
+		detail::lcg rng(0xC0FFEE);
+		std::vector<float> data(width * height, 0.0f);
+		for (size_t patch = 0; patch < num_patches; ++patch)
+		{
+			const size_t patch_width = 8 + rng.next() % 56;
+			const size_t patch_height = 8 + rng.next() % 56;
+			const size_t origin_x = rng.next() % width;
+			const size_t origin_y = rng.next() % height;
+			const float id = static_cast<float>(1 + rng.next() % 64);
+
+			for (size_t y = origin_y; y < std::min(origin_y + patch_height, height); ++y)
+			{
+				for (size_t x = origin_x; x < std::min(origin_x + patch_width, width); ++x)
+				{
+					data[y * width + x] = id;
+				}
+			}
+		}
+		return data;
+	}
+
+
+	/// Round-trip a synthetic image through channel<T> with the given compression parameters,
+	/// reporting the ratio and throughput as counters alongside the timings.
+	template <typename T>
+	void bench_roundtrip(
+		benchmark::State& state,
+		std::shared_ptr<std::vector<T>> data,
+		size_t width,
+		size_t height,
+		compressed::enums::codec codec,
+		size_t block_size,
+		size_t chunk_size,
+		compressed::enums::filter filter = compressed::enums::filter::shuffle)
+	{
+		const double uncompressed_mb = static_cast<double>(data->size() * sizeof(T)) / (1024.0 * 1024.0);
+
+		double compression_ratio = 0.0;
+		double compress_seconds = 0.0;
+		double decompress_seconds = 0.0;
+		size_t iterations = 0;
+
+		for (auto _ : state)
+		{
+			auto compress_start = std::chrono::steady_clock::now();
+			auto channel = compressed::channel<T>(
+				std::span<const T>(*data),
+				width,
+				height,
+				codec,
+				9,
+				block_size,
+				chunk_size,
+				filter
+			);
+			compress_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - compress_start).count();
+
+			auto decompress_start = std::chrono::steady_clock::now();
+			auto decompressed = channel.get_decompressed();
+			decompress_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - decompress_start).count();
+
+			benchmark::DoNotOptimize(decompressed);
+			benchmark::ClobberMemory();
+
+			compression_ratio = static_cast<double>(channel.uncompressed_size() * sizeof(T)) / static_cast<double>(channel.compressed_bytes());
+			++iterations;
+		}
+
+		state.counters["Compression_Ratio"] = compression_ratio;
+		state.counters["Compression_MBps"] = uncompressed_mb * iterations / compress_seconds;
+		state.counters["Decompression_MBps"] = uncompressed_mb * iterations / decompress_seconds;
+	}
+
+
+	/// Half-precision bit patterns derived from `noise`, i.e. sign 0, a constant exponent and
+	/// `random_bits` random mantissa bits. Stored as uint16_t since the bit layout is all the
+	/// codec and filters ever see.
+	inline std::vector<uint16_t> noise_half_bits(size_t width, size_t height, uint32_t random_bits)
+	{
+		const uint32_t mantissa_mask = random_bits >= 10
+			? 0x03ffu
+			: ((1u << random_bits) - 1u) << (10 - random_bits);
+
+		detail::lcg rng(0x5EED);
+		std::vector<uint16_t> data(width * height);
+		for (auto& value : data)
+		{
+			// Exponent 15 (biased), i.e. values in [1, 2) just like the float variant.
+			value = static_cast<uint16_t>(0x3c00u | (rng.next() & mantissa_mask));
+		}
+		return data;
+	}
+
+
+	/// Register the codec x block_size x chunk_size sweep over the synthetic generators. The
+	/// generated data is shared between all registrations of a generator so it is only built once.
+	inline void register_benchmarks()
+	{
+		constexpr size_t width = 2048;
+		constexpr size_t height = 2048;
+
+		const std::vector<std::pair<std::string, std::shared_ptr<std::vector<float>>>> sources = {
+			{ "gradient", std::make_shared<std::vector<float>>(gradient(width, height)) },
+			{ "noise_8bit", std::make_shared<std::vector<float>>(noise(width, height, 8)) },
+			{ "noise_23bit", std::make_shared<std::vector<float>>(noise(width, height, 23)) },
+			{ "sparse_ids", std::make_shared<std::vector<float>>(sparse_ids(width, height, 256)) },
+		};
+
+		constexpr std::array codecs = {
+			compressed::enums::codec::blosclz,
+			compressed::enums::codec::lz4,
+			compressed::enums::codec::lz4hc,
+			compressed::enums::codec::zstd,
+		};
+		constexpr std::array block_sizes = { compressed::s_default_blocksize, compressed::s_default_blocksize * 8 };
+		constexpr std::array chunk_sizes = { compressed::s_default_chunksize / 4, compressed::s_default_chunksize };
+
+		for (const auto& [name, data] : sources)
+		{
+			for (auto codec : codecs)
+			{
+				for (auto block_size : block_sizes)
+				{
+					for (auto chunk_size : chunk_sizes)
+					{
+						benchmark::RegisterBenchmark(
+							std::format(
+								"Synthetic roundtrip: {} codec={} block={} chunk={}",
+								name,
+								detail::codec_name(codec),
+								block_size,
+								chunk_size
+							),
+							&bench_roundtrip<float>,
+							data,
+							width,
+							height,
+							codec,
+							block_size,
+							chunk_size
+						)->Unit(benchmark::kMillisecond)->Iterations(3);
+					}
+				}
+			}
+		}
+	}
+
+
+	/// Register the half-float shuffle filter against the plain byte shuffle on 16-bit float bit
+	/// patterns of varying entropy, the delta-encoded sign/exponent plane is where the gains live.
+	inline void register_half_filter_benchmarks()
+	{
+		constexpr size_t width = 2048;
+		constexpr size_t height = 2048;
+
+		const std::vector<std::pair<std::string, std::shared_ptr<std::vector<uint16_t>>>> sources = {
+			{ "half_noise_4bit", std::make_shared<std::vector<uint16_t>>(noise_half_bits(width, height, 4)) },
+			{ "half_noise_10bit", std::make_shared<std::vector<uint16_t>>(noise_half_bits(width, height, 10)) },
+		};
+
+		constexpr std::array<std::pair<const char*, compressed::enums::filter>, 2> filters = { {
+			{ "shuffle", compressed::enums::filter::shuffle },
+			{ "half_shuffle", compressed::enums::filter::half_shuffle },
+		} };
+		constexpr std::array codecs = {
+			compressed::enums::codec::lz4,
+			compressed::enums::codec::zstd,
+		};
+
+		for (const auto& [name, data] : sources)
+		{
+			for (auto codec : codecs)
+			{
+				for (const auto& [filter_name, filter] : filters)
+				{
+					benchmark::RegisterBenchmark(
+						std::format(
+							"Synthetic roundtrip: {} codec={} filter={}",
+							name,
+							detail::codec_name(codec),
+							filter_name
+						),
+						&bench_roundtrip<uint16_t>,
+						data,
+						width,
+						height,
+						codec,
+						compressed::s_default_blocksize,
+						compressed::s_default_chunksize,
+						filter
+					)->Unit(benchmark::kMillisecond)->Iterations(3);
+				}
+			}
+		}
+	}
+
+} // bench_synthetic
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <span>
+#include <vector>
+#include <stdexcept>
+#include <format>
+
+#include "macros.h"
+#include "enums.h"
+#include "constants.h"
+#include "util.h"
+#include "blosc2/wrapper.h"
+#include "detail/scoped_timer.h"
+#include "detail/thread_budget.h"
+
+namespace NAMESPACE_COMPRESSED_IMAGE
+{
+
+	/// A codec configuration to be evaluated by `autotune`, mirroring the compression parameters
+	/// of `image<T>::read` and the `channel<T>` constructors.
+	struct tuning_candidate
+	{
+		enums::codec codec = enums::codec::lz4;
+		size_t compression_level = 9;
+		size_t block_size = s_default_blocksize;
+	};
+
+
+	/// The configuration chosen by `autotune` alongside the measurements that led to the choice.
+	///
+	/// The `codec`, `compression_level` and `block_size` fields can be passed straight through to
+	/// `image<T>::read` or a `channel<T>` constructor.
+	struct tuning_result
+	{
+		enums::codec codec = enums::codec::lz4;
+		size_t compression_level = 9;
+		size_t block_size = s_default_blocksize;
+
+		/// The measured compression ratio (uncompressed bytes / compressed bytes) over the samples.
+		double ratio = 0.0;
+		/// The measured compression throughput in bytes per second over the samples.
+		double compression_throughput = 0.0;
+		/// The measured decompression throughput in bytes per second over the samples.
+		double decompression_throughput = 0.0;
+		/// Whether the configuration met the requested ratio target, if no candidate did the one
+		/// with the best ratio is returned instead with this set to false.
+		bool met_ratio_target = true;
+	};
+
+
+	/// The default candidate set evaluated by `autotune` when none is provided.
+	///
+	/// Spans the configurations that in practice decide the throughput/ratio trade-off: the fast
+	/// lz4 codec against the denser zstd, each with a small L1-friendly and a large block size.
+	inline std::vector<tuning_candidate> default_tuning_candidates()
+	{
+		return {
+			tuning_candidate{ enums::codec::lz4, 9, s_default_blocksize },
+			tuning_candidate{ enums::codec::lz4, 9, s_default_blocksize * 8 },
+			tuning_candidate{ enums::codec::zstd, 9, s_default_blocksize },
+			tuning_candidate{ enums::codec::zstd, 9, s_default_blocksize * 8 },
+		};
+	}
+
+
+	/// Measure the given codec configurations against sampled chunks of `data` and pick the best.
+	///
+	/// Rather than guessing at `enums::codec` and block sizes per show, this compresses and
+	/// decompresses a handful of chunk-sized windows spread evenly across `data` with every
+	/// candidate and returns the one with the highest decompression throughput among those whose
+	/// compression ratio meets `ratio_target`. If no candidate reaches the target the one with the
+	/// best ratio is returned instead (see `tuning_result::met_ratio_target`).
+	///
+	/// The contexts are sized like a freshly created channel would size its own (the per-consumer
+	/// share of `compressed::thread_budget`) so the measurements transfer to real usage.
+	///
+	/// Example:
+	/// \code{.cpp}
+	/// std::vector<float> representative = ...;
+	/// auto tuned = compressed::autotune(std::span<const float>(representative));
+	/// auto img = compressed::image<float>::read(path, 0, tuned.codec, tuned.compression_level, tuned.block_size);
+	/// \endcode
+	///
+	/// \param data A representative sample of the content to be compressed, e.g. one decoded channel.
+	/// \param candidates The configurations to evaluate.
+	/// \param ratio_target The minimum compression ratio a candidate has to achieve to be eligible.
+	/// \param num_samples The number of chunk-sized windows to sample from `data`, clamped to what fits.
+	/// \param chunk_size The chunk size (in bytes) the data will later be stored with.
+	/// \return The chosen configuration with its measurements.
+	/// \throws std::invalid_argument if `data` or `candidates` is empty.
+	template <typename T>
+	tuning_result autotune(
+		std::span<const T> data,
+		std::span<const tuning_candidate> candidates,
+		double ratio_target = 1.0,
+		size_t num_samples = 4,
+		size_t chunk_size = s_default_chunksize
+	)
+	{
+		_COMPRESSED_PROFILE_FUNCTION();
+		if (data.empty())
+		{
+			throw std::invalid_argument("Unable to autotune over empty data, expected at least one element");
+		}
+		if (candidates.empty())
+		{
+			throw std::invalid_argument("Unable to autotune without candidates, expected at least one configuration");
+		}
+
+		// Sample windows of (at most) one chunk spread evenly across the data so the measurement
+		// sees representative content rather than just the start of the buffer.
+		const size_t sample_elems = std::min(chunk_size / sizeof(T), data.size());
+		num_samples = std::clamp<size_t>(num_samples, 1, std::max<size_t>(data.size() / sample_elems, 1));
+		const size_t stride = num_samples > 1
+			? (data.size() - sample_elems) / (num_samples - 1)
+			: 0;
+
+		const size_t nthreads = detail::shared_nthreads();
+		const size_t sample_bytes = sample_elems * sizeof(T);
+		util::default_init_vector<std::byte> compression_buffer(blosc2::min_compressed_size(sample_bytes));
+		util::default_init_vector<T> decompression_buffer(sample_elems);
+
+		tuning_result best{};
+		tuning_result best_ratio{};
+		bool have_best = false;
+		bool have_best_ratio = false;
+
+		for (const auto& candidate : candidates)
+		{
+			auto compression_ctx = blosc2::create_compression_context<T>(
+				nthreads,
+				candidate.codec,
+				util::ensure_compression_level(candidate.compression_level),
+				candidate.block_size
+			);
+			auto decompression_ctx = blosc2::create_decompression_context(nthreads);
+
+			size_t total_compressed = 0;
+			std::chrono::duration<double> compress_time{ 0 };
+			std::chrono::duration<double> decompress_time{ 0 };
+
+			for (size_t sample_idx = 0; sample_idx < num_samples; ++sample_idx)
+			{
+				auto sample = data.subspan(sample_idx * stride, sample_elems);
+
+				auto compress_begin = std::chrono::steady_clock::now();
+				auto csize = blosc2::compress<T>(compression_ctx, sample, std::span<std::byte>(compression_buffer));
+				compress_time += std::chrono::steady_clock::now() - compress_begin;
+				total_compressed += csize;
+
+				auto compressed = std::span<const std::byte>(compression_buffer.data(), csize);
+				auto decompress_begin = std::chrono::steady_clock::now();
+				blosc2::decompress<T>(decompression_ctx, std::span<T>(decompression_buffer), compressed);
+				decompress_time += std::chrono::steady_clock::now() - decompress_begin;
+			}
+
+			const double total_uncompressed = static_cast<double>(num_samples * sample_bytes);
+			tuning_result result{};
+			result.codec = candidate.codec;
+			result.compression_level = candidate.compression_level;
+			result.block_size = candidate.block_size;
+			result.ratio = total_uncompressed / static_cast<double>(std::max<size_t>(total_compressed, 1));
+			result.compression_throughput = total_uncompressed / std::max(compress_time.count(), 1e-9);
+			result.decompression_throughput = total_uncompressed / std::max(decompress_time.count(), 1e-9);
+
+			if (result.ratio >= ratio_target)
+			{
+				if (!have_best || result.decompression_throughput > best.decompression_throughput)
+				{
+					best = result;
+					have_best = true;
+				}
+			}
+			if (!have_best_ratio || result.ratio > best_ratio.ratio)
+			{
+				best_ratio = result;
+				have_best_ratio = true;
+			}
+		}
+
+		if (have_best)
+		{
+			return best;
+		}
+		best_ratio.met_ratio_target = false;
+		return best_ratio;
+	}
+
+
+	/// Measure the default candidate set (see `default_tuning_candidates`) against sampled chunks
+	/// of `data` and pick the best, see the candidate-taking overload for the details.
+	template <typename T>
+	tuning_result autotune(
+		std::span<const T> data,
+		double ratio_target = 1.0,
+		size_t num_samples = 4,
+		size_t chunk_size = s_default_chunksize
+	)
+	{
+		auto candidates = default_tuning_candidates();
+		return autotune<T>(data, std::span<const tuning_candidate>(candidates), ratio_target, num_samples, chunk_size);
+	}
+
+} // NAMESPACE_COMPRESSED_IMAGE
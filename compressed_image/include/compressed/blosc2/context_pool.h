@@ -0,0 +1,181 @@
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "compressed/macros.h"
+#include "compressed/enums.h"
+#include "wrapper.h"
+
+namespace NAMESPACE_COMPRESSED_IMAGE
+{
+
+	namespace blosc2
+	{
+
+		/// Pool of reusable blosc2 compression and decompression contexts.
+		///
+		/// blosc2 mutates a context during (de)compression so a context can only ever be used by
+		/// one operation at a time, which previously forced hot paths like `channel<T>::get_chunk`
+		/// to create a brand-new context per call. The pool instead leases contexts out exclusively:
+		/// a `checkout_*` call hands back an RAII lease and the context returns to the pool when the
+		/// lease is dropped, so the creation cost is only ever paid on first use per configuration.
+		///
+		/// Contexts are keyed by their full configuration (type size, codec, level, filter, block
+		/// size and thread count) so a leased context always matches what a fresh one would have been.
+		/// All operations are internally synchronized, a library-wide instance is available via
+		/// `global_context_pool()`.
+		struct context_pool
+		{
+			/// Key uniquely identifying a context configuration. Compression contexts carry the
+			/// full parameter set, decompression contexts only differ by thread count.
+			using key_type = std::tuple<bool, size_t, uint8_t, uint8_t, uint8_t, size_t, size_t>;
+
+			/// RAII lease over a pooled context, returns the context to the pool on destruction.
+			struct lease
+			{
+				lease(context_pool* pool, key_type key, context_ptr context)
+					: m_Pool(pool), m_Key(key), m_Context(std::move(context))
+				{
+				}
+
+				lease(const lease&) = delete;
+				lease& operator=(const lease&) = delete;
+
+				lease(lease&& other) noexcept
+					: m_Pool(other.m_Pool), m_Key(other.m_Key), m_Context(std::move(other.m_Context))
+				{
+					other.m_Pool = nullptr;
+				}
+
+				lease& operator=(lease&& other) noexcept
+				{
+					if (this != &other)
+					{
+						this->release();
+						m_Pool = other.m_Pool;
+						m_Key = other.m_Key;
+						m_Context = std::move(other.m_Context);
+						other.m_Pool = nullptr;
+					}
+					return *this;
+				}
+
+				~lease()
+				{
+					this->release();
+				}
+
+				/// Access the leased context, valid for the lifetime of the lease.
+				context_ptr& ctx() noexcept
+				{
+					return m_Context;
+				}
+
+				/// Access the leased context as a raw pointer, valid for the lifetime of the lease.
+				context_raw_ptr get() noexcept
+				{
+					return m_Context.get();
+				}
+
+			private:
+				context_pool* m_Pool = nullptr;
+				key_type m_Key{};
+				context_ptr m_Context = nullptr;
+
+				void release() noexcept
+				{
+					if (m_Pool && m_Context)
+					{
+						m_Pool->return_context(m_Key, std::move(m_Context));
+					}
+					m_Pool = nullptr;
+				}
+			};
+
+			/// Check out a decompression context with the given number of threads, creating one
+			/// only if the pool holds no free context for that configuration.
+			lease checkout_decompression(size_t nthreads)
+			{
+				auto key = key_type{ false, 0, 0, 0, 0, 0, nthreads };
+				if (auto context = this->take(key))
+				{
+					return lease(this, key, std::move(context));
+				}
+				return lease(this, key, create_decompression_context(nthreads));
+			}
+
+			/// Check out a compression context with the given configuration, creating one only if
+			/// the pool holds no free context for that configuration.
+			template <typename T>
+			lease checkout_compression(size_t nthreads, enums::codec codec, uint8_t compression_level, size_t block_size, enums::filter filter = enums::filter::shuffle)
+			{
+				auto key = key_type{ true, sizeof(T), static_cast<uint8_t>(codec), compression_level, static_cast<uint8_t>(filter), block_size, nthreads };
+				if (auto context = this->take(key))
+				{
+					return lease(this, key, std::move(context));
+				}
+				return lease(this, key, create_compression_context<T>(nthreads, codec, compression_level, block_size, filter));
+			}
+
+			/// The total number of free contexts currently held by the pool.
+			size_t num_pooled() const
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				size_t count = 0;
+				for (const auto& [key, contexts] : m_Contexts)
+				{
+					count += contexts.size();
+				}
+				return count;
+			}
+
+			/// Drop all pooled contexts, releasing their memory. Leased contexts are unaffected
+			/// and are simply re-pooled when their lease is dropped.
+			void clear()
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_Contexts.clear();
+			}
+
+		private:
+
+			mutable std::mutex m_Mutex;
+			std::map<key_type, std::vector<context_ptr>> m_Contexts{};
+
+			/// Take a free context for `key` out of the pool, nullptr if none is available.
+			context_ptr take(const key_type& key)
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				auto it = m_Contexts.find(key);
+				if (it == m_Contexts.end() || it->second.empty())
+				{
+					return nullptr;
+				}
+				auto context = std::move(it->second.back());
+				it->second.pop_back();
+				return context;
+			}
+
+			/// Return a leased context to the pool.
+			void return_context(const key_type& key, context_ptr context)
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_Contexts[key].push_back(std::move(context));
+			}
+		};
+
+
+		/// The library-wide context pool shared by all channels and images.
+		inline context_pool& global_context_pool()
+		{
+			static context_pool s_pool;
+			return s_pool;
+		}
+
+	} // blosc2
+
+} // NAMESPACE_COMPRESSED_IMAGE
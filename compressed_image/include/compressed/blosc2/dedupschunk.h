@@ -0,0 +1,473 @@
+#pragma once
+
+#include <algorithm>
+#include <span>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "compressed/macros.h"
+#include "compressed/util.h"
+#include "compressed/blosc2/util.h"
+#include "compressed/detail/scoped_timer.h"
+#include "wrapper.h"
+#include "schunk_mixin.h"
+#include "schunk.h"
+
+namespace NAMESPACE_COMPRESSED_IMAGE
+{
+
+	namespace blosc2
+	{
+
+		namespace detail
+		{
+
+			/// Content-addressed store of compressed chunks, shared across the schunks of one or
+			/// more channels (typically all channels of an `image<T>`, see `image<T>::deduplicate_chunks`).
+			///
+			/// Chunks are keyed by a hash of their compressed bytes, interning a chunk whose bytes are
+			/// already present hands back the existing shared copy instead of storing a second one.
+			/// Matte and cryptomatte AOVs where most chunks are identical constant regions thus store
+			/// each distinct chunk once, no matter how many channels contain it. The store only holds
+			/// weak references, a chunk is freed as soon as the last schunk referencing it lets go.
+			///
+			/// All entry points are synchronized so a single store may be shared across threads.
+			class chunk_store
+			{
+			public:
+				using chunk_ptr = std::shared_ptr<const std::vector<std::byte>>;
+
+				/// Intern the given compressed bytes, returning the shared chunk.
+				///
+				/// If an identical chunk is already present its existing shared copy is returned and
+				/// `compressed` is discarded, otherwise `compressed` is moved into the store.
+				chunk_ptr intern(std::vector<std::byte> compressed)
+				{
+					std::lock_guard<std::mutex> lock(m_Mutex);
+					if (auto existing = this->find_locked(std::span<const std::byte>(compressed)))
+					{
+						return existing;
+					}
+					return this->insert_locked(std::make_shared<const std::vector<std::byte>>(std::move(compressed)));
+				}
+
+				/// Intern the given compressed bytes, returning the shared chunk.
+				///
+				/// The bytes are only copied if no identical chunk is present yet.
+				chunk_ptr intern(std::span<const std::byte> compressed)
+				{
+					std::lock_guard<std::mutex> lock(m_Mutex);
+					if (auto existing = this->find_locked(compressed))
+					{
+						return existing;
+					}
+					return this->insert_locked(
+						std::make_shared<const std::vector<std::byte>>(compressed.begin(), compressed.end())
+					);
+				}
+
+				/// The total compressed bytes of all distinct live chunks in the store, i.e. the
+				/// actual storage footprint of everything interned here.
+				size_t total_bytes()
+				{
+					std::lock_guard<std::mutex> lock(m_Mutex);
+					size_t total = 0;
+					for (auto& [hash, entries] : m_Chunks)
+					{
+						for (auto it = entries.begin(); it != entries.end();)
+						{
+							if (auto chunk = it->lock())
+							{
+								total += chunk->size();
+								++it;
+							}
+							else
+							{
+								it = entries.erase(it);
+							}
+						}
+					}
+					return total;
+				}
+
+			private:
+				std::mutex m_Mutex;
+				/// Hash of the compressed bytes -> live chunks with that hash. The nested vector
+				/// handles hash collisions, lookups always verify the actual bytes. Expired entries
+				/// are pruned lazily whenever their bucket is visited.
+				std::unordered_map<uint64_t, std::vector<std::weak_ptr<const std::vector<std::byte>>>> m_Chunks;
+
+				/// FNV-1a over the compressed bytes. We only need a cheap, well-distributed
+				/// fingerprint, equality of the actual bytes is verified on every lookup.
+				static uint64_t hash_bytes(std::span<const std::byte> bytes) noexcept
+				{
+					uint64_t hash = 0xcbf29ce484222325ull;
+					for (const auto byte : bytes)
+					{
+						hash ^= static_cast<uint64_t>(byte);
+						hash *= 0x100000001b3ull;
+					}
+					return hash;
+				}
+
+				/// Look up a live chunk with the given bytes, pruning expired entries along the way.
+				/// Must be called with m_Mutex held.
+				chunk_ptr find_locked(std::span<const std::byte> compressed)
+				{
+					auto bucket = m_Chunks.find(hash_bytes(compressed));
+					if (bucket == m_Chunks.end())
+					{
+						return nullptr;
+					}
+
+					auto& entries = bucket->second;
+					for (auto it = entries.begin(); it != entries.end();)
+					{
+						auto existing = it->lock();
+						if (!existing)
+						{
+							it = entries.erase(it);
+							continue;
+						}
+						if (existing->size() == compressed.size() &&
+							std::equal(existing->begin(), existing->end(), compressed.begin()))
+						{
+							return existing;
+						}
+						++it;
+					}
+					return nullptr;
+				}
+
+				/// Record the chunk under the hash of its bytes. Must be called with m_Mutex held.
+				chunk_ptr insert_locked(chunk_ptr chunk)
+				{
+					m_Chunks[hash_bytes(std::span<const std::byte>(*chunk))].push_back(chunk);
+					return chunk;
+				}
+			};
+
+		} // detail
+
+
+		/// A super-chunk whose chunks live in a content-addressed `detail::chunk_store` shared
+		/// across channels, storing each distinct compressed chunk only once.
+		///
+		/// The chunks themselves are immutable and refcounted, writes go through copy-on-write:
+		/// `set_chunk` never modifies the shared bytes but interns the new content as its own
+		/// (potentially again shared) chunk, so channels sharing a chunk stay unaffected by each
+		/// other's modifications. Reads are byte-for-byte identical to a regular `schunk<T>`.
+		///
+		/// This is the opt-in storage behind `image<T>::deduplicate_chunks()`, aimed at matte and
+		/// cryptomatte heavy images where a large fraction of chunks across channels compress to
+		/// identical bytes. Note that `csize()` counts each distinct chunk of this schunk once but
+		/// cannot see sharing with other schunks of the same store.
+		template <typename T>
+		struct dedup_schunk final : public detail::schunk_mixin<T, detail::chunk_store::chunk_ptr>
+		{
+			using detail::schunk_mixin<T, detail::chunk_store::chunk_ptr>::chunk_bytes;
+
+			dedup_schunk() = default;
+
+			dedup_schunk(dedup_schunk&& other) noexcept
+			{
+				this->m_Chunks = std::move(other.m_Chunks);
+				this->m_ChunkSize = other.m_ChunkSize;
+				this->m_BlockSize = other.m_BlockSize;
+				this->m_BufferPool = std::move(other.m_BufferPool);
+				this->m_ChunkStats = std::move(other.m_ChunkStats);
+				this->m_TrackChunkStats = other.m_TrackChunkStats;
+				this->m_Store = std::move(other.m_Store);
+			}
+			dedup_schunk& operator=(dedup_schunk&& other) noexcept
+			{
+				if (this != &other)
+				{
+					this->m_Chunks = std::move(other.m_Chunks);
+					this->m_ChunkSize = other.m_ChunkSize;
+					this->m_BlockSize = other.m_BlockSize;
+					this->m_BufferPool = std::move(other.m_BufferPool);
+					this->m_ChunkStats = std::move(other.m_ChunkStats);
+					this->m_TrackChunkStats = other.m_TrackChunkStats;
+					this->m_Store = std::move(other.m_Store);
+				}
+				return *this;
+			}
+			dedup_schunk(const dedup_schunk& other) = default;
+			dedup_schunk& operator=(const dedup_schunk& other) = default;
+
+			/// Initialize an empty dedup-schunk interning its chunks into `store`. The data can
+			/// then be filled with append_chunk for example.
+			dedup_schunk(size_t block_size, size_t chunk_size, std::shared_ptr<detail::chunk_store> store)
+				: m_Store(std::move(store))
+			{
+				util::validate_chunk_size<T>(chunk_size, "dedup_schunk");
+				this->m_ChunkSize = chunk_size;
+				this->m_BlockSize = block_size;
+			}
+
+			/// Initialize a dedup-schunk from an existing heap-backed schunk by interning its
+			/// compressed chunks into `store`, no decode/encode cycle is involved. Chunks whose
+			/// bytes are already present in the store (from this or any other schunk) are shared.
+			dedup_schunk(const schunk<T>& source, std::shared_ptr<detail::chunk_store> store)
+				: m_Store(std::move(store))
+			{
+				this->m_ChunkSize = source.max_chunk_size();
+				this->m_BlockSize = source.max_block_size();
+				for (auto idx : std::views::iota(size_t{ 0 }, source.num_chunks()))
+				{
+					const auto& compressed = source.compressed_chunk(idx);
+					this->m_Chunks.push_back(this->intern(std::span<const std::byte>(compressed)));
+				}
+			}
+
+			schunk_ptr to_schunk() override
+			{
+				_COMPRESSED_PROFILE_FUNCTION();
+				blosc2::schunk_ptr schunk = create_default_schunk();
+				for (auto& chunk : this->m_Chunks)
+				{
+					blosc2_schunk_append_chunk(
+						schunk.get(),
+						reinterpret_cast<uint8_t*>(const_cast<std::byte*>(chunk->data())),
+						true // copy, blosc2 will internally at some point do this anyways.
+					);
+				}
+
+				return schunk;
+			}
+
+			std::vector<T> to_uncompressed(blosc2::context_ptr& decompression_ctx) const override
+			{
+				_COMPRESSED_PROFILE_FUNCTION();
+				auto num_elems = this->size();
+				std::vector<T> data(num_elems);
+
+				size_t data_offset = 0;
+				for (auto idx : std::views::iota(size_t{ 0 }, this->m_Chunks.size()))
+				{
+					size_t chunk_elems = this->chunk_elements(idx);
+
+					auto subspan = std::span<T>(data.data() + data_offset, chunk_elems);
+					this->chunk(decompression_ctx, subspan, idx);
+
+					data_offset += chunk_elems;
+				}
+
+				return data;
+			}
+
+			std::vector<T> chunk(blosc2::context_ptr& decompression_ctx, size_t index) const override
+			{
+				return this->chunk(decompression_ctx.get(), index);
+			}
+
+			std::vector<T> chunk(blosc2::context_raw_ptr decompression_ctx, size_t index) const override
+			{
+				this->validate_chunk_index(index);
+
+				std::vector<T> decompressed(this->chunk_elements(index));
+				auto chunk_span = std::span<const std::byte>(this->m_Chunks[index]->begin(), this->m_Chunks[index]->end());
+				blosc2::decompress(decompression_ctx, std::span<T>(decompressed), chunk_span);
+
+				return std::move(decompressed);
+			}
+
+			void chunk(blosc2::context_ptr& decompression_ctx, std::span<T> buffer, size_t index) const override
+			{
+				this->chunk(decompression_ctx.get(), buffer, index);
+			}
+
+			void chunk(blosc2::context_raw_ptr decompression_ctx, std::span<T> buffer, size_t index, size_t element_offset, size_t num_elements) const override
+			{
+				this->validate_chunk_range(index, element_offset, num_elements);
+
+				auto chunk_span = std::span<const std::byte>(this->m_Chunks[index]->begin(), this->m_Chunks[index]->end());
+				blosc2::decompress_partial(decompression_ctx, buffer, chunk_span, element_offset, num_elements);
+			}
+
+			void chunk(blosc2::context_raw_ptr decompression_ctx, std::span<T> buffer, size_t index) const override
+			{
+				this->validate_chunk_index(index);
+
+				if (buffer.size() < this->chunk_elements(index))
+				{
+					throw std::invalid_argument(
+						std::format(
+							"Unable to decompress chunk at idx {} into buffer as the buffer needs to at least have the size {:L}."
+							" Instead got {:L}", index, this->chunk_elements(index), buffer.size()
+						)
+					);
+				}
+
+				auto chunk_span = std::span<const std::byte>(this->m_Chunks[index]->begin(), this->m_Chunks[index]->end());
+				blosc2::decompress(decompression_ctx, std::span<T>(buffer), chunk_span);
+			}
+
+			void set_chunk(std::vector<std::byte> compressed, size_t index) override
+			{
+				this->validate_chunk_index(index);
+				// Copy-on-write: the previously stored chunk is never touched (other schunks may
+				// share it), the new content is interned as its own chunk and simply replaces the
+				// reference. Identical rewrites thus re-share instead of storing a duplicate.
+				this->m_Chunks[index] = this->intern(std::move(compressed));
+				this->invalidate_chunk_stats(index);
+				this->validate_chunk_sizes();
+			}
+
+			void set_chunk(std::span<const std::byte> compressed, size_t index) override
+			{
+				this->validate_chunk_index(index);
+				this->m_Chunks[index] = this->intern(compressed);
+				this->invalidate_chunk_stats(index);
+				this->validate_chunk_sizes();
+			}
+
+			void set_chunk(blosc2::context_ptr& compression_ctx, std::span<T> uncompressed, size_t index) override
+			{
+				this->validate_chunk_index(index);
+
+				util::default_init_vector<std::byte> compression_buffer(blosc2::min_compressed_size(this->chunk_bytes()));
+				std::span<std::byte> compression_span(compression_buffer);
+
+				auto csize = blosc2::compress<T>(compression_ctx, uncompressed, compression_span);
+				this->m_Chunks[index] = this->intern(std::span<const std::byte>(compression_span.data(), csize));
+				this->record_chunk_stats(index, std::span<const T>(uncompressed.begin(), uncompressed.end()));
+				this->validate_chunk_sizes();
+			}
+
+			/// Append the already compressed chunk, interning it into the store.
+			///
+			/// \param compressed the compressed chunk
+			void append_chunk(std::vector<std::byte> compressed) override
+			{
+				this->m_Chunks.push_back(this->intern(std::move(compressed)));
+				this->validate_chunk_sizes();
+			};
+
+			/// Append to the schunk with the uncompressed data (compressing it).
+			///
+			/// \param compression_ctx the compression context to use for compression.
+			/// \param uncompressed the uncompressed chunk
+			void append_chunk(blosc2::context_ptr& compression_ctx, std::span<T> uncompressed) override
+			{
+				util::default_init_vector<std::byte> compression_buffer(blosc2::min_compressed_size(this->chunk_bytes()));
+				std::span<std::byte> compression_span(compression_buffer);
+				this->append_chunk(compression_ctx, uncompressed, compression_span);
+				this->validate_chunk_sizes();
+			};
+
+			void append_chunk(blosc2::context_ptr& compression_ctx, std::span<T> uncompressed, std::span<std::byte> compression_buff) override
+			{
+				if (compression_buff.size() < blosc2::min_compressed_size(this->chunk_bytes()))
+				{
+					throw std::runtime_error(
+						std::format(
+							"Error while appending chunk to super-chunk. Expected compression buffer to be at least"
+							" {:L} bytes but instead we got {:L} bytes", blosc2::min_compressed_size(this->chunk_bytes()),
+							compression_buff.size()
+						)
+					);
+				}
+				auto csize = blosc2::compress<T>(compression_ctx, uncompressed, compression_buff);
+				assert(csize <= compression_buff.size());
+				this->m_Chunks.push_back(this->intern(std::span<const std::byte>(compression_buff.data(), csize)));
+				this->record_chunk_stats(this->m_Chunks.size() - 1, std::span<const T>(uncompressed.begin(), uncompressed.end()));
+				this->validate_chunk_sizes();
+			}
+
+			size_t chunk_bytes(size_t index) const override
+			{
+				return blosc2::chunk_num_elements<T>(*this->m_Chunks[index]) * sizeof(T);
+			}
+
+			/// Retrieve a view over the raw compressed bytes of the chunk at `index`, e.g. for
+			/// serialization or cloning without a decompress-recompress roundtrip.
+			///
+			/// \throws std::out_of_range if the index is not valid
+			const std::vector<std::byte>& compressed_chunk(size_t index) const
+			{
+				this->validate_chunk_index(index);
+				return *this->m_Chunks[index];
+			}
+
+			/// The total compressed size of the schunk, counting each distinct (shared) chunk once.
+			///
+			/// Sharing with other schunks interned into the same store is not visible here, so
+			/// summing `csize()` over all channels of a deduplicated image over-counts chunks
+			/// shared across channels.
+			virtual size_t csize() const noexcept override
+			{
+				std::unordered_set<const std::vector<std::byte>*> seen;
+				size_t _size = 0;
+				for (const auto& chunk : this->m_Chunks)
+				{
+					if (seen.insert(chunk.get()).second)
+					{
+						_size += chunk->size();
+					}
+				}
+				return _size;
+			};
+
+			size_t size() const noexcept override
+			{
+				size_t _size = 0;
+				for (const auto& chunk : this->m_Chunks)
+				{
+					_size += blosc2::chunk_num_elements<T>(*chunk);
+				}
+				return _size;
+			};
+
+			/// The number of distinct chunks held, i.e. num_chunks() minus the duplicates that
+			/// resolved to a shared chunk within this schunk.
+			size_t num_unique_chunks() const noexcept
+			{
+				std::unordered_set<const std::vector<std::byte>*> seen;
+				for (const auto& chunk : this->m_Chunks)
+				{
+					seen.insert(chunk.get());
+				}
+				return seen.size();
+			}
+
+			/// The content-addressed store the chunks are interned into, shared with the other
+			/// schunks participating in the deduplication.
+			std::shared_ptr<detail::chunk_store> store() const noexcept
+			{
+				return m_Store;
+			}
+
+		private:
+			/// The shared content-addressed store, may be shared across the schunks of many
+			/// channels. Chunks of a store-less dedup_schunk are simply never shared.
+			std::shared_ptr<detail::chunk_store> m_Store = nullptr;
+
+			detail::chunk_store::chunk_ptr intern(std::vector<std::byte> compressed)
+			{
+				if (m_Store)
+				{
+					return m_Store->intern(std::move(compressed));
+				}
+				return std::make_shared<const std::vector<std::byte>>(std::move(compressed));
+			}
+
+			detail::chunk_store::chunk_ptr intern(std::span<const std::byte> compressed)
+			{
+				if (m_Store)
+				{
+					return m_Store->intern(compressed);
+				}
+				return std::make_shared<const std::vector<std::byte>>(compressed.begin(), compressed.end());
+			}
+		};
+
+	} // blosc2
+
+} // NAMESPACE_COMPRESSED_IMAGE
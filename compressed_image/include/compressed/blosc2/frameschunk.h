@@ -0,0 +1,380 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <cstddef>
+#include <cstring>
+#include <cassert>
+
+#include "compressed/macros.h"
+#include "compressed/util.h"
+#include "compressed/blosc2/util.h"
+#include "compressed/detail/scoped_timer.h"
+#include "wrapper.h"
+#include "schunk_mixin.h"
+#include "schunk.h"
+
+namespace NAMESPACE_COMPRESSED_IMAGE
+{
+
+	namespace blosc2
+	{
+
+		namespace detail
+		{
+			/// Location of one compressed chunk inside the contiguous payload of a `frame_schunk<T>`.
+			struct chunk_extent
+			{
+				size_t offset = 0;
+				size_t size = 0;
+			};
+		} // detail
+
+
+		/// A super-chunk whose compressed chunks live in one contiguous allocation.
+		///
+		/// Where `schunk<T>` keeps one heap allocation per chunk -- pointer-chasing on every
+		/// access and no way to hand the whole channel off as a single buffer -- this stores
+		/// the compressed bytes of all chunks back-to-back in a single payload with an extent
+		/// index on the side, mirroring the layout of blosc2's contiguous frame format. That
+		/// buys locality when iterating the chunks, a single `write()` to persist the channel
+		/// and a zero-copy handoff of the whole compressed stream via `payload()`.
+		///
+		/// The trade-off is on writes: overwriting a chunk with differently-sized compressed
+		/// bytes shifts the payload tail and refits the extents behind it, O(payload) instead
+		/// of O(chunk). Frame-backed storage is meant for read-mostly channels, convert with
+		/// `channel<T>::make_contiguous()` once the heavy mutation is done.
+		template <typename T>
+		struct frame_schunk final : public detail::schunk_mixin<T, detail::chunk_extent>
+		{
+			using detail::schunk_mixin<T, detail::chunk_extent>::chunk_bytes;
+
+			frame_schunk() = default;
+
+			frame_schunk(frame_schunk&& other) noexcept
+			{
+				this->m_Chunks = std::move(other.m_Chunks);
+				this->m_Payload = std::move(other.m_Payload);
+				this->m_ChunkSize = other.m_ChunkSize;
+				this->m_BlockSize = other.m_BlockSize;
+				this->m_BufferPool = std::move(other.m_BufferPool);
+				this->m_ChunkStats = std::move(other.m_ChunkStats);
+				this->m_TrackChunkStats = other.m_TrackChunkStats;
+			}
+			frame_schunk& operator=(frame_schunk&& other) noexcept
+			{
+				if (this != &other)
+				{
+					this->m_Chunks = std::move(other.m_Chunks);
+					this->m_Payload = std::move(other.m_Payload);
+					this->m_ChunkSize = other.m_ChunkSize;
+					this->m_BlockSize = other.m_BlockSize;
+					this->m_BufferPool = std::move(other.m_BufferPool);
+					this->m_ChunkStats = std::move(other.m_ChunkStats);
+					this->m_TrackChunkStats = other.m_TrackChunkStats;
+				}
+				return *this;
+			}
+			frame_schunk(const frame_schunk& other) = default;
+			frame_schunk& operator=(const frame_schunk& other) = default;
+
+			/// Initialize an empty frame-backed schunk with just a chunk size. The data can then
+			/// later be filled with append_chunk for example.
+			frame_schunk(size_t block_size, size_t chunk_size)
+			{
+				util::validate_chunk_size<T>(chunk_size, "frame_schunk");
+				this->m_ChunkSize = chunk_size;
+				this->m_BlockSize = block_size;
+			}
+
+			/// Initialize a frame-backed schunk by packing the compressed chunks of an existing
+			/// heap-backed schunk into one contiguous payload, byte-for-byte with no codec work.
+			explicit frame_schunk(const schunk<T>& source)
+			{
+				this->m_ChunkSize = source.max_chunk_size();
+				this->m_BlockSize = source.max_block_size();
+
+				size_t total = 0;
+				for (auto chunk_idx : std::views::iota(size_t{ 0 }, source.num_chunks()))
+				{
+					total += source.compressed_chunk(chunk_idx).size();
+				}
+				this->m_Payload.reserve(total);
+
+				for (auto chunk_idx : std::views::iota(size_t{ 0 }, source.num_chunks()))
+				{
+					const auto& compressed = source.compressed_chunk(chunk_idx);
+					this->m_Chunks.push_back(detail::chunk_extent{ this->m_Payload.size(), compressed.size() });
+					this->m_Payload.insert(this->m_Payload.end(), compressed.begin(), compressed.end());
+				}
+			}
+
+			/// Initialize a frame-backed super-chunk from the given data, compressing it.
+			///
+			/// \param data The data to store
+			/// \param block_size The requested block size. It is up to the caller to ensure
+			///                   this is appropriately sized
+			/// \param chunk_size The requested chunk size. It is up to the caller to ensure
+			///                   this is appropriately sized (i.e. by using util::align_chunk_to_scanlines)
+			/// \param compression_ctx The compression context to be used for compressing the data.
+			frame_schunk(std::span<const T> data, size_t block_size, size_t chunk_size, blosc2::context_ptr& compression_ctx)
+			{
+				util::validate_chunk_size<T>(chunk_size, "frame_schunk");
+				this->m_BlockSize = block_size;
+				this->m_ChunkSize = chunk_size;
+
+				util::default_init_vector<std::byte> compression_buffer(blosc2::min_compressed_size(chunk_size));
+				auto compression_span = std::span<std::byte>(compression_buffer);
+
+				size_t num_bytes = data.size() * sizeof(T);
+				size_t num_full_chunks = num_bytes / this->chunk_bytes();
+				size_t remainder_bytes = num_bytes - (this->chunk_bytes() * num_full_chunks);
+
+				size_t data_offset = 0;
+				for ([[maybe_unused]] auto idx : std::views::iota(size_t{ 0 }, num_full_chunks))
+				{
+					auto subspan = std::span<const T>(data.data() + data_offset, this->chunk_elements());
+					auto csize = blosc2::compress<T>(compression_ctx, subspan, compression_span);
+					this->append_bytes(std::span<const std::byte>(compression_span.data(), csize));
+					data_offset += this->chunk_elements();
+				}
+				if (remainder_bytes > 0)
+				{
+					auto subspan = std::span<const T>(data.data() + data_offset, data.size() - data_offset);
+					auto csize = blosc2::compress<T>(compression_ctx, subspan, compression_span);
+					this->append_bytes(std::span<const std::byte>(compression_span.data(), csize));
+				}
+			}
+
+			schunk_ptr to_schunk() override
+			{
+				_COMPRESSED_PROFILE_FUNCTION();
+				blosc2::schunk_ptr schunk = create_default_schunk();
+				for (const auto& extent : this->m_Chunks)
+				{
+					blosc2_schunk_append_chunk(
+						schunk.get(),
+						reinterpret_cast<uint8_t*>(this->m_Payload.data() + extent.offset),
+						true // copy, blosc2 will internally at some point do this anyways.
+					);
+				}
+
+				return schunk;
+			}
+
+			std::vector<T> to_uncompressed(blosc2::context_ptr& decompression_ctx) const override
+			{
+				_COMPRESSED_PROFILE_FUNCTION();
+				auto num_elems = this->size();
+				std::vector<T> data(num_elems);
+
+				size_t data_offset = 0;
+				for (auto idx : std::views::iota(size_t{ 0 }, this->m_Chunks.size()))
+				{
+					size_t chunk_elems = this->chunk_elements(idx);
+
+					auto subspan = std::span<T>(data.data() + data_offset, chunk_elems);
+					this->chunk(decompression_ctx, subspan, idx);
+
+					data_offset += chunk_elems;
+				}
+
+				return data;
+			}
+
+			std::vector<T> chunk(blosc2::context_ptr& decompression_ctx, size_t index) const override
+			{
+				return this->chunk(decompression_ctx.get(), index);
+			}
+
+			std::vector<T> chunk(blosc2::context_raw_ptr decompression_ctx, size_t index) const override
+			{
+				this->validate_chunk_index(index);
+
+				std::vector<T> decompressed(this->chunk_elements(index));
+				blosc2::decompress(decompression_ctx, std::span<T>(decompressed), this->compressed_chunk(index));
+
+				return std::move(decompressed);
+			}
+
+			void chunk(blosc2::context_ptr& decompression_ctx, std::span<T> buffer, size_t index) const override
+			{
+				this->chunk(decompression_ctx.get(), buffer, index);
+			}
+
+			void chunk(blosc2::context_raw_ptr decompression_ctx, std::span<T> buffer, size_t index, size_t element_offset, size_t num_elements) const override
+			{
+				this->validate_chunk_range(index, element_offset, num_elements);
+				blosc2::decompress_partial(decompression_ctx, buffer, this->compressed_chunk(index), element_offset, num_elements);
+			}
+
+			void chunk(blosc2::context_raw_ptr decompression_ctx, std::span<T> buffer, size_t index) const override
+			{
+				this->validate_chunk_index(index);
+
+				if (buffer.size() < this->chunk_elements(index))
+				{
+					throw std::invalid_argument(
+						std::format(
+							"Unable to decompress chunk at idx {} into buffer as the buffer needs to at least have the size {:L}."
+							" Instead got {:L}", index, this->chunk_elements(index), buffer.size()
+						)
+					);
+				}
+
+				blosc2::decompress(decompression_ctx, std::span<T>(buffer), this->compressed_chunk(index));
+			}
+
+			void set_chunk(std::vector<std::byte> compressed, size_t index) override
+			{
+				this->validate_chunk_index(index);
+				this->replace_bytes(index, std::span<const std::byte>(compressed.data(), compressed.size()));
+				this->invalidate_chunk_stats(index);
+				this->validate_chunk_sizes();
+			}
+
+			void set_chunk(std::span<const std::byte> compressed, size_t index) override
+			{
+				this->validate_chunk_index(index);
+				this->replace_bytes(index, compressed);
+				this->invalidate_chunk_stats(index);
+				this->validate_chunk_sizes();
+			}
+
+			void set_chunk(blosc2::context_ptr& compression_ctx, std::span<T> uncompressed, size_t index) override
+			{
+				this->validate_chunk_index(index);
+
+				util::default_init_vector<std::byte> compression_buffer(blosc2::min_compressed_size(this->chunk_bytes()));
+				std::span<std::byte> compression_span(compression_buffer);
+				auto csize = blosc2::compress<T>(compression_ctx, uncompressed, compression_span);
+
+				this->replace_bytes(index, std::span<const std::byte>(compression_span.data(), csize));
+				this->record_chunk_stats(index, std::span<const T>(uncompressed.begin(), uncompressed.end()));
+				this->validate_chunk_sizes();
+			}
+
+			void append_chunk(std::vector<std::byte> compressed) override
+			{
+				this->append_bytes(std::span<const std::byte>(compressed.data(), compressed.size()));
+				this->validate_chunk_sizes();
+			};
+
+			void append_chunk(blosc2::context_ptr& compression_ctx, std::span<T> uncompressed) override
+			{
+				util::default_init_vector<std::byte> compression_buffer(blosc2::min_compressed_size(this->chunk_bytes()));
+				std::span<std::byte> compression_span(compression_buffer);
+				this->append_chunk(compression_ctx, uncompressed, compression_span);
+			};
+
+			void append_chunk(blosc2::context_ptr& compression_ctx, std::span<T> uncompressed, std::span<std::byte> compression_buff) override
+			{
+				if (compression_buff.size() < blosc2::min_compressed_size(this->chunk_bytes()))
+				{
+					throw std::runtime_error(
+						std::format(
+							"Error while appending chunk to super-chunk. Expected compression buffer to be at least"
+							" {:L} bytes but instead we got {:L} bytes", blosc2::min_compressed_size(this->chunk_bytes()),
+							compression_buff.size()
+						)
+					);
+				}
+				auto csize = blosc2::compress<T>(compression_ctx, uncompressed, compression_buff);
+				assert(csize <= compression_buff.size());
+				this->append_bytes(std::span<const std::byte>(compression_buff.data(), csize));
+				this->record_chunk_stats(this->m_Chunks.size() - 1, std::span<const T>(uncompressed.begin(), uncompressed.end()));
+				this->validate_chunk_sizes();
+			}
+
+			size_t chunk_bytes(size_t index) const override
+			{
+				return blosc2::chunk_num_elements<T>(this->compressed_chunk(index)) * sizeof(T);
+			}
+
+			/// Retrieve a view over the raw compressed bytes of the chunk at `index`, e.g. for
+			/// serialization or cloning without a decompress-recompress roundtrip.
+			///
+			/// \throws std::out_of_range if the index is not valid
+			std::span<const std::byte> compressed_chunk(size_t index) const
+			{
+				this->validate_chunk_index(index);
+				const auto& extent = this->m_Chunks[index];
+				return std::span<const std::byte>(this->m_Payload.data() + extent.offset, extent.size);
+			}
+
+			/// Retrieve a view over the whole contiguous compressed payload, all chunks
+			/// back-to-back in index order. This is the zero-copy handoff point: the span can go
+			/// straight to a `write()` or the network stack, `num_chunks` and `chunk_bytes` give
+			/// the index needed to reconstruct.
+			std::span<const std::byte> payload() const noexcept
+			{
+				return std::span<const std::byte>(this->m_Payload.data(), this->m_Payload.size());
+			}
+
+			/// The total compressed size of the schunk
+			virtual size_t csize() const noexcept override
+			{
+				return this->m_Payload.size();
+			};
+
+			size_t size() const noexcept override
+			{
+				size_t _size = 0;
+				for (auto idx : std::views::iota(size_t{ 0 }, this->m_Chunks.size()))
+				{
+					_size += blosc2::chunk_num_elements<T>(this->compressed_chunk(idx));
+				}
+				return _size;
+			};
+
+		private:
+
+			/// The compressed bytes of all chunks, back-to-back in index order. The extents in
+			/// m_Chunks point into this.
+			std::vector<std::byte> m_Payload{};
+
+			/// Append compressed bytes as a new chunk at the end of the payload.
+			void append_bytes(std::span<const std::byte> compressed)
+			{
+				this->m_Chunks.push_back(detail::chunk_extent{ this->m_Payload.size(), compressed.size() });
+				this->m_Payload.insert(this->m_Payload.end(), compressed.begin(), compressed.end());
+			}
+
+			/// Replace the compressed bytes of the chunk at `index`, shifting the payload tail and
+			/// refitting the extents behind it when the size changes. `index` must be valid.
+			void replace_bytes(size_t index, std::span<const std::byte> compressed)
+			{
+				auto& extent = this->m_Chunks[index];
+				const size_t old_size = extent.size;
+				const size_t new_size = compressed.size();
+
+				if (new_size > old_size)
+				{
+					this->m_Payload.insert(
+						this->m_Payload.begin() + extent.offset + old_size,
+						new_size - old_size,
+						std::byte{}
+					);
+				}
+				else if (new_size < old_size)
+				{
+					this->m_Payload.erase(
+						this->m_Payload.begin() + extent.offset + new_size,
+						this->m_Payload.begin() + extent.offset + old_size
+					);
+				}
+				if (new_size != old_size)
+				{
+					for (auto idx : std::views::iota(index + 1, this->m_Chunks.size()))
+					{
+						this->m_Chunks[idx].offset = this->m_Chunks[idx].offset - old_size + new_size;
+					}
+					extent.size = new_size;
+				}
+				std::memcpy(this->m_Payload.data() + extent.offset, compressed.data(), new_size);
+			}
+		};
+
+	} // blosc2
+
+} // NAMESPACE_COMPRESSED_IMAGE
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstdint>
+
+#include "compressed/macros.h"
+
+#include "blosc2.h"
+
+namespace NAMESPACE_COMPRESSED_IMAGE
+{
+
+	namespace blosc2
+	{
+
+		namespace detail
+		{
+
+			/// The user-registered blosc2 filter id of the half-float shuffle, picked from the middle of
+			/// the BLOSC2_USER_REGISTERED_FILTERS range to stay clear of other registered plugins.
+			constexpr static inline uint8_t s_half_shuffle_filter_id = 200;
+
+			/// Forward pass of the half-float shuffle filter.
+			///
+			/// The generic byte shuffle only separates high and low bytes. For 16-bit floats the high
+			/// byte carries the sign, the 5 exponent bits and the top 2 mantissa bits, and neighbouring
+			/// pixels tend to share their exponent. So on top of splitting the values into a high-byte
+			/// and a low-byte plane, the high-byte plane is delta-encoded which turns the slowly varying
+			/// sign/exponent bytes into long runs of (near-)zero values the codec can fold away.
+			///
+			/// The transform is pure byte arithmetic (wrapping uint8 subtraction), making it exactly
+			/// invertible for any bit pattern including NaN and infinities. A trailing odd byte is
+			/// copied verbatim so uneven block splits remain lossless.
+			inline int half_shuffle_forward(
+				const uint8_t* src,
+				uint8_t* dest,
+				int32_t size,
+				[[maybe_unused]] uint8_t meta,
+				[[maybe_unused]] blosc2_cparams* cparams,
+				[[maybe_unused]] uint8_t id
+			)
+			{
+				const int32_t num_pairs = size / 2;
+				uint8_t previous = 0;
+				for (int32_t idx = 0; idx < num_pairs; ++idx)
+				{
+					// Little-endian: the high (sign/exponent) byte is the second byte of each value.
+					const uint8_t high = src[2 * idx + 1];
+					dest[idx] = static_cast<uint8_t>(high - previous);
+					previous = high;
+					dest[num_pairs + idx] = src[2 * idx];
+				}
+				if (size % 2 != 0)
+				{
+					dest[size - 1] = src[size - 1];
+				}
+				return BLOSC2_ERROR_SUCCESS;
+			}
+
+			/// Backward pass of the half-float shuffle filter, undoing `half_shuffle_forward` by
+			/// prefix-summing the high-byte plane and re-interleaving it with the low-byte plane.
+			inline int half_shuffle_backward(
+				const uint8_t* src,
+				uint8_t* dest,
+				int32_t size,
+				[[maybe_unused]] uint8_t meta,
+				[[maybe_unused]] blosc2_dparams* dparams,
+				[[maybe_unused]] uint8_t id
+			)
+			{
+				const int32_t num_pairs = size / 2;
+				uint8_t previous = 0;
+				for (int32_t idx = 0; idx < num_pairs; ++idx)
+				{
+					previous = static_cast<uint8_t>(previous + src[idx]);
+					dest[2 * idx + 1] = previous;
+					dest[2 * idx] = src[num_pairs + idx];
+				}
+				if (size % 2 != 0)
+				{
+					dest[size - 1] = src[size - 1];
+				}
+				return BLOSC2_ERROR_SUCCESS;
+			}
+
+			/// Register the half-float shuffle filter with blosc2, a no-op on every call but the first.
+			/// Registration is global so once this ran any chunk carrying the filter id decodes
+			/// correctly regardless of which channel it belongs to.
+			inline void register_half_shuffle_filter()
+			{
+				static const int s_registered = []()
+					{
+						blosc2_filter filter{};
+						filter.id = s_half_shuffle_filter_id;
+						filter.name = const_cast<char*>("half_shuffle");
+						filter.version = 1;
+						filter.forward = &half_shuffle_forward;
+						filter.backward = &half_shuffle_backward;
+						return blosc2_register_filter(&filter);
+					}();
+				(void)s_registered;
+			}
+
+		} // namespace detail
+
+	} // namespace blosc2
+
+} // NAMESPACE_COMPRESSED_IMAGE
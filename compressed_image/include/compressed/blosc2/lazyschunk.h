@@ -55,6 +55,9 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 				this->m_Chunks = std::move(other.m_Chunks);
 				this->m_ChunkSize = other.m_ChunkSize;
 				this->m_BlockSize = other.m_BlockSize;
+				this->m_BufferPool = std::move(other.m_BufferPool);
+				this->m_ChunkStats = std::move(other.m_ChunkStats);
+				this->m_TrackChunkStats = other.m_TrackChunkStats;
 			}
 			lazy_schunk& operator=(lazy_schunk&& other) noexcept
 			{
@@ -63,6 +66,9 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 					this->m_Chunks = std::move(other.m_Chunks);
 					this->m_ChunkSize = other.m_ChunkSize;
 					this->m_BlockSize = other.m_BlockSize;
+					this->m_BufferPool = std::move(other.m_BufferPool);
+					this->m_ChunkStats = std::move(other.m_ChunkStats);
+					this->m_TrackChunkStats = other.m_TrackChunkStats;
 				}
 				return *this;
 			}
@@ -251,10 +257,51 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 				}
 			}
 
+			void chunk(blosc2::context_raw_ptr decompression_ctx, std::span<T> buffer, size_t index, size_t element_offset, size_t num_elements) const override
+			{
+				this->validate_chunk_range(index, element_offset, num_elements);
+
+				// The compressed branch validates this inside decompress_partial, the lazy fill has
+				// to enforce the same contract instead of writing past the end of the span.
+				if (buffer.size() < num_elements)
+				{
+					throw std::invalid_argument(
+						std::format(
+							"Unable to partially decompress blosc2 chunk into buffer as the buffer needs to at least hold {:L}"
+							" elements but instead holds {:L}", num_elements, buffer.size()
+						)
+					);
+				}
+
+				// Either partially decompress from the compressed data or fill with the lazy chunks value,
+				// a lazy chunk needs no decoding at all so the range is served straight from the fill value.
+				if (std::holds_alternative<std::vector<std::byte>>(this->m_Chunks.at(index).value))
+				{
+					auto& compressed = std::get<std::vector<std::byte>>(this->m_Chunks.at(index).value);
+					blosc2::decompress_partial(
+						decompression_ctx,
+						buffer,
+						std::span<const std::byte>(compressed),
+						element_offset,
+						num_elements
+					);
+				}
+				else
+				{
+					std::fill(
+						std::execution::par_unseq,
+						buffer.begin(),
+						buffer.begin() + num_elements,
+						std::get<T>(this->m_Chunks[index].value)
+					);
+				}
+			}
+
 			void set_chunk(std::vector<std::byte> compressed, size_t index) override
 			{
 				this->validate_chunk_index(index);
 				this->m_Chunks[index].value = std::move(compressed);
+				this->invalidate_chunk_stats(index);
 				this->validate_chunk_sizes();
 			}
 
@@ -262,6 +309,7 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			{
 				this->validate_chunk_index(index);
 				this->m_Chunks[index].value = std::vector<std::byte>(compressed.begin(), compressed.end());
+				this->invalidate_chunk_stats(index);
 				this->validate_chunk_sizes();
 			}
 
@@ -277,6 +325,7 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 				// copy over a new vector containing all the elements from the compression span.
 				this->m_Chunks[index].value = std::vector<std::byte>(compression_span.begin(), compression_span.begin() + csize);
 				this->m_Chunks[index].num_elements = uncompressed.size();
+				this->record_chunk_stats(index, std::span<const T>(uncompressed.begin(), uncompressed.end()));
 				this->validate_chunk_sizes();
 			}
 
@@ -304,9 +353,70 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 					.num_elements = uncompressed.size()
 				};
 				this->m_Chunks.push_back(std::move(chunk));
+				this->record_chunk_stats(this->m_Chunks.size() - 1, std::span<const T>(uncompressed.begin(), uncompressed.end()));
 				this->validate_chunk_sizes();
 			}
 
+			/// Whether the chunk at `index` is still in its lazy (single-value) state, i.e. was never
+			/// materialized into a compressed buffer.
+			///
+			/// \throws std::out_of_range if the index is not valid
+			bool is_lazy(size_t index) const
+			{
+				this->validate_chunk_index(index);
+				return this->m_Chunks[index].is_lazy();
+			}
+
+			/// Retrieve a view over the raw compressed bytes of the materialized chunk at `index`,
+			/// e.g. for serialization or cloning without a decompress-recompress roundtrip.
+			///
+			/// \throws std::out_of_range if the index is not valid
+			/// \throws std::runtime_error if the chunk is still lazy and holds no compressed data
+			const std::vector<std::byte>& compressed_chunk(size_t index) const
+			{
+				this->validate_chunk_index(index);
+				if (this->m_Chunks[index].is_lazy())
+				{
+					throw std::runtime_error(
+						std::format(
+							"Cannot retrieve compressed bytes for chunk {} as it is still lazy and holds no compressed data."
+							" Query is_lazy() and use lazy_value() instead.", index
+						)
+					);
+				}
+				return std::get<std::vector<std::byte>>(this->m_Chunks[index].value);
+			}
+
+			/// Retrieve the fill value of the still-lazy chunk at `index`.
+			///
+			/// \throws std::out_of_range if the index is not valid
+			/// \throws std::runtime_error if the chunk was already materialized
+			T lazy_value(size_t index) const
+			{
+				this->validate_chunk_index(index);
+				if (!this->m_Chunks[index].is_lazy())
+				{
+					throw std::runtime_error(
+						std::format(
+							"Cannot retrieve the lazy fill value for chunk {} as it was already materialized into"
+							" compressed data.", index
+						)
+					);
+				}
+				return std::get<T>(this->m_Chunks[index].value);
+			}
+
+			/// Append a still-lazy chunk holding just the fill value, without compressing anything.
+			///
+			/// \param value The fill value of the chunk.
+			/// \param num_elements The number of elements the chunk logically stores.
+			void append_lazy_chunk(T value, size_t num_elements)
+			{
+				auto chunk = detail::lazy_chunk<T>{ .value = value, .num_elements = num_elements };
+				this->m_Chunks.push_back(std::move(chunk));
+				this->record_chunk_stats(this->m_Chunks.size() - 1, value, num_elements);
+			}
+
 			/// Retrieve the total compressed size of the lazy-schunk.
 			/// Lazy chunks will count as the size of T.
 			size_t csize() const noexcept override
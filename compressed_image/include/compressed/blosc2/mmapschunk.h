@@ -0,0 +1,392 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <filesystem>
+#include <cstddef>
+#include <cstring>
+#include <cassert>
+
+#include "compressed/macros.h"
+#include "compressed/util.h"
+#include "compressed/blosc2/util.h"
+#include "compressed/detail/scoped_timer.h"
+#include "compressed/detail/mmap_file.h"
+#include "wrapper.h"
+#include "schunk_mixin.h"
+
+namespace NAMESPACE_COMPRESSED_IMAGE
+{
+
+	namespace blosc2
+	{
+
+		/// Super-chunk whose compressed chunks live in a memory-mapped spill file instead of the heap.
+		///
+		/// Functionally equivalent to `schunk<T>` but intended for out-of-core workloads where even
+		/// the compressed data of all alive images exceeds RAM. The OS page cache manages residency
+		/// so images that have not been touched in a while cost near-zero RSS while hot chunks stay
+		/// cached in memory. The spill file is owned by the schunk and removed on destruction.
+		///
+		/// Each chunk occupies a fixed slot of `min_compressed_size(chunk_size)` bytes within the
+		/// file so recompressed chunks can always be rewritten in place. The file is therefore
+		/// slightly larger than the sum of the compressed sizes but never needs compaction.
+		///
+		/// Unlike `schunk<T>` this struct is move-only as it exclusively owns its spill file.
+		template <typename T>
+		struct mmap_schunk final : public detail::schunk_mixin<T, size_t>
+		{
+			using detail::schunk_mixin<T, size_t>::chunk_bytes;
+
+			mmap_schunk() = default;
+
+			mmap_schunk(mmap_schunk&& other) noexcept
+			{
+				this->m_Chunks = std::move(other.m_Chunks);
+				this->m_ChunkSize = other.m_ChunkSize;
+				this->m_BlockSize = other.m_BlockSize;
+				this->m_BufferPool = std::move(other.m_BufferPool);
+				this->m_ChunkStats = std::move(other.m_ChunkStats);
+				this->m_TrackChunkStats = other.m_TrackChunkStats;
+				this->m_File = std::move(other.m_File);
+			}
+			mmap_schunk& operator=(mmap_schunk&& other) noexcept
+			{
+				if (this != &other)
+				{
+					this->m_Chunks = std::move(other.m_Chunks);
+					this->m_ChunkSize = other.m_ChunkSize;
+					this->m_BlockSize = other.m_BlockSize;
+					this->m_BufferPool = std::move(other.m_BufferPool);
+					this->m_ChunkStats = std::move(other.m_ChunkStats);
+					this->m_TrackChunkStats = other.m_TrackChunkStats;
+					this->m_File = std::move(other.m_File);
+				}
+				return *this;
+			}
+			mmap_schunk(const mmap_schunk& other) = delete;
+			mmap_schunk& operator=(const mmap_schunk& other) = delete;
+
+
+			/// Initialize an empty mmap-backed schunk spilling to `spill_path`. The data can then
+			/// later be filled with append_chunk for example.
+			///
+			/// \param spill_path The file to back the compressed chunks with, gets created (or
+			///					  truncated) immediately and removed again on destruction.
+			/// \param block_size The requested block size. It is up to the caller to ensure
+			///                   this is appropriately sized
+			/// \param chunk_size The requested chunk size. It is up to the caller to ensure
+			///                   this is appropriately sized (i.e. by using util::align_chunk_to_scanlines)
+			mmap_schunk(std::filesystem::path spill_path, size_t block_size, size_t chunk_size)
+			{
+				util::validate_chunk_size<T>(chunk_size, "mmap_schunk");
+				this->m_ChunkSize = chunk_size;
+				this->m_BlockSize = block_size;
+				this->m_File = compressed::detail::mmap_file(std::move(spill_path), this->slot_size());
+			}
+
+			/// Initialize an mmap-backed super-chunk from the given span, compressing it directly
+			/// into the spill file.
+			///
+			/// \param data The data to store
+			/// \param spill_path The file to back the compressed chunks with, gets created (or
+			///					  truncated) immediately and removed again on destruction.
+			/// \param block_size The requested block size. It is up to the caller to ensure
+			///                   this is appropriately sized
+			/// \param chunk_size The requested chunk size. It is up to the caller to ensure
+			///                   this is appropriately sized (i.e. by using util::align_chunk_to_scanlines)
+			/// \param compression_ctx The compression context to be used for compressing the data.
+			mmap_schunk(
+				std::span<const T> data,
+				std::filesystem::path spill_path,
+				size_t block_size,
+				size_t chunk_size,
+				blosc2::context_ptr& compression_ctx
+			)
+			{
+				util::validate_chunk_size<T>(chunk_size, "mmap_schunk");
+				this->m_BlockSize = block_size;
+				this->m_ChunkSize = chunk_size;
+
+				size_t num_elements = data.size();
+				size_t num_bytes = num_elements * sizeof(T);
+
+				// Calculate all 'full' chunks and the final remainder (if any).
+				size_t num_full_chunks = num_bytes / this->chunk_bytes();
+				size_t remainder_bytes = num_bytes - (this->chunk_bytes() * num_full_chunks);
+				size_t total_chunks = num_full_chunks + (remainder_bytes > 0 ? 1 : 0);
+
+				// Size the spill file up-front so we never pay a remap while compressing.
+				this->m_File = compressed::detail::mmap_file(
+					std::move(spill_path),
+					std::max<size_t>(total_chunks, 1) * this->slot_size()
+				);
+
+				size_t data_offset = 0;
+				// Initialize the chunks by compressing them directly into their slots.
+				for ([[maybe_unused]] auto idx : std::views::iota(size_t{ 0 }, num_full_chunks))
+				{
+					auto subspan = std::span<const T>(data.data() + data_offset, this->chunk_elements());
+					auto slot = this->slot_view(this->m_Chunks.size());
+					auto csize = blosc2::compress<T>(compression_ctx, subspan, slot);
+					this->m_Chunks.push_back(csize);
+
+					data_offset += this->chunk_elements();
+				}
+				if (remainder_bytes > 0)
+				{
+					auto subspan = std::span<const T>(data.data() + data_offset, data.size() - data_offset);
+					auto slot = this->slot_view(this->m_Chunks.size());
+					auto csize = blosc2::compress<T>(compression_ctx, subspan, slot);
+					this->m_Chunks.push_back(csize);
+				}
+			}
+
+			schunk_ptr to_schunk() override
+			{
+				_COMPRESSED_PROFILE_FUNCTION();
+				blosc2::schunk_ptr schunk = create_default_schunk();
+				for (auto idx : std::views::iota(size_t{ 0 }, this->m_Chunks.size()))
+				{
+					auto chunk = this->chunk_view(idx);
+					blosc2_schunk_append_chunk(
+						schunk.get(),
+						reinterpret_cast<uint8_t*>(const_cast<std::byte*>(chunk.data())),
+						true // copy, blosc2 will internally at some point do this anyways.
+					);
+				}
+
+				return schunk;
+			}
+
+			std::vector<T> to_uncompressed(blosc2::context_ptr& decompression_ctx) const override
+			{
+				_COMPRESSED_PROFILE_FUNCTION();
+				auto num_elems = this->size();
+				std::vector<T> data(num_elems);
+
+				size_t data_offset = 0;
+				for (auto idx : std::views::iota(size_t{ 0 }, this->m_Chunks.size()))
+				{
+					size_t chunk_elems = this->chunk_elements(idx);
+
+					auto subspan = std::span<T>(data.data() + data_offset, chunk_elems);
+					this->chunk(decompression_ctx, subspan, idx);
+
+					data_offset += chunk_elems;
+				}
+
+				return data;
+			}
+
+			std::vector<T> chunk(blosc2::context_ptr& decompression_ctx, size_t index) const override
+			{
+				return this->chunk(decompression_ctx.get(), index);
+			}
+
+			std::vector<T> chunk(blosc2::context_raw_ptr decompression_ctx, size_t index) const override
+			{
+				this->validate_chunk_index(index);
+
+				std::vector<T> decompressed(this->chunk_elements(index));
+				blosc2::decompress(decompression_ctx, std::span<T>(decompressed), this->chunk_view(index));
+
+				return std::move(decompressed);
+			}
+
+			void chunk(blosc2::context_ptr& decompression_ctx, std::span<T> buffer, size_t index) const override
+			{
+				this->chunk(decompression_ctx.get(), buffer, index);
+			}
+
+			void chunk(blosc2::context_raw_ptr decompression_ctx, std::span<T> buffer, size_t index, size_t element_offset, size_t num_elements) const override
+			{
+				this->validate_chunk_range(index, element_offset, num_elements);
+				blosc2::decompress_partial(decompression_ctx, buffer, this->chunk_view(index), element_offset, num_elements);
+			}
+
+			void chunk(blosc2::context_raw_ptr decompression_ctx, std::span<T> buffer, size_t index) const override
+			{
+				this->validate_chunk_index(index);
+
+				if (buffer.size() < this->chunk_elements(index))
+				{
+					throw std::invalid_argument(
+						std::format(
+							"Unable to decompress chunk at idx {} into buffer as the buffer needs to at least have the size {:L}."
+							" Instead got {:L}", index, this->chunk_elements(index), buffer.size()
+						)
+					);
+				}
+
+				blosc2::decompress(decompression_ctx, std::span<T>(buffer), this->chunk_view(index));
+			}
+
+			void set_chunk(std::vector<std::byte> compressed, size_t index) override
+			{
+				this->set_chunk(std::span<const std::byte>(compressed.data(), compressed.size()), index);
+			}
+
+			void set_chunk(std::span<const std::byte> compressed, size_t index) override
+			{
+				this->validate_chunk_index(index);
+				this->write_slot(compressed, index);
+				this->invalidate_chunk_stats(index);
+				this->validate_chunk_sizes();
+			}
+
+			void set_chunk(blosc2::context_ptr& compression_ctx, std::span<T> uncompressed, size_t index) override
+			{
+				this->validate_chunk_index(index);
+
+				// Compress straight into the chunk's slot, the fixed slot capacity of
+				// min_compressed_size(chunk_bytes()) guarantees the worst case fits.
+				auto slot = this->slot_view(index);
+				auto csize = blosc2::compress<T>(compression_ctx, uncompressed, slot);
+				this->m_Chunks[index] = csize;
+				this->record_chunk_stats(index, std::span<const T>(uncompressed.begin(), uncompressed.end()));
+				this->validate_chunk_sizes();
+			}
+
+			/// Append to the schunk with the already compressed data.
+			///
+			/// \param compressed the compressed chunk
+			void append_chunk(std::vector<std::byte> compressed) override
+			{
+				this->reserve_slot();
+				this->m_Chunks.push_back(0);
+				this->write_slot(std::span<const std::byte>(compressed.data(), compressed.size()), this->m_Chunks.size() - 1);
+				this->validate_chunk_sizes();
+			};
+
+			/// Append to the schunk with the uncompressed data (compressing it).
+			///
+			/// \param compression_ctx the compression context to use for compression.
+			/// \param uncompressed the uncompressed chunk
+			void append_chunk(blosc2::context_ptr& compression_ctx, std::span<T> uncompressed) override
+			{
+				this->reserve_slot();
+				auto slot = this->slot_view(this->m_Chunks.size());
+				auto csize = blosc2::compress<T>(compression_ctx, uncompressed, slot);
+				this->m_Chunks.push_back(csize);
+				this->record_chunk_stats(this->m_Chunks.size() - 1, std::span<const T>(uncompressed.begin(), uncompressed.end()));
+				this->validate_chunk_sizes();
+			};
+
+			void append_chunk(blosc2::context_ptr& compression_ctx, std::span<T> uncompressed, [[maybe_unused]] std::span<std::byte> compression_buff) override
+			{
+				// The chunk slot within the mapped file acts as the compression buffer so the
+				// caller-provided scratch is not needed here.
+				this->append_chunk(compression_ctx, uncompressed);
+			}
+
+			size_t chunk_bytes(size_t index) const override
+			{
+				return blosc2::chunk_num_elements<T>(this->chunk_view(index)) * sizeof(T);
+			}
+
+			/// Retrieve a view over the raw compressed bytes of the chunk at `index`, e.g. for
+			/// serialization or cloning without a decompress-recompress roundtrip.
+			///
+			/// The view points into the memory-mapped spill file and is invalidated by any
+			/// operation that appends a chunk (as the mapping may be re-established).
+			///
+			/// \throws std::out_of_range if the index is not valid
+			std::span<const std::byte> compressed_chunk(size_t index) const
+			{
+				this->validate_chunk_index(index);
+				return this->chunk_view(index);
+			}
+
+			/// The path of the spill file backing this schunk.
+			const std::filesystem::path& spill_path() const noexcept
+			{
+				return m_File.path();
+			}
+
+			/// Flush the spill file back to disk, e.g. before handing the file to another process.
+			void flush()
+			{
+				m_File.flush();
+			}
+
+			/// The total compressed size of the schunk
+			virtual size_t csize() const noexcept override
+			{
+				size_t _size = 0;
+				for (const auto& chunk_csize : this->m_Chunks)
+				{
+					_size += chunk_csize;
+				}
+				return _size;
+			};
+
+			size_t size() const noexcept override
+			{
+				size_t _size = 0;
+				for (auto idx : std::views::iota(size_t{ 0 }, this->m_Chunks.size()))
+				{
+					_size += blosc2::chunk_num_elements<T>(this->chunk_view(idx));
+				}
+				return _size;
+			};
+
+		private:
+
+			compressed::detail::mmap_file m_File;
+
+			/// The fixed per-chunk slot capacity within the spill file. Sized to the worst-case
+			/// compressed size so any recompressed chunk can be rewritten in place.
+			size_t slot_size() const noexcept
+			{
+				return blosc2::min_compressed_size(this->m_ChunkSize);
+			}
+
+			/// Mutable view over the full slot of the chunk at `index`.
+			std::span<std::byte> slot_view(size_t index)
+			{
+				assert(m_File.valid());
+				return std::span<std::byte>(m_File.data() + index * this->slot_size(), this->slot_size());
+			}
+
+			/// View over the compressed bytes of the chunk at `index`.
+			std::span<const std::byte> chunk_view(size_t index) const
+			{
+				assert(m_File.valid());
+				return std::span<const std::byte>(m_File.data() + index * this->slot_size(), this->m_Chunks[index]);
+			}
+
+			/// Ensure the spill file has capacity for one more chunk slot, growing geometrically
+			/// to amortize the remap cost.
+			void reserve_slot()
+			{
+				size_t required = (this->m_Chunks.size() + 1) * this->slot_size();
+				if (required > m_File.capacity())
+				{
+					m_File.resize(std::max(required, m_File.capacity() * 2));
+				}
+			}
+
+			/// Copy the compressed bytes into the slot of the chunk at `index`.
+			///
+			/// \throws std::runtime_error if the compressed data exceeds the slot capacity.
+			void write_slot(std::span<const std::byte> compressed, size_t index)
+			{
+				if (compressed.size() > this->slot_size())
+				{
+					throw std::runtime_error(
+						std::format(
+							"Unable to store compressed chunk of {:L} bytes in mmap-backed schunk, the maximum"
+							" per-chunk capacity is {:L} bytes", compressed.size(), this->slot_size()
+						)
+					);
+				}
+				std::memcpy(this->slot_view(index).data(), compressed.data(), compressed.size());
+				this->m_Chunks[index] = compressed.size();
+			}
+
+		};
+
+	} // blosc2
+
+} // NAMESPACE_COMPRESSED_IMAGE
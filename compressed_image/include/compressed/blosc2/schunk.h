@@ -3,13 +3,18 @@
 #include <span>
 #include <vector>
 #include <cstddef>
+#include <cstring>
 #include <cassert>
+#include <algorithm>
+#include <execution>
+#include <ranges>
 
 #include "compressed/macros.h"
 #include "compressed/util.h"
 #include "compressed/blosc2/util.h"
 #include "compressed/detail/scoped_timer.h"
 #include "wrapper.h"
+#include "context_pool.h"
 #include "schunk_mixin.h"
 
 namespace NAMESPACE_COMPRESSED_IMAGE
@@ -25,19 +30,25 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 
 			schunk() = default;
 
-			schunk(schunk&& other) noexcept 
+			schunk(schunk&& other) noexcept
 			{
 				this->m_Chunks = std::move(other.m_Chunks);
 				this->m_ChunkSize = other.m_ChunkSize;
 				this->m_BlockSize = other.m_BlockSize;
+				this->m_BufferPool = std::move(other.m_BufferPool);
+				this->m_ChunkStats = std::move(other.m_ChunkStats);
+				this->m_TrackChunkStats = other.m_TrackChunkStats;
 			}
-			schunk& operator=(schunk&& other) noexcept 
+			schunk& operator=(schunk&& other) noexcept
 			{
-				if (this != &other) 
+				if (this != &other)
 				{
 					this->m_Chunks = std::move(other.m_Chunks);
 					this->m_ChunkSize = other.m_ChunkSize;
 					this->m_BlockSize = other.m_BlockSize;
+					this->m_BufferPool = std::move(other.m_BufferPool);
+					this->m_ChunkStats = std::move(other.m_ChunkStats);
+					this->m_TrackChunkStats = other.m_TrackChunkStats;
 				}
 				return *this;
 			}
@@ -104,6 +115,63 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 				}
 			}
 
+			/// Initialize a super-chunk from the given buffer, compressing the chunks in parallel.
+			///
+			/// Unlike the context-taking overload above this compresses all chunks concurrently,
+			/// each task leasing its own single-threaded context from the global pool. The chunks
+			/// are fully independent so the parallelism comes from the chunk level rather than from
+			/// blosc2's intra-chunk threads which cannot saturate a wide machine on chunk-sized
+			/// buffers. Prefer this overload for bulk ingestion of large buffers.
+			///
+			/// \param data The data to store
+			/// \param block_size The requested block size. It is up to the caller to ensure
+			///                   this is appropriately sized
+			/// \param chunk_size The requested chunk size. It is up to the caller to ensure
+			///                   this is appropriately sized (i.e. by using util::align_chunk_to_scanlines)
+			/// \param codec The compression codec the chunks are to be compressed with.
+			/// \param compression_level The compression level to apply.
+			/// \param filter The pre-compression filter to apply.
+			schunk(
+				std::span<const T> data,
+				size_t block_size,
+				size_t chunk_size,
+				enums::codec codec,
+				uint8_t compression_level,
+				enums::filter filter = enums::filter::shuffle
+			)
+			{
+				_COMPRESSED_PROFILE_FUNCTION();
+				util::validate_chunk_size<T>(chunk_size, "schunk");
+				this->m_BlockSize = block_size;
+				this->m_ChunkSize = chunk_size;
+
+				size_t num_bytes = data.size() * sizeof(T);
+				size_t num_full_chunks = num_bytes / this->chunk_bytes();
+				size_t remainder_bytes = num_bytes - (this->chunk_bytes() * num_full_chunks);
+				size_t num_chunks = num_full_chunks + (remainder_bytes > 0 ? 1 : 0);
+
+				// Each task writes into its own pre-sized slot so no synchronization is needed
+				// around m_Chunks itself.
+				this->m_Chunks.resize(num_chunks);
+
+				auto chunk_range = std::views::iota(size_t{ 0 }, num_chunks);
+				std::for_each(std::execution::par_unseq, chunk_range.begin(), chunk_range.end(), [&](size_t chunk_idx)
+					{
+						size_t data_offset = chunk_idx * this->chunk_elements();
+						auto subspan = std::span<const T>(data.data() + data_offset, std::min(this->chunk_elements(), data.size() - data_offset));
+
+						// Lease a single-threaded context per task, the parallelism already comes
+						// from the chunk level so intra-chunk threads would only oversubscribe.
+						auto ctx = blosc2::global_context_pool().checkout_compression<T>(1, codec, compression_level, block_size, filter);
+
+						util::default_init_vector<std::byte> compression_buffer(blosc2::min_compressed_size(chunk_size));
+						auto compression_span = std::span<std::byte>(compression_buffer);
+						auto csize = blosc2::compress<T>(ctx.ctx(), subspan, compression_span);
+
+						this->m_Chunks[chunk_idx] = std::vector<std::byte>(compression_span.begin(), compression_span.begin() + csize);
+					});
+			}
+
 			schunk_ptr to_schunk() override
 			{
 				_COMPRESSED_PROFILE_FUNCTION();
@@ -161,6 +229,14 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 				this->chunk(decompression_ctx.get(), buffer, index);
 			}
 
+			void chunk(blosc2::context_raw_ptr decompression_ctx, std::span<T> buffer, size_t index, size_t element_offset, size_t num_elements) const override
+			{
+				this->validate_chunk_range(index, element_offset, num_elements);
+
+				auto chunk_span = std::span<const std::byte>(this->m_Chunks[index].begin(), this->m_Chunks[index].end());
+				blosc2::decompress_partial(decompression_ctx, buffer, chunk_span, element_offset, num_elements);
+			}
+
 			void chunk(blosc2::context_raw_ptr decompression_ctx, std::span<T> buffer, size_t index) const override
 			{
 				this->validate_chunk_index(index);
@@ -182,14 +258,27 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			void set_chunk(std::vector<std::byte> compressed, size_t index) override
 			{
 				this->validate_chunk_index(index);
+				this->recycle_buffer(std::move(this->m_Chunks[index]));
 				this->m_Chunks[index] = std::move(compressed);
+				this->invalidate_chunk_stats(index);
 				this->validate_chunk_sizes();
 			}
 
 			void set_chunk(std::span<const std::byte> compressed, size_t index) override
 			{
 				this->validate_chunk_index(index);
-				this->m_Chunks[index] = std::vector<std::byte>(compressed.begin(), compressed.end());
+				if (this->m_BufferPool)
+				{
+					auto buffer = this->acquire_buffer(compressed.size());
+					std::memcpy(buffer.data(), compressed.data(), compressed.size());
+					this->recycle_buffer(std::move(this->m_Chunks[index]));
+					this->m_Chunks[index] = std::move(buffer);
+				}
+				else
+				{
+					this->m_Chunks[index] = std::vector<std::byte>(compressed.begin(), compressed.end());
+				}
+				this->invalidate_chunk_stats(index);
 				this->validate_chunk_sizes();
 			}
 
@@ -197,13 +286,28 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			{
 				this->validate_chunk_index(index);
 
-				util::default_init_vector<std::byte> compression_buffer(blosc2::min_compressed_size(this->chunk_bytes()));
-				std::span<std::byte> compression_span(compression_buffer);
+				if (this->m_BufferPool)
+				{
+					// Compress into a pooled buffer and store it directly, recycling the replaced
+					// chunk. This makes the recompress cycle allocation-free at the cost of the
+					// stored chunk keeping its worst-case capacity until it cycles through the pool.
+					auto buffer = this->acquire_buffer(blosc2::min_compressed_size(this->chunk_bytes()));
+					auto csize = blosc2::compress<T>(compression_ctx, uncompressed, std::span<std::byte>(buffer));
+					buffer.resize(csize);
+					this->recycle_buffer(std::move(this->m_Chunks[index]));
+					this->m_Chunks[index] = std::move(buffer);
+				}
+				else
+				{
+					util::default_init_vector<std::byte> compression_buffer(blosc2::min_compressed_size(this->chunk_bytes()));
+					std::span<std::byte> compression_span(compression_buffer);
 
-				auto csize = blosc2::compress<T>(compression_ctx, uncompressed, compression_span);
+					auto csize = blosc2::compress<T>(compression_ctx, uncompressed, compression_span);
 
-				// copy over a new vector containing all the elements from the compression span.
-				this->m_Chunks[index] = std::vector<std::byte>(compression_span.begin(), compression_span.begin() + csize);
+					// copy over a new vector containing all the elements from the compression span.
+					this->m_Chunks[index] = std::vector<std::byte>(compression_span.begin(), compression_span.begin() + csize);
+				}
+				this->record_chunk_stats(index, std::span<const T>(uncompressed.begin(), uncompressed.end()));
 				this->validate_chunk_sizes();
 			}
 
@@ -222,6 +326,18 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			/// \param uncompressed the uncompressed chunk
 			void append_chunk(blosc2::context_ptr& compression_ctx, std::span<T> uncompressed) override
 			{
+				if (this->m_BufferPool)
+				{
+					// Compress into a pooled buffer and append it directly, avoiding the
+					// intermediate scratch allocation and the copy out of it.
+					auto buffer = this->acquire_buffer(blosc2::min_compressed_size(this->chunk_bytes()));
+					auto csize = blosc2::compress<T>(compression_ctx, uncompressed, std::span<std::byte>(buffer));
+					buffer.resize(csize);
+					this->m_Chunks.push_back(std::move(buffer));
+					this->record_chunk_stats(this->m_Chunks.size() - 1, std::span<const T>(uncompressed.begin(), uncompressed.end()));
+					this->validate_chunk_sizes();
+					return;
+				}
 				util::default_init_vector<std::byte> compression_buffer(blosc2::min_compressed_size(this->chunk_bytes()));
 				std::span<std::byte> compression_span(compression_buffer);
 				this->append_chunk(compression_ctx, uncompressed, compression_span);
@@ -242,8 +358,18 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 				}
 				auto csize = blosc2::compress<T>(compression_ctx, uncompressed, compression_buff);
 				assert(csize <= compression_buff.size());
-				// copy over a new vector containing all the elements from the compression span.
-				this->m_Chunks.push_back(std::vector<std::byte>(compression_buff.begin(), compression_buff.begin() + csize));
+				if (this->m_BufferPool)
+				{
+					auto buffer = this->acquire_buffer(csize);
+					std::memcpy(buffer.data(), compression_buff.data(), csize);
+					this->m_Chunks.push_back(std::move(buffer));
+				}
+				else
+				{
+					// copy over a new vector containing all the elements from the compression span.
+					this->m_Chunks.push_back(std::vector<std::byte>(compression_buff.begin(), compression_buff.begin() + csize));
+				}
+				this->record_chunk_stats(this->m_Chunks.size() - 1, std::span<const T>(uncompressed.begin(), uncompressed.end()));
 				this->validate_chunk_sizes();
 			}
 
@@ -252,6 +378,16 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 				return blosc2::chunk_num_elements<T>(this->m_Chunks[index]) * sizeof(T);
 			}
 
+			/// Retrieve a view over the raw compressed bytes of the chunk at `index`, e.g. for
+			/// serialization or cloning without a decompress-recompress roundtrip.
+			///
+			/// \throws std::out_of_range if the index is not valid
+			const std::vector<std::byte>& compressed_chunk(size_t index) const
+			{
+				this->validate_chunk_index(index);
+				return this->m_Chunks[index];
+			}
+
 			/// The total compressed size of the schunk
 			virtual size_t csize() const noexcept override
 			{
@@ -2,11 +2,15 @@
 
 #include <span>
 #include <vector>
+#include <memory>
+#include <optional>
+#include <algorithm>
 #include <cstddef>
 
 #include "compressed/macros.h"
 #include "wrapper.h"
 #include "compressed/constants.h"
+#include "compressed/detail/buffer_pool.h"
 
 namespace NAMESPACE_COMPRESSED_IMAGE
 {
@@ -69,11 +73,25 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 				/// \throws std::out_of_range if the index is not valid
 				virtual void chunk(blosc2::context_raw_ptr decompression_ctx, std::span<T> buffer, size_t index) const = 0;
 
+				/// Retrieve a sub-range of the uncompressed chunk at `index`.
+				///
+				/// Only the blocks of the chunk intersecting the requested element range are decoded
+				/// (see `blosc2::decompress_partial`) so small reads do not pay for the whole chunk.
+				///
+				/// \param decompression_ctx the decompression context ptr
+				/// \param buffer the buffer to fill with the uncompressed range, must hold at least `num_elements`.
+				/// \param index the index of the chunk within the schunk.
+				/// \param element_offset the element index within the uncompressed chunk to start reading at.
+				/// \param num_elements the number of elements to read.
+				///
+				/// \throws std::out_of_range if the index or the element range is not valid
+				virtual void chunk(blosc2::context_raw_ptr decompression_ctx, std::span<T> buffer, size_t index, size_t element_offset, size_t num_elements) const = 0;
+
 				/// Set the chunk at `index` to the compressed data.
 				///
 				/// \param compressed the compressed chunk
 				/// \param index the index of the chunk within the schunk.
-				/// 
+				///
 				/// \throws std::out_of_range if the index is not valid
 				virtual void set_chunk(std::vector<std::byte> compressed, size_t index) = 0;
 
@@ -183,18 +201,103 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 					return size() * sizeof(T);
 				}
 
-				size_t max_chunk_size()
+				size_t max_chunk_size() const
 				{
 					return m_ChunkSize;
 				}
 
-				size_t max_block_size()
+				size_t max_block_size() const
 				{
 					return m_BlockSize;
 				}
 
+				/// Per-chunk statistics recorded at compression time, see `track_chunk_stats`.
+				struct chunk_stats
+				{
+					T minimum{};
+					T maximum{};
+					double sum = 0.0;
+				};
+
+				/// Enable or disable recording of per-chunk min/max/sum at compression time.
+				///
+				/// With tracking enabled every `set_chunk`/`append_chunk` taking uncompressed data
+				/// additionally records the chunk's minimum, maximum and sum, making later statistics
+				/// queries O(num_chunks) instead of a full decode. Chunks written as already-compressed
+				/// bytes carry no statistics, their entries stay empty until they are rewritten from
+				/// uncompressed data. Disabling drops all recorded statistics.
+				void track_chunk_stats(bool enabled)
+				{
+					m_TrackChunkStats = enabled;
+					m_ChunkStats.clear();
+					if (enabled)
+					{
+						m_ChunkStats.resize(this->num_chunks());
+					}
+				}
+
+				/// Whether per-chunk statistics are recorded at compression time.
+				bool track_chunk_stats() const noexcept
+				{
+					return m_TrackChunkStats;
+				}
+
+				/// Retrieve the recorded statistics of the chunk at `index`, std::nullopt if the chunk
+				/// was never compressed from uncompressed data while tracking was enabled.
+				///
+				/// \throws std::out_of_range if the index is not valid
+				std::optional<chunk_stats> chunk_stats_at(size_t index) const
+				{
+					this->validate_chunk_index(index);
+					if (index >= m_ChunkStats.size())
+					{
+						return std::nullopt;
+					}
+					return m_ChunkStats[index];
+				}
+
+				/// Record the statistics of the chunk at `index` from its uncompressed source data,
+				/// no-op unless tracking is enabled (see `track_chunk_stats`).
+				///
+				/// The overloads of `set_chunk` taking uncompressed data record statistics themselves.
+				/// This entry point exists for callers that compress a chunk externally (e.g. to keep
+				/// the codec work outside of a publication lock) and publish it via the compressed
+				/// `set_chunk` overload, which on its own has to drop the chunk's statistics as it
+				/// cannot know the content.
+				///
+				/// \throws std::out_of_range if the index is not valid
+				void record_chunk_statistics(size_t index, std::span<const T> uncompressed)
+				{
+					this->validate_chunk_index(index);
+					this->record_chunk_stats(index, uncompressed);
+				}
+
+				/// Attach a buffer pool that chunk storage is recycled through.
+				///
+				/// When set, `set_chunk` and `append_chunk` draw their allocations from the pool and
+				/// return replaced chunk buffers to it instead of round-tripping the heap for every
+				/// chunk. The pool may be shared across the schunks of a channel or a whole image.
+				/// Passing nullptr detaches the pool, restoring plain heap allocation.
+				void buffer_pool(std::shared_ptr<compressed::detail::byte_buffer_pool> pool) noexcept
+				{
+					m_BufferPool = std::move(pool);
+				}
+
+				/// Retrieve the attached buffer pool, nullptr if none is attached.
+				std::shared_ptr<compressed::detail::byte_buffer_pool> buffer_pool() const noexcept
+				{
+					return m_BufferPool;
+				}
+
 			protected:
 				std::vector<ContainerType> m_Chunks{};
+				/// Optional pool that chunk buffers are acquired from and recycled into, may be shared
+				/// across schunks. Nullptr means plain heap allocation.
+				std::shared_ptr<compressed::detail::byte_buffer_pool> m_BufferPool = nullptr;
+				/// Per-chunk statistics recorded at compression time, only populated while
+				/// m_TrackChunkStats is set. Indexed like m_Chunks, entries may be empty.
+				std::vector<std::optional<chunk_stats>> m_ChunkStats{};
+				bool m_TrackChunkStats = false;
 				/// The maximum size a chunk is constrained to, in bytes. This will dictate the size of all chunks from
 				///  0 - (this->m_Chunks.size() - 1). The last chunk may be any other size smaller than or equal to this value.
 				size_t m_ChunkSize = s_default_chunksize;
@@ -211,8 +314,24 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 					}
 				}
 
+				/// Validate that the element range [element_offset, element_offset + num_elements) lies within
+				/// the uncompressed chunk at `index`, throwing a std::out_of_range if it does not.
+				void validate_chunk_range(size_t index, size_t element_offset, size_t num_elements) const
+				{
+					this->validate_chunk_index(index);
+					if (element_offset + num_elements > this->chunk_elements(index))
+					{
+						throw std::out_of_range(
+							std::format(
+								"Cannot access element range [{:L}, {:L}) in chunk {} of schunk. The chunk only holds {:L} elements",
+								element_offset, element_offset + num_elements, index, this->chunk_elements(index)
+							)
+						);
+					}
+				}
+
 				/// Validate all the chunk sizes currently held by the super-chunk. This function
-				/// ensures that the chunks 
+				/// ensures that the chunks
 				void validate_chunk_sizes() const
 				{
 					// Check that all chunks barring the last one are equal to m_ChunkSize
@@ -245,6 +364,84 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 					}
 				}
 
+				/// Acquire a byte buffer of exactly `size` bytes, drawing from the attached buffer
+				/// pool if one is set and falling back to a plain heap allocation otherwise.
+				std::vector<std::byte> acquire_buffer(size_t size) const
+				{
+					if (m_BufferPool)
+					{
+						return m_BufferPool->acquire(size);
+					}
+					return std::vector<std::byte>(size);
+				}
+
+				/// Return a no longer needed byte buffer to the attached buffer pool, dropping it
+				/// if no pool is set.
+				void recycle_buffer(std::vector<std::byte>&& buffer) const
+				{
+					if (m_BufferPool)
+					{
+						m_BufferPool->release(std::move(buffer));
+					}
+				}
+
+				/// Record min/max/sum of `uncompressed` as the statistics of the chunk at `index`,
+				/// no-op unless tracking is enabled (see `track_chunk_stats`). To be called by the
+				/// subclasses whenever a chunk is (re)compressed from uncompressed data.
+				void record_chunk_stats(size_t index, std::span<const T> uncompressed)
+				{
+					if (!m_TrackChunkStats)
+					{
+						return;
+					}
+					// There is nothing to record for an empty span, and the min/max seeding below
+					// must not dereference it.
+					if (uncompressed.empty())
+					{
+						return;
+					}
+					if (index >= m_ChunkStats.size())
+					{
+						m_ChunkStats.resize(index + 1);
+					}
+
+					chunk_stats stats{};
+					stats.minimum = uncompressed.front();
+					stats.maximum = uncompressed.front();
+					for (const auto& value : uncompressed)
+					{
+						stats.minimum = std::min(stats.minimum, value);
+						stats.maximum = std::max(stats.maximum, value);
+						stats.sum += static_cast<double>(value);
+					}
+					m_ChunkStats[index] = stats;
+				}
+
+				/// Record the statistics of a constant-valued chunk of `num_elements` times `value`
+				/// at `index` without touching any data, no-op unless tracking is enabled.
+				void record_chunk_stats(size_t index, T value, size_t num_elements)
+				{
+					if (!m_TrackChunkStats)
+					{
+						return;
+					}
+					if (index >= m_ChunkStats.size())
+					{
+						m_ChunkStats.resize(index + 1);
+					}
+					m_ChunkStats[index] = chunk_stats{ value, value, static_cast<double>(value) * static_cast<double>(num_elements) };
+				}
+
+				/// Drop the recorded statistics of the chunk at `index`, to be called by the subclasses
+				/// whenever a chunk is overwritten with already-compressed bytes whose content is unknown.
+				void invalidate_chunk_stats(size_t index)
+				{
+					if (index < m_ChunkStats.size())
+					{
+						m_ChunkStats[index] = std::nullopt;
+					}
+				}
+
 				/// Get the buffer size for T for the given byte size. Checks that the buffer
 				/// can be divided cleanly by sizeof(T).
 				size_t get_T_buffer_size(size_t byte_size) const
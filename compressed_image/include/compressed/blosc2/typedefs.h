@@ -5,17 +5,20 @@
 #include "schunk_mixin.h"
 #include "lazyschunk.h"
 #include "schunk.h"
+#include "mmapschunk.h"
+#include "dedupschunk.h"
+#include "frameschunk.h"
 
 namespace NAMESPACE_COMPRESSED_IMAGE
 {
 
 	namespace blosc2
 	{
-		
+
 		template <typename T>
-		using schunk_var_ptr = std::shared_ptr<std::variant<blosc2::schunk<T>, blosc2::lazy_schunk<T>>>;
+		using schunk_var_ptr = std::shared_ptr<std::variant<blosc2::schunk<T>, blosc2::lazy_schunk<T>, blosc2::mmap_schunk<T>, blosc2::dedup_schunk<T>, blosc2::frame_schunk<T>>>;
 		template <typename T>
-		using schunk_var = std::variant<blosc2::schunk<T>, blosc2::lazy_schunk<T>>;
+		using schunk_var = std::variant<blosc2::schunk<T>, blosc2::lazy_schunk<T>, blosc2::mmap_schunk<T>, blosc2::dedup_schunk<T>, blosc2::frame_schunk<T>>;
 
 	} // blosc2
 
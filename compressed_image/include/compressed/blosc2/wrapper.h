@@ -5,6 +5,8 @@
 #include "compressed/macros.h"
 #include "compressed/enums.h"
 #include "compressed/blosc2/util.h"
+#include "compressed/blosc2/half_filter.h"
+#include "compressed/detail/codec_scheduler.h"
 #include "compressed/detail/scoped_timer.h"
 
 #include "blosc2.h"
@@ -33,6 +35,9 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 				{
 					register_filters();
 				}
+				// Our own half-float shuffle, registering here means any chunk carrying the filter id
+				// decodes correctly no matter which code path triggered the decompression.
+				detail::register_half_shuffle_filter();
 			}
 
 		}
@@ -118,17 +123,51 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			return enums::codec::blosclz;
 		}
 	
-		/// Compress the `data` into `chunk` using the provided `context`. 
-		/// 
-		/// This function applies Blosc2 compression to the input `data` and stores the compressed 
-		/// result in `chunk`. If compression fails, it throws a `std::runtime_error` with the 
+		/// Apply the given pre-compression filter to the compression parameters.
+		///
+		/// The generic shuffle is what BLOSC2_CPARAMS_DEFAULTS already carries so it is a no-op, the
+		/// half-float shuffle replaces the shuffle slot in the filter pipeline with our registered
+		/// custom filter (see `blosc2/half_filter.h`).
+		///
+		/// \tparam T The element type the parameters compress, used to validate the filter fits.
+		/// \param cparams The compression parameters to modify.
+		/// \param filter The filter to apply.
+		/// \throws std::invalid_argument if the half-float shuffle is requested for a non-2-byte type.
+		template <typename T>
+		void apply_filter(blosc2_cparams& cparams, enums::filter filter)
+		{
+			if (filter == enums::filter::shuffle)
+			{
+				return;
+			}
+			if constexpr (sizeof(T) != 2)
+			{
+				throw std::invalid_argument(
+					std::format(
+						"The half-float shuffle filter is only valid for 2-byte element types, got an element size of {}",
+						sizeof(T)
+					)
+				);
+			}
+			else
+			{
+				// The last pipeline slot is where the default shuffle lives, our filter takes its place.
+				cparams.filters[BLOSC2_MAX_FILTERS - 1] = detail::s_half_shuffle_filter_id;
+				cparams.filters_meta[BLOSC2_MAX_FILTERS - 1] = 0;
+			}
+		}
+
+		/// Compress the `data` into `chunk` using the provided `context`.
+		///
+		/// This function applies Blosc2 compression to the input `data` and stores the compressed
+		/// result in `chunk`. If compression fails, it throws a `std::runtime_error` with the
 		/// corresponding Blosc2 error code.
-		/// 
+		///
 		/// \tparam T The data type of the input buffer.
 		/// \param context A raw pointer to the Blosc2 compression context.
 		/// \param data The input data to be compressed, provided as a `std::span<T>`.
 		/// \param chunk The output chunk where compressed data will be stored, provided as a `std::span<std::byte>`.
-		/// \returns The compressed byte size of the chunk. This size includes a header with metadata, 
+		/// \returns The compressed byte size of the chunk. This size includes a header with metadata,
 		///          which Blosc2 internally uses.
 		/// \throws std::runtime_error if compression fails, with the Blosc2 error code.
 		template <typename T>
@@ -136,6 +175,9 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 		{
 			_COMPRESSED_PROFILE_FUNCTION();
 			detail::init_filters();
+			auto permit = compressed::detail::global_codec_scheduler().acquire(
+				compressed::detail::codec_scheduler::priority::background, context
+			);
 			const auto cbytes = blosc2_compress_ctx(
 				context,
 				static_cast<const void*>(data.data()),
@@ -147,11 +189,12 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			{
 				throw std::runtime_error(std::format("Unable to compress context using Blosc2 with error code {}", cbytes));
 			}
+			compressed::detail::record_compression(data.size() * sizeof(T));
 
 			return cbytes;
 		}
-		
-		/// Compress the `data` into `chunk` using the provided `context`. 
+
+		/// Compress the `data` into `chunk` using the provided `context`.
 		/// 
 		/// This function applies Blosc2 compression to the input `data` and stores the compressed 
 		/// result in `chunk`. If compression fails, it throws a `std::runtime_error` with the 
@@ -169,6 +212,9 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 		{
 			_COMPRESSED_PROFILE_FUNCTION();
 			detail::init_filters();
+			auto permit = compressed::detail::global_codec_scheduler().acquire(
+				compressed::detail::codec_scheduler::priority::background, context
+			);
 			const auto cbytes = blosc2_compress_ctx(
 				context,
 				static_cast<const void*>(data.data()),
@@ -180,11 +226,12 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			{
 				throw std::runtime_error(std::format("Unable to compress context using Blosc2 with error code {}", cbytes));
 			}
+			compressed::detail::record_compression(data.size() * sizeof(T));
 
 			return cbytes;
 		}
 
-		/// Compress the `data` into `chunk` using the provided `context`. 
+		/// Compress the `data` into `chunk` using the provided `context`.
 		/// 
 		/// This function applies Blosc2 compression to the input `data` and stores the compressed 
 		/// result in `chunk`. If compression fails, it throws a `std::runtime_error` with the 
@@ -243,6 +290,9 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 				throw std::out_of_range(std::format("Blosc2 chunk size may not exceed numeric limit of int32_t, got {:L} which would exceed that", buffer.size() * sizeof(T)));
 			}
 
+			auto permit = compressed::detail::global_codec_scheduler().acquire(
+				compressed::detail::codec_scheduler::priority::interactive, context
+			);
 			int decompressed_size = blosc2_decompress_ctx(
 				context,
 				static_cast<const void*>(chunk.data()),
@@ -255,6 +305,7 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			{
 				throw std::runtime_error(std::format("Error code {} while decompressing blosc2 chunk", decompressed_size));
 			}
+			compressed::detail::record_decompression(static_cast<uint64_t>(decompressed_size));
 			return decompressed_size;
 		}
 
@@ -276,6 +327,65 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			return decompress(context.get(), buffer, chunk);
 		}
 
+
+		/// Partially decompress `num_elements` elements starting at `element_offset` from `chunk` into `buffer`.
+		///
+		/// Unlike `decompress` this only decodes the blocks of the chunk that actually intersect the
+		/// requested element range (via `blosc2_getitem_ctx`), so small reads out of a large chunk do
+		/// not pay for decompressing the whole thing.
+		///
+		/// \tparam T The data type of the decompressed output.
+		/// \param context A raw pointer to the Blosc2 decompression context.
+		/// \param buffer The output buffer where the decompressed range will be stored, must hold at least `num_elements`.
+		/// \param chunk The compressed input data to be decompressed, provided as a `std::span<std::byte>`.
+		/// \param element_offset The element index within the uncompressed chunk to start reading at.
+		/// \param num_elements The number of elements to read.
+		/// \throws std::invalid_argument if `buffer` cannot hold `num_elements`.
+		/// \throws std::runtime_error if decompression fails, with the Blosc2 error code.
+		template <typename T>
+		void decompress_partial(context_raw_ptr context, std::span<T> buffer, std::span<const std::byte> chunk, size_t element_offset, size_t num_elements)
+		{
+			_COMPRESSED_PROFILE_FUNCTION();
+			detail::init_filters();
+			if (buffer.size() < num_elements)
+			{
+				throw std::invalid_argument(
+					std::format(
+						"Unable to partially decompress blosc2 chunk into buffer as the buffer needs to at least hold {:L}"
+						" elements but instead holds {:L}", num_elements, buffer.size()
+					)
+				);
+			}
+
+			auto permit = compressed::detail::global_codec_scheduler().acquire(
+				compressed::detail::codec_scheduler::priority::interactive, context
+			);
+			int decompressed_size = blosc2_getitem_ctx(
+				context,
+				static_cast<const void*>(chunk.data()),
+				std::numeric_limits<int32_t>::max(),
+				static_cast<int>(element_offset),
+				static_cast<int>(num_elements),
+				buffer.data(),
+				static_cast<int32_t>(num_elements * sizeof(T))
+			);
+
+			if (decompressed_size < 0)
+			{
+				throw std::runtime_error(std::format("Error code {} while partially decompressing blosc2 chunk", decompressed_size));
+			}
+			compressed::detail::record_decompression(num_elements * sizeof(T));
+		}
+
+
+		/// Partially decompress `num_elements` elements starting at `element_offset` from `chunk` into `buffer`,
+		/// see the `context_raw_ptr` overload for the details.
+		template <typename T>
+		void decompress_partial(context_ptr& context, std::span<T> buffer, std::span<const std::byte> chunk, size_t element_offset, size_t num_elements)
+		{
+			decompress_partial(context.get(), buffer, chunk, element_offset, num_elements);
+		}
+
 		/// Append the chunk into the super-chunk. The chunk in this case does not need to be refitted as its actual
 		/// size since c-blosc will read the size from its header bytes.
 		inline size_t append_chunk(schunk_ptr& schunk, std::span<std::byte> chunk)
@@ -309,15 +419,109 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			return blosc2::schunk_ptr(blosc2_schunk_new(&storage));
 		}
 
+		/// Create a schunk with zstd dictionary compression enabled.
+		///
+		/// blosc2 only supports trained dictionaries in super-chunk context: the schunk trains a
+		/// zstd dictionary from the first buffer appended through `append_buffer`, stores it
+		/// alongside the chunks and transparently reuses it for every subsequent chunk encode and
+		/// decode. With small chunk sizes (tiles or low-res proxies) where each chunk would
+		/// otherwise restart its entropy model cold this is worth both ratio and encode speed.
+		///
+		/// The data has to flow through the schunk's own contexts (`append_buffer` /
+		/// `decompress_chunk`) so the dictionary travels with the chunks, do not mix this with
+		/// chunks compressed through an unrelated compression context.
+		template <typename T>
+		blosc2::schunk_ptr create_dict_schunk(size_t nthreads, uint8_t compression_level, size_t block_size, enums::filter filter = enums::filter::shuffle)
+		{
+			detail::init_filters();
+			auto cparams = create_blosc2_cparams<T>(nthreads, enums::codec::zstd, compression_level, block_size, filter, true);
+			auto dparams = BLOSC2_DPARAMS_DEFAULTS;
+			dparams.nthreads = cparams.nthreads;
+			blosc2_storage storage = BLOSC2_STORAGE_DEFAULTS;
+			storage.cparams = &cparams;
+			storage.dparams = &dparams;
+			return blosc2::schunk_ptr(blosc2_schunk_new(&storage));
+		}
+
+		/// Compress and append an uncompressed buffer through the schunk's own compression context.
+		///
+		/// Unlike `append_chunk` this hands the raw data to blosc2 so schunk-level state such as a
+		/// trained zstd dictionary (see `create_dict_schunk`) participates in the encode.
+		///
+		/// \returns The number of chunks in the schunk after the append.
+		/// \throws std::runtime_error if the append fails, with the blosc2 error code.
+		template <typename T>
+		size_t append_buffer(schunk_ptr& schunk, std::span<const T> data)
+		{
+			detail::init_filters();
+			auto nchunks = blosc2_schunk_append_buffer(
+				schunk.get(),
+				static_cast<const void*>(data.data()),
+				static_cast<int32_t>(data.size() * sizeof(T))
+			);
+			if (nchunks < 0)
+			{
+				throw std::runtime_error(std::format("Unable to append buffer into super-chunk with the following blosc2 error code {}", nchunks));
+			}
+			compressed::detail::record_compression(data.size() * sizeof(T));
+
+			return static_cast<size_t>(nchunks);
+		}
+
+		/// Decompress chunk `chunk_index` of the schunk into `buffer` through the schunk's own
+		/// decompression context, so a trained zstd dictionary (see `create_dict_schunk`) is
+		/// available during the decode.
+		///
+		/// \returns The decompressed byte size of the chunk.
+		/// \throws std::runtime_error if decompression fails, with the blosc2 error code.
+		template <typename T>
+		size_t decompress_chunk(schunk_ptr& schunk, size_t chunk_index, std::span<T> buffer)
+		{
+			detail::init_filters();
+			auto nbytes = blosc2_schunk_decompress_chunk(
+				schunk.get(),
+				static_cast<int64_t>(chunk_index),
+				static_cast<void*>(buffer.data()),
+				static_cast<int32_t>(buffer.size() * sizeof(T))
+			);
+			if (nbytes < 0)
+			{
+				throw std::runtime_error(std::format("Error code {} while decompressing blosc2 super-chunk chunk", nbytes));
+			}
+			compressed::detail::record_decompression(static_cast<uint64_t>(nbytes));
+
+			return static_cast<size_t>(nbytes);
+		}
+
+		/// Validate that dictionary compression was requested for a codec that supports it.
+		///
+		/// blosc2 only implements trained dictionaries for zstd, any other codec silently ignores
+		/// the flag which would hand the caller worse ratios than they asked for.
+		///
+		/// \throws std::invalid_argument if `use_dict` is set for a non-zstd codec.
+		inline void validate_dict_codec(enums::codec codec, bool use_dict)
+		{
+			if (use_dict && codec != enums::codec::zstd)
+			{
+				throw std::invalid_argument("Dictionary compression is only supported for the zstd codec");
+			}
+		}
+
 		/// Create blosc2 compression parameters for the given input.
+		///
+		/// `use_dict` enables zstd dictionary training: blosc2 trains a dictionary from the first
+		/// buffer compressed through the parameters and reuses it for every subsequent chunk which
+		/// recovers most of the ratio lost to small chunk sizes. Only valid for the zstd codec and
+		/// only in super-chunk context, see `create_dict_schunk`.
 		template <typename T>
-		blosc2_cparams create_blosc2_cparams(schunk_ptr& schunk, size_t nthreads, enums::codec codec, uint8_t compression_level, size_t block_size)
+		blosc2_cparams create_blosc2_cparams(schunk_ptr& schunk, size_t nthreads, enums::codec codec, uint8_t compression_level, size_t block_size, enums::filter filter = enums::filter::shuffle, bool use_dict = false)
 		{
 			if (nthreads > std::numeric_limits<int16_t>::max())
 			{
 				throw std::out_of_range(std::format("Number of threads may not exceed {}, got {:L}", std::numeric_limits<int16_t>::max(), nthreads));
 			}
 			nthreads = std::max(nthreads, static_cast<size_t>(1));
+			validate_dict_codec(codec, use_dict);
 
 			assert(std::numeric_limits<int32_t>::max() > block_size);
 
@@ -330,19 +534,24 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			cparams.nthreads = static_cast<int16_t>(nthreads);
 			cparams.schunk = schunk.get();
 			cparams.compcode = codec_to_blosc2(codec);
+			cparams.use_dict = use_dict;
+			apply_filter<T>(cparams, filter);
 
 			return cparams;
 		}
 
 		/// Create blosc2 compression parameters for the given input.
+		///
+		/// `use_dict` enables zstd dictionary training, see the schunk-bound overload for the details.
 		template <typename T>
-		blosc2_cparams create_blosc2_cparams(size_t nthreads, enums::codec codec, uint8_t compression_level, size_t block_size)
+		blosc2_cparams create_blosc2_cparams(size_t nthreads, enums::codec codec, uint8_t compression_level, size_t block_size, enums::filter filter = enums::filter::shuffle, bool use_dict = false)
 		{
 			if (nthreads > std::numeric_limits<int16_t>::max())
 			{
 				throw std::out_of_range(std::format("Number of threads may not exceed {}, got {:L}", std::numeric_limits<int16_t>::max(), nthreads));
 			}
 			nthreads = std::max(nthreads, static_cast<size_t>(1));
+			validate_dict_codec(codec, use_dict);
 
 			assert(std::numeric_limits<int32_t>::max() > block_size);
 
@@ -354,26 +563,28 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			cparams.clevel = compression_level;
 			cparams.nthreads = static_cast<int16_t>(nthreads);
 			cparams.compcode = codec_to_blosc2(codec);
+			cparams.use_dict = use_dict;
+			apply_filter<T>(cparams, filter);
 
 			return cparams;
 		}
 
 		/// Create a blosc2 compression context with the given number of threads.
 		template <typename T>
-		blosc2::context_ptr create_compression_context(schunk_ptr& schunk, size_t nthreads, enums::codec codec, uint8_t compression_level, size_t block_size)
+		blosc2::context_ptr create_compression_context(schunk_ptr& schunk, size_t nthreads, enums::codec codec, uint8_t compression_level, size_t block_size, enums::filter filter = enums::filter::shuffle, bool use_dict = false)
 		{
 			_COMPRESSED_PROFILE_FUNCTION();
 			detail::init_filters();
-			auto cparams = create_blosc2_cparams<T>(schunk, nthreads, codec, compression_level, block_size);
+			auto cparams = create_blosc2_cparams<T>(schunk, nthreads, codec, compression_level, block_size, filter, use_dict);
 			return blosc2::context_ptr(blosc2_create_cctx(cparams));
 		}
 
 		template <typename T>
-		blosc2::context_ptr create_compression_context(size_t nthreads, enums::codec codec, uint8_t compression_level, size_t block_size)
+		blosc2::context_ptr create_compression_context(size_t nthreads, enums::codec codec, uint8_t compression_level, size_t block_size, enums::filter filter = enums::filter::shuffle, bool use_dict = false)
 		{
 			_COMPRESSED_PROFILE_FUNCTION();
 			detail::init_filters();
-			auto cparams = create_blosc2_cparams<T>(nthreads, codec, compression_level, block_size);
+			auto cparams = create_blosc2_cparams<T>(nthreads, codec, compression_level, block_size, filter, use_dict);
 			return blosc2::context_ptr(blosc2_create_cctx(cparams));
 		}
 
@@ -445,7 +656,7 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 		/// 
 		/// \throws std::runtime_error if we encounter a blosc2 error.
 		template <typename T>
-		size_t chunk_num_elements(const std::vector<std::byte>& chunk)
+		size_t chunk_num_elements(std::span<const std::byte> chunk)
 		{
 			int32_t nbytes{};
 			int32_t cbytes{};
@@ -467,6 +678,18 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			return static_cast<size_t>(nbytes) / sizeof(T);
 		}
 
+		/// Get the number of elements of the uncompressed chunk.
+		///
+		/// \tparam T the type to check against
+		/// \param chunk the compressed chunk to query
+		///
+		/// \throws std::runtime_error if we encounter a blosc2 error.
+		template <typename T>
+		size_t chunk_num_elements(const std::vector<std::byte>& chunk)
+		{
+			return chunk_num_elements<T>(std::span<const std::byte>(chunk.data(), chunk.size()));
+		}
+
 	} // namespace blosc2
 
 
@@ -1,12 +1,18 @@
 #pragma once
 
 #include <array>
+#include <cstring>
 #include <vector>
 #include <span>
 #include <memory>
 #include <optional>
 #include <limits>
 #include <execution>
+#include <functional>
+#include <mutex>
+#include <algorithm>
+#include <ranges>
+#include <variant>
 
 #include "blosc2.h"
 #include "nlohmann/json.hpp"
@@ -18,16 +24,33 @@
 #include "blosc2/typedefs.h"
 #include "blosc2/schunk.h"
 #include "blosc2/lazyschunk.h"
+#include "blosc2/context_pool.h"
 #include "constants.h"
 #include "util.h"
 #include "json_alias.h"
 #include "detail/scoped_timer.h"
+#include "detail/chunk_awaitable.h"
+#include "detail/chunk_cache.h"
+#include "detail/buffer_pool.h"
+#include "detail/thread_budget.h"
 #include "iterators/iterator.h"
 
 
 namespace NAMESPACE_COMPRESSED_IMAGE
 {
 
+	/// Statistics over a whole channel as computed by `channel<T>::statistics`.
+	template <typename T>
+	struct channel_statistics
+	{
+		T minimum{};
+		T maximum{};
+		double mean = 0.0;
+		/// Histogram over [minimum, maximum] with equally sized bins, empty unless requested.
+		std::vector<size_t> histogram{};
+	};
+
+
 	template <typename T>
 	struct channel : public std::ranges::view_interface<channel<T>>
 	{
@@ -39,12 +62,19 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 		{
 			m_Schunk = std::move(other.m_Schunk);
 			m_Codec = other.m_Codec;
-			m_Nthreads = other.m_Nthreads;			
+			m_Filter = other.m_Filter;
+			m_Nthreads = other.m_Nthreads;
 			m_CompressionContext = std::move(other.m_CompressionContext);
 			m_DecompressionContext = std::move(other.m_DecompressionContext);
 			m_CompressionLevel = other.m_CompressionLevel;
 			m_Width = other.m_Width;
 			m_Height = other.m_Height;
+			m_ChunkCache = std::move(other.m_ChunkCache);
+			m_ThreadBudgetToken = std::move(other.m_ThreadBudgetToken);
+			m_ShareToken = std::move(other.m_ShareToken);
+			m_PendingTransforms = std::move(other.m_PendingTransforms);
+			m_TileWidth = other.m_TileWidth;
+			m_TileHeight = other.m_TileHeight;
 		};
 		channel& operator=(channel&& other)
 		{
@@ -52,12 +82,19 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			{
 				m_Schunk = std::move(other.m_Schunk);
 				m_Codec = other.m_Codec;
+				m_Filter = other.m_Filter;
 				m_Nthreads = other.m_Nthreads;
 				m_CompressionContext = std::move(other.m_CompressionContext);
 				m_DecompressionContext = std::move(other.m_DecompressionContext);
 				m_CompressionLevel = other.m_CompressionLevel;
 				m_Width = other.m_Width;
 				m_Height = other.m_Height;
+				m_ChunkCache = std::move(other.m_ChunkCache);
+				m_ThreadBudgetToken = std::move(other.m_ThreadBudgetToken);
+				m_ShareToken = std::move(other.m_ShareToken);
+				m_PendingTransforms = std::move(other.m_PendingTransforms);
+				m_TileWidth = other.m_TileWidth;
+				m_TileHeight = other.m_TileHeight;
 			}
 			return *this;
 		};
@@ -71,13 +108,14 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 		channel()
 		{
 			m_Schunk = std::make_shared<blosc2::schunk_var<T>>(blosc2::lazy_schunk<T>(0, 1, s_default_blocksize, s_default_chunksize));
+			m_Nthreads = detail::shared_nthreads();
 			m_CompressionContext = blosc2::create_compression_context<T>(
-				std::thread::hardware_concurrency() / 2,
+				m_Nthreads,
 				enums::codec::lz4,
 				9,
 				s_default_blocksize
 			);
-			m_DecompressionContext = blosc2::create_decompression_context(std::thread::hardware_concurrency() / 2);
+			m_DecompressionContext = blosc2::create_decompression_context(m_Nthreads);
 		};
 
 		/// Initialize the channel with the given data.
@@ -94,6 +132,9 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 		///					  This should be tweaked to be no larger than the size of the usual images you are expecting  
 		///					  to compress for optimal performance but this could be upped which might give better compression
 		///					  ratios. Must be a multiple of sizeof(T).
+		/// \param compression_filter The pre-compression filter to apply, defaults to the generic byte
+		///							  shuffle. The half-float shuffle is only valid for 2-byte element types
+		///							  and pays off on 16-bit float data, see `enums::filter`.
 		channel(
 			const std::span<const T> data,
 			size_t width,
@@ -101,13 +142,15 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			enums::codec compression_codec = enums::codec::lz4,
 			uint8_t compression_level = 9,
 			size_t block_size = s_default_blocksize,
-			size_t chunk_size = s_default_chunksize
+			size_t chunk_size = s_default_chunksize,
+			enums::filter compression_filter = enums::filter::shuffle
 		)
 		{
 			_COMPRESSED_PROFILE_FUNCTION();
 			m_Width = width;
 			m_Height = height;
 			m_Codec = compression_codec;
+			m_Filter = compression_filter;
 			m_CompressionLevel = util::ensure_compression_level(compression_level);
 			if (data.size() != width * height)
 			{
@@ -124,12 +167,15 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			assert(chunk_size < std::numeric_limits<int32_t>::max());
 			assert(block_size < chunk_size);
 
-			m_CompressionContext = blosc2::create_compression_context<T>(std::thread::hardware_concurrency() / 2, m_Codec, m_CompressionLevel, block_size);
-			m_DecompressionContext = blosc2::create_decompression_context(std::thread::hardware_concurrency() / 2);
+			m_Nthreads = detail::shared_nthreads();
+			m_CompressionContext = blosc2::create_compression_context<T>(m_Nthreads, m_Codec, m_CompressionLevel, block_size, m_Filter);
+			m_DecompressionContext = blosc2::create_decompression_context(m_Nthreads);
 
 			// Align the chunks to the scanlines, makes our lifes a lot easier on read/write.
+			// The chunks are compressed in parallel with per-task pooled contexts, blosc2's
+			// intra-chunk threads alone don't saturate a wide machine on chunk-sized buffers.
 			auto chunk_size_aligned = util::align_chunk_to_scanlines_bytes<T>(m_Width, chunk_size);
-			m_Schunk = std::make_shared<blosc2::schunk_var<T>>(blosc2::schunk<T>(data, block_size, chunk_size_aligned, m_CompressionContext));
+			m_Schunk = std::make_shared<blosc2::schunk_var<T>>(blosc2::schunk<T>(data, block_size, chunk_size_aligned, m_Codec, m_CompressionLevel, m_Filter));
 		}
 
 
@@ -159,32 +205,19 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			m_Codec = compression_codec;
 			m_CompressionLevel = util::ensure_compression_level(compression_level);
 
-			if (std::holds_alternative<blosc2::schunk<T>>(schunk))
-			{
-				if (std::get<blosc2::schunk<T>>(schunk).size() != width * height)
-				{
-					throw std::invalid_argument(
-						std::format(
-							"Invalid schunk passed to compressed::channel constructor. Expected a size of {:L} but instead got {:L}",
-							width * height,
-							std::get<blosc2::schunk<T>>(schunk).size()
-						)
-					);
-				}
-			}
-			else if (std::holds_alternative<blosc2::lazy_schunk<T>>(schunk))
-			{
-				if (std::get<blosc2::lazy_schunk<T>>(schunk).size() != width * height)
+			std::visit([&](auto& _schunk)
 				{
-					throw std::invalid_argument(
-						std::format(
-							"Invalid schunk passed to compressed::channel constructor. Expected a size of {:L} but instead got {:L}",
-							width * height,
-							std::get<blosc2::schunk<T>>(schunk).size()
-						)
-					);
-				}
-			}
+					if (_schunk.size() != width * height)
+					{
+						throw std::invalid_argument(
+							std::format(
+								"Invalid schunk passed to compressed::channel constructor. Expected a size of {:L} but instead got {:L}",
+								width * height,
+								_schunk.size()
+							)
+						);
+					}
+				}, schunk);
 
 			m_Schunk = std::make_shared<blosc2::schunk_var<T>>(std::move(schunk));
 			m_Width = width;
@@ -192,10 +225,11 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 
 			// Store the compression and decompression contexts, retrieving the block size from the underlying schunk
 			// wrapper
+			m_Nthreads = detail::shared_nthreads();
 			std::visit([&](auto& schunk)
 				{
-					m_CompressionContext = blosc2::create_compression_context<T>(std::thread::hardware_concurrency() / 2, m_Codec, m_CompressionLevel, schunk.max_block_size());
-					m_DecompressionContext = blosc2::create_decompression_context(std::thread::hardware_concurrency() / 2);
+					m_CompressionContext = blosc2::create_compression_context<T>(m_Nthreads, m_Codec, m_CompressionLevel, schunk.max_block_size());
+					m_DecompressionContext = blosc2::create_decompression_context(m_Nthreads);
 				}, *m_Schunk);
 			
 		}
@@ -303,12 +337,179 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			);
 		}
 
+		/// \brief Create a channel storing its chunks as 2D tiles instead of scanline strips.
+		///
+		/// With the default scanline-strip layout a small region of interest on a very wide image
+		/// touches every chunk in its y-range, decoding far more data than requested. With the
+		/// tiled layout every chunk holds one `tile_width` x `tile_height` tile (row-major tile
+		/// order), so ROI reads via `get_roi` only decode the tiles they actually intersect.
+		///
+		/// The tile dimensions must evenly divide the channel dimensions as blosc2 requires all
+		/// chunks barring the last to be equally sized, clipped edge tiles would violate that.
+		///
+		/// The layout is an in-memory property: iterating a tiled channel hands out tiles instead
+		/// of strips (see `container::chunk_span<T>::tiled`), the scanline-based `get_roi`
+		/// overload rejects it and `image<T>::save` does not support it yet.
+		///
+		/// \param data The span of input data to be compressed, in regular scanline order.
+		/// \param width The width of the image channel, must be a multiple of `tile_width`.
+		/// \param height The height of the image channel, must be a multiple of `tile_height`.
+		/// \param tile_width The width of a tile in pixels (default 512).
+		/// \param tile_height The height of a tile in pixels (default 512).
+		/// \param compression_codec The compression codec to be used (default is lz4).
+		/// \param compression_level The compression level (default is 9).
+		/// \param block_size The size of the blocks stored inside the chunks.
+		///
+		/// \return A channel with one chunk per tile.
+		/// \throws std::invalid_argument if the data size or tile dimensions are invalid.
+		static channel tiled(
+			const std::span<const T> data,
+			size_t width,
+			size_t height,
+			size_t tile_width = 512,
+			size_t tile_height = 512,
+			enums::codec compression_codec = enums::codec::lz4,
+			uint8_t compression_level = 9,
+			size_t block_size = s_default_blocksize
+		)
+		{
+			_COMPRESSED_PROFILE_FUNCTION();
+			if (data.size() != width * height)
+			{
+				throw std::invalid_argument(
+					std::format(
+						"Invalid channel data passed. Expected its size to match up to width * height ({} * {}) which would be {:L}."
+						" Instead received {:L}",
+						width, height, width * height, data.size()
+					)
+				);
+			}
+			if (tile_width == 0 || tile_height == 0 || width % tile_width != 0 || height % tile_height != 0)
+			{
+				throw std::invalid_argument(
+					std::format(
+						"Invalid tile dimensions [{} x {}] for a channel of [{} x {}]. The tile dimensions must be non-zero"
+						" and evenly divide the channel dimensions as blosc2 requires all chunks barring the last to be"
+						" equally sized.",
+						tile_width, tile_height, width, height
+					)
+				);
+			}
+
+			const size_t tile_elems = tile_width * tile_height;
+			const size_t tile_bytes = tile_elems * sizeof(T);
+			assert(tile_bytes < std::numeric_limits<int32_t>::max());
+			assert(block_size < tile_bytes);
+
+			channel result;
+			result.m_Width = width;
+			result.m_Height = height;
+			result.m_TileWidth = tile_width;
+			result.m_TileHeight = tile_height;
+			result.m_Codec = compression_codec;
+			result.m_CompressionLevel = util::ensure_compression_level(compression_level);
+			result.m_Nthreads = detail::shared_nthreads();
+			result.m_CompressionContext = blosc2::create_compression_context<T>(
+				result.m_Nthreads, result.m_Codec, result.m_CompressionLevel, block_size
+			);
+			result.m_DecompressionContext = blosc2::create_decompression_context(result.m_Nthreads);
+
+			// Gather each tile into scanline order within the tile and compress it as one chunk,
+			// row-major in tile units.
+			auto schunk = blosc2::schunk<T>(block_size, tile_bytes);
+			util::default_init_vector<T> tile_buffer(tile_elems);
+			util::default_init_vector<std::byte> compression_buffer(blosc2::min_compressed_size(tile_bytes));
+			for (auto tile_y : std::views::iota(size_t{ 0 }, height / tile_height))
+			{
+				for (auto tile_x : std::views::iota(size_t{ 0 }, width / tile_width))
+				{
+					for (auto row : std::views::iota(size_t{ 0 }, tile_height))
+					{
+						std::memcpy(
+							tile_buffer.data() + row * tile_width,
+							data.data() + (tile_y * tile_height + row) * width + tile_x * tile_width,
+							tile_width * sizeof(T)
+						);
+					}
+					schunk.append_chunk(
+						result.m_CompressionContext,
+						std::span<T>(tile_buffer.data(), tile_buffer.size()),
+						std::span<std::byte>(compression_buffer)
+					);
+				}
+			}
+			result.m_Schunk = std::make_shared<blosc2::schunk_var<T>>(std::move(schunk));
+			return result;
+		}
+
+		/// Whether this channel stores its chunks as 2D tiles rather than scanline strips, see `tiled`.
+		bool is_tiled() const noexcept { return m_TileWidth != 0 && m_TileHeight != 0; }
+
+		/// The tile width of the tiled chunk layout, 0 for the scanline-strip layout.
+		size_t tile_width() const noexcept { return m_TileWidth; }
+
+		/// The tile height of the tiled chunk layout, 0 for the scanline-strip layout.
+		size_t tile_height() const noexcept { return m_TileHeight; }
+
+		/// The number of tiles along the x axis, 0 for the scanline-strip layout.
+		size_t num_tiles_x() const noexcept { return this->is_tiled() ? m_Width / m_TileWidth : 0; }
+
+		/// The number of tiles along the y axis, 0 for the scanline-strip layout.
+		size_t num_tiles_y() const noexcept { return this->is_tiled() ? m_Height / m_TileHeight : 0; }
+
 		/// Returns an iterator pointing to the beginning of the compressed data.
 		///
 		/// \return An iterator to the beginning of the compressed data.
 		iterator begin()
 		{
-			return iterator(m_Schunk, m_CompressionContext.get(), m_DecompressionContext.get(), 0, m_Width, m_Height);
+			// Iterators recompress chunks in place as they advance, a partially walked range would
+			// bake the queued lazy transforms (see `map`) into only some chunks -- materialize them
+			// up front instead so every chunk agrees.
+			this->bake_transforms();
+			{
+				// Iterators write chunks back in place, a shared view has to detach first.
+				std::lock_guard<std::mutex> lock(m_WriteMutex);
+				this->detach_if_shared();
+			}
+			return iterator(
+				m_Schunk, 0, m_Width, m_Height,
+				m_Codec, m_CompressionLevel, this->block_size(), m_Filter,
+				m_TileWidth, m_TileHeight, m_Nthreads
+			);
+		}
+
+		/// Returns an iterator to the beginning of the compressed data with background prefetching enabled.
+		///
+		/// Identical to `begin()` except that dereferencing chunk N additionally starts decompressing chunk N+1
+		/// on a worker thread, hiding the decode latency for sequential streaming passes. Compares equal against
+		/// the regular `end()` iterator. See `channel_iterator<T>::prefetch` for the trade-offs.
+		///
+		/// \return A prefetching iterator to the beginning of the compressed data.
+		iterator async_begin()
+		{
+			auto it = this->begin();
+			it.prefetch(true);
+			return it;
+		}
+
+		/// Returns a read-only iterator pointing to the beginning of the compressed data.
+		///
+		/// Unlike the mutable `begin()` the returned iterator never recompresses: dereferencing only
+		/// decodes, so pure scans pay no codec work on advance at all. Writes into the dereferenced
+		/// view are silently dropped. Transforms queued through `map` are fused into each decode
+		/// rather than baked into storage, the channel stays untouched throughout.
+		///
+		/// \return A read-only iterator to the beginning of the compressed data.
+		iterator begin() const
+		{
+			auto it = iterator(
+				m_Schunk, 0, m_Width, m_Height,
+				m_Codec, m_CompressionLevel, this->block_size(), m_Filter,
+				m_TileWidth, m_TileHeight, m_Nthreads
+			);
+			it.read_only(true);
+			it.transforms(m_PendingTransforms);
+			return it;
 		}
 
 		/// Returns an iterator pointing to the end of the compressed data.
@@ -320,12 +521,58 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			{
 				return std::visit([&](auto& schunk)
 					{
-						return iterator(m_Schunk, m_CompressionContext.get(), m_DecompressionContext.get(), schunk.num_chunks(), m_Width, m_Height);
+						return iterator(
+							m_Schunk, schunk.num_chunks(), m_Width, m_Height,
+							m_Codec, m_CompressionLevel, this->block_size(), m_Filter,
+							m_TileWidth, m_TileHeight, m_Nthreads
+						);
+					}, *m_Schunk);
+			}
+			throw std::runtime_error("Internal Error: Unable to create end iterator as m_Schunk is uninitialized.");
+		}
+
+		/// Returns a read-only iterator pointing to the end of the compressed data, compares equal
+		/// against iterators from the read-only `begin()`.
+		///
+		/// \return A read-only iterator to the end of the compressed data.
+		iterator end() const
+		{
+			if (m_Schunk)
+			{
+				return std::visit([&](auto& schunk)
+					{
+						auto it = iterator(
+							m_Schunk, schunk.num_chunks(), m_Width, m_Height,
+							m_Codec, m_CompressionLevel, this->block_size(), m_Filter,
+							m_TileWidth, m_TileHeight, m_Nthreads
+						);
+						it.read_only(true);
+						return it;
 					}, *m_Schunk);
 			}
 			throw std::runtime_error("Internal Error: Unable to create end iterator as m_Schunk is uninitialized.");
 		}
 
+		/// Returns a `std::ranges`-compatible random-access range over the chunks of the channel.
+		///
+		/// The `channel_iterator<T>` is random-access so the range can be partitioned, sliced
+		/// (`std::views::drop`/`take`) or handed to standard algorithms without paying a decode per
+		/// skipped chunk, only dereferencing decompresses. See `channel_iterator<T>` for the
+		/// concurrency guarantees when processing partitions of the range on multiple threads.
+		///
+		/// \return A `std::ranges::subrange` equivalent to [begin(), end()).
+		auto chunks()
+		{
+			return std::ranges::subrange(this->begin(), this->end());
+		}
+
+		/// Returns a read-only `std::ranges`-compatible range over the chunks of the channel,
+		/// see the read-only `begin()` for the semantics.
+		auto chunks() const
+		{
+			return std::ranges::subrange(this->begin(), this->end());
+		}
+
 		/// Retrieve a view to the compression context. In most cases users will not have to modify this.
 		///
 		/// \return A pointer to the compression context.
@@ -342,7 +589,7 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 		/// \param block_size The block size to compress to
 		void update_nthreads(size_t nthreads, size_t block_size = s_default_blocksize)
 		{
-			m_CompressionContext = blosc2::create_compression_context<T>(nthreads, m_Codec, m_CompressionLevel, block_size);
+			m_CompressionContext = blosc2::create_compression_context<T>(nthreads, m_Codec, m_CompressionLevel, block_size, m_Filter);
 			m_DecompressionContext = blosc2::create_decompression_context(nthreads);
 			m_Nthreads = nthreads;
 		}
@@ -362,6 +609,11 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 		/// \return The compression codec.
 		enums::codec compression() const noexcept { return m_Codec; }
 
+		/// Retrieve the pre-compression filter used.
+		///
+		/// \return The pre-compression filter, see `enums::filter`.
+		enums::filter compression_filter() const noexcept { return m_Filter; }
+
 		/// Retrieve the compression level used.
 		///
 		/// \return The compression level (typically from 1-9).
@@ -380,15 +632,10 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 				throw std::runtime_error("Channel instance is not properly initialized, unable to get decompressed data");
 			}
 
-			if (std::holds_alternative<blosc2::schunk<T>>(*m_Schunk))
-			{
-				return std::get<blosc2::schunk<T>>(*m_Schunk).csize();
-			}
-			else if (std::holds_alternative<blosc2::lazy_schunk<T>>(*m_Schunk))
-			{
-				return std::get<blosc2::lazy_schunk<T>>(*m_Schunk).csize();
-			}
-			return {};
+			return std::visit([](const auto& schunk)
+				{
+					return schunk.csize();
+				}, *m_Schunk);
 		}
 		
 		/// Retrieve the uncompressed data size.
@@ -401,15 +648,10 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 				throw std::runtime_error("Channel instance is not properly initialized, unable to get decompressed data");
 			}
 
-			if (std::holds_alternative<blosc2::schunk<T>>(*m_Schunk))
-			{
-				return std::get<blosc2::schunk<T>>(*m_Schunk).size();
-			}
-			else if (std::holds_alternative<blosc2::lazy_schunk<T>>(*m_Schunk))
-			{
-				return std::get<blosc2::lazy_schunk<T>>(*m_Schunk).size();
-			}
-			return {};
+			return std::visit([](const auto& schunk)
+				{
+					return schunk.size();
+				}, *m_Schunk);
 		}
 		
 		/// Retrieve the total number of chunks the channel stores.
@@ -419,15 +661,10 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 		{ 
 			assert(m_Schunk != nullptr);
 
-			if (std::holds_alternative<blosc2::schunk<T>>(*m_Schunk))
-			{
-				return std::get<blosc2::schunk<T>>(*m_Schunk).num_chunks();
-			}
-			else if (std::holds_alternative<blosc2::lazy_schunk<T>>(*m_Schunk))
-			{
-				return std::get<blosc2::lazy_schunk<T>>(*m_Schunk).num_chunks();
-			}
-			return {};
+			return this->dispatch_schunk([](const auto& schunk)
+				{
+					return schunk.num_chunks();
+				});
 		}
 
 		/// \brief Retrieve the block size (in bytes) of the channel
@@ -439,10 +676,10 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 		size_t block_size() const
 		{
 			assert(m_Schunk != nullptr);
-			return std::visit([&](auto& schunk)
+			return this->dispatch_schunk([&](auto& schunk)
 				{
 					return schunk.max_block_size();
-				}, *m_Schunk);
+				});
 		}
 
 		/// \brief Retrieve the chunk size (in bytes) of the channel
@@ -454,10 +691,10 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 		size_t chunk_size() const noexcept
 		{
 			assert(m_Schunk != nullptr);
-			return std::visit([&](auto& schunk)
+			return this->dispatch_schunk([&](auto& schunk)
 				{
 					return schunk.chunk_bytes();
-				}, *m_Schunk);
+				});
 		}
 
 		size_t chunk_elems() const
@@ -475,10 +712,10 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 		size_t chunk_size(size_t chunk_index) const
 		{
 			assert(m_Schunk != nullptr);
-			return std::visit([&](auto& schunk)
+			return this->dispatch_schunk([&](auto& schunk)
 				{
 					return schunk.chunk_bytes(chunk_index);
-				}, *m_Schunk);
+				});
 		}
 
 		size_t chunk_elems(size_t chunk_index) const
@@ -488,6 +725,22 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			return chunk_size / sizeof(T);
 		}
 
+		/// \brief Retrieve a const reference to the underlying super-chunk variant.
+		///
+		/// Allows direct (read-only) access to the compressed storage, e.g. for serializing the
+		/// compressed chunks as-is without a decompress-recompress roundtrip.
+		///
+		/// \return The super-chunk variant held by this channel.
+		/// \throws std::runtime_error if the channel is not properly initialized.
+		const blosc2::schunk_var<T>& schunk() const
+		{
+			if (!m_Schunk)
+			{
+				throw std::runtime_error("Channel instance is not properly initialized, unable to get the underlying schunk");
+			}
+			return *m_Schunk;
+		}
+
 
 		/// Retrieves and decompresses a chunk of data into the provided buffer.
 		///
@@ -506,81 +759,1550 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 				throw std::runtime_error("Internal Error: Channel instance is not properly initialized, unable to get decompressed data");
 			}
 
-			return std::visit([&](const auto& schunk)
+			// Serve hot chunks straight from the cache (if one was set up with `cache_budget`), skipping
+			// the blosc2 decompression entirely.
+			if (m_ChunkCache && m_ChunkCache->try_get(buffer, chunk_idx))
+			{
+				this->apply_transforms(buffer.first(this->chunk_elems(chunk_idx)));
+				return;
+			}
+
+			this->dispatch_schunk([&](const auto& schunk)
 				{
-					// We cheat a little bit here by creating this compression ctx on the fly, unfortunately this is 
-					// necessary as blosc2 will actually modify the ctx on decompression.
-					auto decomp_ctx = blosc2::create_decompression_context(m_Nthreads);
-					return schunk.chunk(decomp_ctx, buffer, chunk_idx);
-				}, *m_Schunk);
+					// blosc2 modifies contexts on decompression so m_DecompressionContext cannot be
+					// shared across concurrent calls, lease an exclusive one from the pool instead.
+					auto decomp_ctx = blosc2::global_context_pool().checkout_decompression(m_Nthreads);
+					schunk.chunk(decomp_ctx.ctx(), buffer, chunk_idx);
+				});
+
+			if (m_ChunkCache)
+			{
+				auto fitted = std::span<const T>(buffer.data(), this->chunk_elems(chunk_idx));
+				m_ChunkCache->insert(fitted, chunk_idx);
+			}
+			// The cache stores the raw decoded bytes, the lazy transform queue (see `map`) is fused
+			// in afterwards so cached chunks and freshly decoded ones see it exactly once.
+			this->apply_transforms(buffer.first(this->chunk_elems(chunk_idx)));
 		}
 
-		/// Compresses and sets a chunk of data from the provided buffer at the specified index.
+		/// Retrieve and decompress a chunk asynchronously, returning a `co_await`-able handle.
 		///
-		/// This function compresses the data in the provided buffer using the current compression
-		/// context and writes it into the internal `schunk` at the given index.
+		/// Awaiting the returned object suspends the calling coroutine, runs the decode on a
+		/// worker thread through the regular `get_chunk` path (sharing the chunk cache, lazy
+		/// transforms and the codec admission scheduler with the synchronous API) and resumes
+		/// the coroutine with a `container::chunk_span<T>` over the filled buffer. This lets
+		/// e.g. a UI thread keep many decodes in flight without blocking a thread per chunk.
 		///
-		/// \param buffer A span representing the source data to be compressed and stored.
-		/// \param chunk_idx The index of the chunk to overwrite or set with the compressed data.
+		/// Example:
+		/// \code{.cpp}
+		/// std::vector<float> buffer(channel.chunk_elems(chunk_idx));
+		/// auto chunk = co_await channel.get_chunk_async(std::span<float>(buffer), chunk_idx);
+		/// \endcode
+		///
+		/// The coroutine is resumed on the worker thread; rescheduling back onto a particular
+		/// executor is up to the caller. The channel and the buffer must outlive the await.
+		///
+		/// \param buffer A span representing the destination buffer to store the decompressed data.
+		///               Must be large enough to hold the chunk at `chunk_idx`.
+		/// \param chunk_idx The index of the chunk to retrieve.
 		///
+		/// \return An awaitable resuming the caller with the filled chunk span.
+		///
+		/// \throws std::out_of_range if the chunk index is invalid.
+		/// \throws std::invalid_argument if the buffer is too small for the chunk.
 		/// \throws std::runtime_error if the internal `schunk` pointer is not initialized.
-		void set_chunk(std::span<T> buffer, size_t chunk_idx)
+		detail::chunk_decode_awaitable<T> get_chunk_async(std::span<T> buffer, size_t chunk_idx) const
 		{
 			if (!m_Schunk)
 			{
-				throw std::runtime_error("Internal Error: Channel instance is not properly initialized, unable to set data");
+				throw std::runtime_error("Internal Error: Channel instance is not properly initialized, unable to get decompressed data");
 			}
 
-			return std::visit([&](auto& schunk)
-				{
-					return schunk.set_chunk(m_CompressionContext, buffer, chunk_idx);
-				}, *m_Schunk);
+			// Validate eagerly so parameter errors surface at the call site rather than from
+			// inside the resumed coroutine, only decode failures travel through the await.
+			const size_t num_elements = this->chunk_elems(chunk_idx);
+			if (buffer.size() < num_elements)
+			{
+				throw std::invalid_argument(
+					std::format(
+						"Buffer passed to get_chunk_async is too small, expected at least {:L} elements but instead got {:L}",
+						num_elements, buffer.size()
+					)
+				);
+			}
+
+			auto result = container::chunk_span<T>(
+				buffer.first(num_elements), m_Width, m_Height, chunk_idx, this->chunk_size(), m_TileWidth, m_TileHeight
+			);
+			return detail::chunk_decode_awaitable<T>(*this, buffer, result);
 		}
 
-		/// Get the decompressed data as a vector.
+		/// Decompress only the scanline range [y_begin, y_end) into the provided buffer.
 		///
-		/// \throws std::runtime_error if the internal `schunk` pointer is not initialized.
-		/// 
-		/// \return A vector containing the decompressed data.
-		std::vector<T> get_decompressed() const
+		/// Since the chunks are scanline-aligned the mapping from a y-range to chunk indices is pure
+		/// arithmetic, so only the chunks intersecting the range are touched at all. Within the edge
+		/// chunks blosc2 partial decompression is used so a small strip does not pay for decoding a
+		/// full chunk either, making e.g. a 16-scanline grade read only the blocks it actually needs.
+		///
+		/// \param y_begin The first scanline to decompress (inclusive).
+		/// \param y_end The scanline to stop at (exclusive).
+		/// \param buffer The destination buffer, must hold at least (y_end - y_begin) * width() elements.
+		///
+		/// \throws std::out_of_range if the scanline range is empty or exceeds the channel height.
+		/// \throws std::invalid_argument if the buffer is too small for the requested range.
+		/// \throws std::runtime_error if the internal `schunk` pointer is not initialized, the chunks
+		///							   are not scanline-aligned or the channel uses the tiled layout.
+		void get_roi(size_t y_begin, size_t y_end, std::span<T> buffer) const
 		{
+			_COMPRESSED_PROFILE_FUNCTION();
 			if (!m_Schunk)
 			{
 				throw std::runtime_error("Internal Error: Channel instance is not properly initialized, unable to get decompressed data");
 			}
-			return std::visit([&](const auto& schunk)
+			if (this->is_tiled())
+			{
+				throw std::runtime_error(
+					"Unable to decompress a scanline range on a channel with the tiled chunk layout, use the"
+					" [x_begin, x_end) x [y_begin, y_end) overload of get_roi instead"
+				);
+			}
+			if (y_begin >= y_end || y_end > m_Height)
+			{
+				throw std::out_of_range(
+					std::format(
+						"Invalid scanline range [{}, {}) requested, expected a non-empty range within [0, {})",
+						y_begin, y_end, m_Height
+					)
+				);
+			}
+			const size_t num_elements = (y_end - y_begin) * m_Width;
+			if (buffer.size() < num_elements)
+			{
+				throw std::invalid_argument(
+					std::format(
+						"Unable to decompress scanline range [{}, {}) into buffer as the buffer needs to at least"
+						" have the size {:L}. Instead got {:L}", y_begin, y_end, num_elements, buffer.size()
+					)
+				);
+			}
+			if (this->chunk_elems() % m_Width != 0)
+			{
+				throw std::runtime_error(
+					std::format(
+						"Unable to decompress a scanline range as the chunks are not scanline-aligned."
+						" Chunk element count {:L} is not a multiple of the channel width {:L}",
+						this->chunk_elems(), m_Width
+					)
+				);
+			}
+
+			const size_t scanlines_per_chunk = this->chunk_elems() / m_Width;
+			const size_t chunk_begin = y_begin / scanlines_per_chunk;
+			const size_t chunk_end = (y_end + scanlines_per_chunk - 1) / scanlines_per_chunk;
+
+			// blosc2 modifies contexts on decompression so m_DecompressionContext cannot be
+			// shared across concurrent calls, lease an exclusive one from the pool instead.
+			auto decomp_ctx = blosc2::global_context_pool().checkout_decompression(m_Nthreads);
+			std::visit([&](const auto& schunk)
 				{
-					// We cheat a little bit here by creating this compression ctx on the fly, unfortunately this is 
-					// necessary as blosc2 will actually modify the ctx on decompression.
-					auto decomp_ctx = blosc2::create_decompression_context(m_Nthreads);
-					return schunk.to_uncompressed(decomp_ctx);
+					for (auto chunk_idx : std::views::iota(chunk_begin, chunk_end))
+					{
+						const size_t chunk_y_begin = chunk_idx * scanlines_per_chunk;
+						const size_t chunk_y_end = chunk_y_begin + schunk.chunk_elements(chunk_idx) / m_Width;
+
+						const size_t isect_begin = std::max(y_begin, chunk_y_begin);
+						const size_t isect_end = std::min(y_end, chunk_y_end);
+
+						const size_t element_offset = (isect_begin - chunk_y_begin) * m_Width;
+						const size_t isect_elements = (isect_end - isect_begin) * m_Width;
+						auto dst = buffer.subspan((isect_begin - y_begin) * m_Width, isect_elements);
+
+						schunk.chunk(decomp_ctx.get(), dst, chunk_idx, element_offset, isect_elements);
+					}
 				}, *m_Schunk);
+			this->apply_transforms(buffer.first(num_elements));
 		}
 
-		/// Equality operators, compares pointers to check for equality
-		bool operator==(const channel<T>& other) const noexcept
+		/// Decompress only the rectangular region [x_begin, x_end) x [y_begin, y_end) into the provided buffer.
+		///
+		/// On a channel with the tiled chunk layout (see `tiled`) only the tiles intersecting the
+		/// rectangle are decoded, so a small ROI on a very wide image no longer pays for every chunk
+		/// in its y-range. On the default scanline-strip layout each requested row segment is read
+		/// with blosc2 partial decompression instead.
+		///
+		/// The buffer is filled tightly, i.e. with a row pitch of (x_end - x_begin) elements.
+		///
+		/// \param x_begin The first column to decompress (inclusive).
+		/// \param x_end The column to stop at (exclusive).
+		/// \param y_begin The first scanline to decompress (inclusive).
+		/// \param y_end The scanline to stop at (exclusive).
+		/// \param buffer The destination buffer, must hold at least (x_end - x_begin) * (y_end - y_begin) elements.
+		///
+		/// \throws std::out_of_range if the rectangle is empty or exceeds the channel dimensions.
+		/// \throws std::invalid_argument if the buffer is too small for the requested rectangle.
+		/// \throws std::runtime_error if the internal `schunk` pointer is not initialized or a
+		///							   scanline-strip channel's chunks are not scanline-aligned.
+		void get_roi(size_t x_begin, size_t x_end, size_t y_begin, size_t y_end, std::span<T> buffer) const
 		{
-			return this == &other;
-		}
+			_COMPRESSED_PROFILE_FUNCTION();
+			if (!m_Schunk)
+			{
+				throw std::runtime_error("Internal Error: Channel instance is not properly initialized, unable to get decompressed data");
+			}
+			if (x_begin >= x_end || x_end > m_Width || y_begin >= y_end || y_end > m_Height)
+			{
+				throw std::out_of_range(
+					std::format(
+						"Invalid region [{}, {}) x [{}, {}) requested, expected a non-empty rectangle within"
+						" [0, {}) x [0, {})",
+						x_begin, x_end, y_begin, y_end, m_Width, m_Height
+					)
+				);
+			}
+			const size_t roi_width = x_end - x_begin;
+			const size_t num_elements = roi_width * (y_end - y_begin);
+			if (buffer.size() < num_elements)
+			{
+				throw std::invalid_argument(
+					std::format(
+						"Unable to decompress region [{}, {}) x [{}, {}) into buffer as the buffer needs to at least"
+						" have the size {:L}. Instead got {:L}", x_begin, x_end, y_begin, y_end, num_elements, buffer.size()
+					)
+				);
+			}
 
-	private:
-		/// The storage for the internal data, stored contiguously in a compressed data format
-		blosc2::schunk_var_ptr<T> m_Schunk = nullptr;
-		enums::codec m_Codec = enums::codec::lz4;
+			if (!this->is_tiled())
+			{
+				if (this->chunk_elems() % m_Width != 0)
+				{
+					throw std::runtime_error(
+						std::format(
+							"Unable to decompress a region as the chunks are not scanline-aligned."
+							" Chunk element count {:L} is not a multiple of the channel width {:L}",
+							this->chunk_elems(), m_Width
+						)
+					);
+				}
+
+				// Scanline strips: partially decompress exactly the requested segment of each row.
+				const size_t scanlines_per_chunk = this->chunk_elems() / m_Width;
+				auto decomp_ctx = blosc2::global_context_pool().checkout_decompression(m_Nthreads);
+				std::visit([&](const auto& schunk)
+					{
+						for (auto y : std::views::iota(y_begin, y_end))
+						{
+							const size_t chunk_idx = y / scanlines_per_chunk;
+							const size_t element_offset = (y % scanlines_per_chunk) * m_Width + x_begin;
+							auto dst = buffer.subspan((y - y_begin) * roi_width, roi_width);
+							schunk.chunk(decomp_ctx.get(), dst, chunk_idx, element_offset, roi_width);
+						}
+					}, *m_Schunk);
+				this->apply_transforms(buffer.first(num_elements));
+				return;
+			}
 
-		size_t m_Nthreads = std::thread::hardware_concurrency() / 2;
+			// Tiled layout: decode each intersecting tile once and copy out the overlapping row
+			// segments, all other tiles stay untouched.
+			const size_t tile_x_begin = x_begin / m_TileWidth;
+			const size_t tile_x_end = (x_end + m_TileWidth - 1) / m_TileWidth;
+			const size_t tile_y_begin = y_begin / m_TileHeight;
+			const size_t tile_y_end = (y_end + m_TileHeight - 1) / m_TileHeight;
 
-		/// We store a compression and decompression context here to allow us to reuse them rather than having
-		/// to reinitialize them on launch. May be nullptr;
-		blosc2::context_ptr m_CompressionContext = nullptr;
-		blosc2::context_ptr m_DecompressionContext = nullptr;
+			util::default_init_vector<T> tile_buffer(m_TileWidth * m_TileHeight);
+			auto decomp_ctx = blosc2::global_context_pool().checkout_decompression(m_Nthreads);
+			std::visit([&](const auto& schunk)
+				{
+					for (auto tile_y : std::views::iota(tile_y_begin, tile_y_end))
+					{
+						for (auto tile_x : std::views::iota(tile_x_begin, tile_x_end))
+						{
+							const size_t chunk_idx = tile_y * this->num_tiles_x() + tile_x;
+							schunk.chunk(decomp_ctx.ctx(), std::span<T>(tile_buffer.data(), tile_buffer.size()), chunk_idx);
 
-		/// Compression level.
-		uint8_t m_CompressionLevel = 9;
+							const size_t isect_x_begin = std::max(x_begin, tile_x * m_TileWidth);
+							const size_t isect_x_end = std::min(x_end, (tile_x + 1) * m_TileWidth);
+							const size_t isect_y_begin = std::max(y_begin, tile_y * m_TileHeight);
+							const size_t isect_y_end = std::min(y_end, (tile_y + 1) * m_TileHeight);
 
-		/// The width and height of the channel.
-		size_t m_Width = 1;
-		size_t m_Height = 1;
+							for (auto y : std::views::iota(isect_y_begin, isect_y_end))
+							{
+								std::memcpy(
+									buffer.data() + (y - y_begin) * roi_width + (isect_x_begin - x_begin),
+									tile_buffer.data() + (y - tile_y * m_TileHeight) * m_TileWidth + (isect_x_begin - tile_x * m_TileWidth),
+									(isect_x_end - isect_x_begin) * sizeof(T)
+								);
+							}
+						}
+					}
+				}, *m_Schunk);
+			this->apply_transforms(buffer.first(num_elements));
+		}
+
+		/// Retrieves and decompresses the tile at the given tile coordinates into the provided buffer.
+		///
+		/// The tile is stored in scanline order within the tile, i.e. `tile_width()` elements per row.
+		/// Only valid on channels constructed through the `tiled` factory.
+		///
+		/// \param tile_x The X coordinate of the tile in tile units.
+		/// \param tile_y The Y coordinate of the tile in tile units.
+		/// \param buffer The destination buffer, must hold at least tile_width() * tile_height() elements.
+		///
+		/// \throws std::out_of_range if the tile coordinates are outside the tile grid.
+		/// \throws std::runtime_error if the channel does not use the tiled chunk layout.
+		void get_tile(size_t tile_x, size_t tile_y, std::span<T> buffer) const
+		{
+			if (!this->is_tiled())
+			{
+				throw std::runtime_error("Unable to get a tile from a channel with the default scanline-strip chunk layout");
+			}
+			if (tile_x >= this->num_tiles_x() || tile_y >= this->num_tiles_y())
+			{
+				throw std::out_of_range(
+					std::format(
+						"Invalid tile coordinates [{}, {}] requested, the channel holds a grid of {} x {} tiles",
+						tile_x, tile_y, this->num_tiles_x(), this->num_tiles_y()
+					)
+				);
+			}
+			this->get_chunk(buffer, tile_y * this->num_tiles_x() + tile_x);
+		}
+
+		/// Compresses and sets a chunk of data from the provided buffer at the specified index.
+		///
+		/// This function compresses the data in the provided buffer and writes it into the internal
+		/// `schunk` at the given index.
+		///
+		/// Safe to call concurrently from multiple threads as long as no two threads write the same
+		/// chunk index, e.g. render workers committing buckets into one compressed channel. The
+		/// compression itself runs on a context leased exclusively from the global pool, only the
+		/// publication of the compressed bytes into the super-chunk is serialized.
+		///
+		/// \param buffer A span representing the source data to be compressed and stored.
+		/// \param chunk_idx The index of the chunk to overwrite or set with the compressed data.
+		///
+		/// \throws std::runtime_error if the internal `schunk` pointer is not initialized.
+		void set_chunk(std::span<T> buffer, size_t chunk_idx)
+		{
+			if (!m_Schunk)
+			{
+				throw std::runtime_error("Internal Error: Channel instance is not properly initialized, unable to set data");
+			}
+			// Queued lazy transforms (see `map`) apply to the data as it was when they were
+			// recorded, materialize them first so they don't retroactively touch this write.
+			this->bake_transforms();
+
+			// Compress outside the lock, blosc2 modifies contexts on use so m_CompressionContext
+			// cannot be shared across concurrent calls. This is the expensive part, serializing
+			// only the publication below lets N writers scale at the codec level.
+			auto compression_ctx = blosc2::global_context_pool().checkout_compression<T>(
+				m_Nthreads, m_Codec, m_CompressionLevel, this->block_size(), m_Filter
+			);
+			util::default_init_vector<std::byte> compressed(blosc2::min_compressed_size(this->chunk_size()));
+			auto csize = blosc2::compress<T>(compression_ctx.ctx(), buffer, std::span<std::byte>(compressed));
+
+			if (m_ChunkCache)
+			{
+				m_ChunkCache->invalidate(chunk_idx);
+			}
+
+			std::lock_guard<std::mutex> lock(m_WriteMutex);
+			this->detach_if_shared();
+			this->dispatch_schunk([&](auto& schunk)
+				{
+					schunk.set_chunk(std::span<const std::byte>(compressed.data(), csize), chunk_idx);
+					if (schunk.track_chunk_stats())
+					{
+						schunk.record_chunk_statistics(chunk_idx, std::span<const T>(buffer.begin(), buffer.end()));
+					}
+				});
+		}
+
+		/// \brief Set the byte budget for the decompressed-chunk cache, enabling or disabling it.
+		///
+		/// By default every call to `get_chunk` pays a full blosc2 decompression. With a cache budget
+		/// set, decompressed chunks are kept around in an LRU cache (bounded by the budget) and repeated
+		/// access to the same chunks is served from plain memory instead. Entries are invalidated when
+		/// the corresponding chunk is overwritten with `set_chunk`.
+		///
+		/// \param byte_budget The maximum number of bytes of decompressed chunk data to keep around.
+		///						Passing 0 disables (and drops) the cache.
+		void cache_budget(size_t byte_budget)
+		{
+			if (byte_budget == 0)
+			{
+				m_ChunkCache = nullptr;
+				return;
+			}
+
+			if (m_ChunkCache)
+			{
+				m_ChunkCache->byte_budget(byte_budget);
+			}
+			else
+			{
+				m_ChunkCache = std::make_shared<detail::chunk_cache<T>>(byte_budget);
+			}
+		}
+
+		/// \brief Retrieve the byte budget of the decompressed-chunk cache, 0 if the cache is disabled.
+		size_t cache_budget() const noexcept
+		{
+			return m_ChunkCache ? m_ChunkCache->byte_budget() : 0;
+		}
+
+		/// \brief Attach a buffer pool that compressed chunk storage is recycled through.
+		///
+		/// With a pool attached, `set_chunk` and the iterator's recompress cycle reuse buffers from
+		/// the pool instead of allocating a fresh heap vector per chunk, avoiding heap fragmentation
+		/// and malloc contention when many chunks are rewritten. The same pool may be shared across
+		/// multiple channels (see `image<T>::buffer_pool`). Passing nullptr detaches the pool.
+		///
+		/// \param pool The pool to attach, nullptr to restore plain heap allocation.
+		void buffer_pool(std::shared_ptr<detail::byte_buffer_pool> pool)
+		{
+			assert(m_Schunk != nullptr);
+			std::visit([&](auto& schunk)
+				{
+					schunk.buffer_pool(std::move(pool));
+				}, *m_Schunk);
+		}
+
+		/// \brief Retrieve the attached chunk buffer pool, nullptr if none is attached.
+		std::shared_ptr<detail::byte_buffer_pool> buffer_pool() const
+		{
+			assert(m_Schunk != nullptr);
+			return std::visit([](const auto& schunk)
+				{
+					return schunk.buffer_pool();
+				}, *m_Schunk);
+		}
+
+		/// Create a deep copy of the channel by cloning the compressed chunks directly.
+		///
+		/// The copy constructor is deleted on purpose to keep accidental copies of potentially
+		/// gigabytes of data out of hot paths, `clone()` is the explicit opt-in. The compressed
+		/// chunks are copied byte-for-byte and fresh contexts are created, so the cost is
+		/// O(compressed size) with zero codec work -- no decode/encode cycle like going through
+		/// `get_decompressed()` and reconstruction would incur.
+		///
+		/// An mmap-backed channel clones into regular heap-backed storage as the spill file is
+		/// exclusively owned. The clone starts without a chunk cache or buffer pool attached.
+		///
+		/// \return A channel owning an independent copy of the compressed data.
+		/// \throws std::runtime_error if the internal `schunk` pointer is not initialized.
+		channel clone() const
+		{
+			_COMPRESSED_PROFILE_FUNCTION();
+			if (!m_Schunk)
+			{
+				throw std::runtime_error("Internal Error: Channel instance is not properly initialized, unable to clone");
+			}
+
+			auto copy_channel = std::visit([&](const auto& schunk) -> channel
+				{
+					using schunk_t = std::remove_cvref_t<decltype(schunk)>;
+					if constexpr (std::is_same_v<schunk_t, blosc2::mmap_schunk<T>>)
+					{
+						// The spill file is exclusively owned so the compressed chunks are copied
+						// out of the mapping into a heap-backed schunk instead.
+						auto copy = blosc2::schunk<T>(schunk.max_block_size(), schunk.max_chunk_size());
+						for (auto chunk_idx : std::views::iota(size_t{ 0 }, schunk.num_chunks()))
+						{
+							auto compressed = schunk.compressed_chunk(chunk_idx);
+							copy.append_chunk(std::vector<std::byte>(compressed.begin(), compressed.end()));
+						}
+						return channel(blosc2::schunk_var<T>(std::move(copy)), m_Width, m_Height, m_Codec, m_CompressionLevel);
+					}
+					else
+					{
+						auto copy = schunk;
+						copy.buffer_pool(nullptr);
+						return channel(blosc2::schunk_var<T>(std::move(copy)), m_Width, m_Height, m_Codec, m_CompressionLevel);
+					}
+				}, *m_Schunk);
+			// Queued lazy transforms are part of the logical content the clone copies.
+			copy_channel.m_PendingTransforms = m_PendingTransforms;
+			return copy_channel;
+		}
+
+		/// \brief Create a cheap copy-on-write view of this channel.
+		///
+		/// The returned channel aliases the same compressed storage, so creating it is O(1) no
+		/// matter the channel size and fan-out pipelines can hand one channel to several stages
+		/// without duplicating compressed data (compare `clone()` which copies every chunk up
+		/// front). The first holder to mutate -- `set_chunk`, the mutable `for_each_chunk`,
+		/// `flip_vertical`, `crop_y`, `deduplicate` or iteration through `begin()` -- detaches
+		/// onto its own copy of the compressed chunks first, the other holders keep seeing the
+		/// data exactly as it was when the view was created.
+		///
+		/// The view shares this channel's compression settings but starts without a chunk cache
+		/// or buffer pool attached.
+		///
+		/// \return A channel sharing this channel's compressed storage until either side mutates.
+		/// \throws std::runtime_error if the internal `schunk` pointer is not initialized.
+		channel share() const
+		{
+			if (!m_Schunk)
+			{
+				throw std::runtime_error("Internal Error: Channel instance is not properly initialized, unable to share");
+			}
+
+			channel view;
+			view.m_Schunk = m_Schunk;
+			view.m_ShareToken = m_ShareToken;
+			view.m_Width = m_Width;
+			view.m_Height = m_Height;
+			view.m_TileWidth = m_TileWidth;
+			view.m_TileHeight = m_TileHeight;
+			view.m_Codec = m_Codec;
+			view.m_Filter = m_Filter;
+			view.m_CompressionLevel = m_CompressionLevel;
+			view.m_Nthreads = m_Nthreads;
+			// Queued lazy transforms are part of the logical content the view snapshots.
+			view.m_PendingTransforms = m_PendingTransforms;
+			view.m_CompressionContext = blosc2::create_compression_context<T>(
+				m_Nthreads, m_Codec, m_CompressionLevel, this->block_size(), m_Filter
+			);
+			view.m_DecompressionContext = blosc2::create_decompression_context(m_Nthreads);
+			return view;
+		}
+
+		/// Whether this channel currently shares its compressed storage with views created through
+		/// `share()`. Turns false again as soon as any holder mutates and detaches.
+		bool shares_storage() const noexcept
+		{
+			return m_ShareToken.use_count() > 1;
+		}
+
+		/// \brief Move the channel's chunks into a content-addressed store shared with other channels.
+		///
+		/// Converts heap-backed storage into a `blosc2::dedup_schunk<T>` whose chunks are interned
+		/// into `store` by a hash of their compressed bytes, so chunks that compress to identical
+		/// bytes -- within this channel or across all channels sharing the store -- are stored once
+		/// and refcounted. Modifications stay safe through copy-on-write, `set_chunk` replaces the
+		/// shared reference instead of touching the shared bytes. Usually called through
+		/// `image<T>::deduplicate_chunks()` which shares one store across all channels.
+		///
+		/// Lazy and mmap-backed channels are left untouched: lazy chunks already collapse constant
+		/// regions to a single value and the spill file backing an mmap channel is exclusively owned.
+		///
+		/// \param store The content-addressed store to intern the chunks into.
+		///
+		/// \return The number of compressed bytes saved by deduplication within this channel, 0 if
+		///         the channel was left untouched. Savings against chunks other channels interned
+		///         into `store` are not visible from a single channel, compare the channels' total
+		///         `compressed_bytes()` against `store->total_bytes()` for the cross-channel view.
+		size_t deduplicate(std::shared_ptr<blosc2::detail::chunk_store> store)
+		{
+			_COMPRESSED_PROFILE_FUNCTION();
+			assert(m_Schunk != nullptr);
+			std::lock_guard<std::mutex> lock(m_WriteMutex);
+			this->detach_if_shared();
+
+			auto* direct = std::get_if<blosc2::schunk<T>>(m_Schunk.get());
+			if (!direct)
+			{
+				return 0;
+			}
+
+			const size_t before = direct->csize();
+			auto deduplicated = blosc2::dedup_schunk<T>(*direct, std::move(store));
+			const size_t after = deduplicated.csize();
+			*m_Schunk = blosc2::schunk_var<T>(std::move(deduplicated));
+
+			if (m_ChunkCache)
+			{
+				m_ChunkCache->clear();
+			}
+			return before - after;
+		}
+
+		/// \brief Pack the channel's compressed chunks into one contiguous allocation.
+		///
+		/// Converts heap-backed storage into a `blosc2::frame_schunk<T>` where all compressed
+		/// chunks live back-to-back in a single payload: better locality when iterating, one
+		/// `write()` to persist and a zero-copy handoff of the whole compressed stream through
+		/// `contiguous_payload()`. The conversion copies the compressed bytes once, no codec work.
+		///
+		/// Chunk overwrites on frame-backed storage shift the payload tail when the compressed
+		/// size changes, so convert once the heavy mutation is done. Lazy, mmap-backed and
+		/// deduplicated channels are left untouched.
+		///
+		/// \return True if the channel is frame-backed after the call (including if it already was).
+		bool make_contiguous()
+		{
+			_COMPRESSED_PROFILE_FUNCTION();
+			assert(m_Schunk != nullptr);
+			std::lock_guard<std::mutex> lock(m_WriteMutex);
+			this->detach_if_shared();
+
+			if (std::holds_alternative<blosc2::frame_schunk<T>>(*m_Schunk))
+			{
+				return true;
+			}
+			auto* direct = std::get_if<blosc2::schunk<T>>(m_Schunk.get());
+			if (!direct)
+			{
+				return false;
+			}
+
+			*m_Schunk = blosc2::schunk_var<T>(blosc2::frame_schunk<T>(*direct));
+			if (m_ChunkCache)
+			{
+				m_ChunkCache->clear();
+			}
+			return true;
+		}
+
+		/// \brief Retrieve a view over the contiguous compressed payload of a frame-backed channel.
+		///
+		/// All chunks back-to-back in index order, suitable for handing to a `write()` or the
+		/// network stack without copying. Only valid for channels converted with
+		/// `make_contiguous()` and only until the next mutation.
+		///
+		/// \return A span over the whole compressed payload.
+		/// \throws std::runtime_error if the channel is not frame-backed.
+		std::span<const std::byte> contiguous_payload() const
+		{
+			assert(m_Schunk != nullptr);
+			auto* frame = std::get_if<blosc2::frame_schunk<T>>(m_Schunk.get());
+			if (!frame)
+			{
+				throw std::runtime_error(
+					"Unable to retrieve the contiguous payload of a channel that is not frame-backed,"
+					" call make_contiguous() first"
+				);
+			}
+			return frame->payload();
+		}
+
+		/// \brief Flip the channel vertically, working on compressed chunks wherever possible.
+		///
+		/// The strategy is picked by chunk layout:
+		/// - One scanline per chunk: the flip is pure chunk reordering in the compressed domain,
+		///   no codec work at all.
+		/// - Scanline-aligned chunks evenly dividing the height: mirrored chunk pairs are decoded,
+		///   their scanlines reversed and published swapped. The pairs are independent so they are
+		///   processed in parallel with pooled per-chunk contexts, and only the pair currently in
+		///   flight is ever held uncompressed.
+		/// - Anything else (tiled layouts, a partial last chunk): the channel decodes once, the
+		///   rows are reversed and the chunks rebuilt with the same compression parameters.
+		///
+		/// \throws std::runtime_error if the internal `schunk` pointer is not initialized.
+		void flip_vertical()
+		{
+			_COMPRESSED_PROFILE_FUNCTION();
+			if (!m_Schunk)
+			{
+				throw std::runtime_error("Internal Error: Channel instance is not properly initialized, unable to flip");
+			}
+			if (m_Height <= 1)
+			{
+				return;
+			}
+			// The fast paths below move compressed chunks without decoding while others re-encode,
+			// materialize the queued lazy transforms (see `map`) first so every chunk agrees.
+			this->bake_transforms();
+			{
+				std::lock_guard<std::mutex> lock(m_WriteMutex);
+				this->detach_if_shared();
+			}
+
+			const bool scanline_aligned = !this->is_tiled() && this->chunk_elems() % m_Width == 0;
+			const size_t rows_per_chunk = scanline_aligned ? this->chunk_elems() / m_Width : 0;
+
+			// One scanline per chunk: reversing the chunk order is the whole flip, the compressed
+			// bytes are copied straight over without touching a codec.
+			if (rows_per_chunk == 1)
+			{
+				if (auto* direct = std::get_if<blosc2::schunk<T>>(m_Schunk.get()))
+				{
+					std::lock_guard<std::mutex> lock(m_WriteMutex);
+					auto flipped = blosc2::schunk<T>(direct->max_block_size(), direct->max_chunk_size());
+					for (auto chunk_idx : std::views::iota(size_t{ 0 }, direct->num_chunks()) | std::views::reverse)
+					{
+						const auto& compressed = direct->compressed_chunk(chunk_idx);
+						flipped.append_chunk(std::vector<std::byte>(compressed.begin(), compressed.end()));
+					}
+					*m_Schunk = blosc2::schunk_var<T>(std::move(flipped));
+					if (m_ChunkCache)
+					{
+						m_ChunkCache->clear();
+					}
+					return;
+				}
+			}
+
+			// Full chunks mirror onto each other: chunk i and chunk n-1-i swap places with their
+			// scanlines reversed, each pair independent of the rest.
+			if (rows_per_chunk > 0 && m_Height % rows_per_chunk == 0)
+			{
+				const auto block_size = this->block_size();
+				const size_t num_chunks = this->num_chunks();
+				auto indices = std::views::iota(size_t{ 0 }, (num_chunks + 1) / 2);
+				std::for_each(std::execution::par, indices.begin(), indices.end(), [&](size_t front_idx)
+					{
+						const size_t back_idx = num_chunks - 1 - front_idx;
+
+						util::default_init_vector<T> front(this->chunk_elems());
+						auto front_span = std::span<T>(front.data(), front.size());
+						this->get_chunk(front_span, front_idx);
+						reverse_scanlines(front_span, m_Width);
+
+						util::default_init_vector<T> back;
+						std::span<T> back_span;
+						if (back_idx != front_idx)
+						{
+							back = util::default_init_vector<T>(this->chunk_elems());
+							back_span = std::span<T>(back.data(), back.size());
+							this->get_chunk(back_span, back_idx);
+							reverse_scanlines(back_span, m_Width);
+						}
+
+						// Compress with a per-pair single-threaded context leased from the pool and
+						// publish the swapped chunks under the channel-wide write mutex, mirroring
+						// the `for_each_chunk` concurrency idiom.
+						auto compression_ctx = blosc2::global_context_pool().checkout_compression<T>(1, m_Codec, m_CompressionLevel, block_size, m_Filter);
+						util::default_init_vector<std::byte> front_compressed(blosc2::min_compressed_size(this->chunk_size()));
+						auto front_csize = blosc2::compress<T>(compression_ctx.ctx(), front_span, std::span<std::byte>(front_compressed));
+
+						size_t back_csize = 0;
+						util::default_init_vector<std::byte> back_compressed;
+						if (back_idx != front_idx)
+						{
+							back_compressed = util::default_init_vector<std::byte>(blosc2::min_compressed_size(this->chunk_size()));
+							back_csize = blosc2::compress<T>(compression_ctx.ctx(), back_span, std::span<std::byte>(back_compressed));
+						}
+
+						if (m_ChunkCache)
+						{
+							m_ChunkCache->invalidate(front_idx);
+							m_ChunkCache->invalidate(back_idx);
+						}
+
+						std::lock_guard<std::mutex> lock(m_WriteMutex);
+						std::visit([&](auto& schunk)
+							{
+								schunk.set_chunk(std::span<const std::byte>(front_compressed.data(), front_csize), back_idx);
+								if (back_idx != front_idx)
+								{
+									schunk.set_chunk(std::span<const std::byte>(back_compressed.data(), back_csize), front_idx);
+								}
+							}, *m_Schunk);
+					});
+				return;
+			}
+
+			// Fallback: decode once, reverse the rows and rebuild.
+			auto data = this->get_decompressed();
+			reverse_scanlines(std::span<T>(data.data(), data.size()), m_Width);
+			this->rebuild_from_buffer(std::span<const T>(data.data(), data.size()), m_Height);
+		}
+
+		/// \brief Crop the channel to the scanline range [y_begin, y_end).
+		///
+		/// When the chunks are scanline-aligned and `y_begin` falls on a chunk boundary the crop
+		/// happens in the compressed domain: leading and trailing chunks are dropped without any
+		/// codec work and only a partially-kept boundary chunk at the bottom is re-encoded. Any
+		/// other layout (tiled channels, an unaligned `y_begin`) decodes once and rebuilds the
+		/// kept rows; a tiled channel whose tile grid no longer divides the cropped height is
+		/// rebuilt with the scanline-strip layout.
+		///
+		/// \param y_begin The first scanline to keep.
+		/// \param y_end One past the last scanline to keep, must be greater than `y_begin` and at
+		///              most the channel height.
+		///
+		/// \throws std::invalid_argument if the scanline range is not valid.
+		/// \throws std::runtime_error if the internal `schunk` pointer is not initialized.
+		void crop_y(size_t y_begin, size_t y_end)
+		{
+			_COMPRESSED_PROFILE_FUNCTION();
+			if (!m_Schunk)
+			{
+				throw std::runtime_error("Internal Error: Channel instance is not properly initialized, unable to crop");
+			}
+			if (y_end <= y_begin || y_end > m_Height)
+			{
+				throw std::invalid_argument(
+					std::format(
+						"Invalid crop range [{}, {}) for a channel of height {}. The range must be non-empty and"
+						" lie within the channel.",
+						y_begin, y_end, m_Height
+					)
+				);
+			}
+			if (y_begin == 0 && y_end == m_Height)
+			{
+				return;
+			}
+			// The chunk-drop fast path keeps compressed chunks verbatim while the boundary chunk is
+			// re-encoded, materialize the queued lazy transforms (see `map`) first so every chunk agrees.
+			this->bake_transforms();
+			{
+				std::lock_guard<std::mutex> lock(m_WriteMutex);
+				this->detach_if_shared();
+			}
+
+			const size_t new_height = y_end - y_begin;
+			const bool scanline_aligned = !this->is_tiled() && this->chunk_elems() % m_Width == 0;
+			const size_t rows_per_chunk = scanline_aligned ? this->chunk_elems() / m_Width : 0;
+
+			if (rows_per_chunk > 0 && y_begin % rows_per_chunk == 0)
+			{
+				if (auto* direct = std::get_if<blosc2::schunk<T>>(m_Schunk.get()))
+				{
+					auto cropped = blosc2::schunk<T>(direct->max_block_size(), direct->max_chunk_size());
+					size_t rows_remaining = new_height;
+					size_t chunk_idx = y_begin / rows_per_chunk;
+					while (rows_remaining > 0)
+					{
+						const size_t chunk_rows = direct->chunk_elements(chunk_idx) / m_Width;
+						if (chunk_rows <= rows_remaining)
+						{
+							// Fully kept, the compressed bytes are copied straight over.
+							const auto& compressed = direct->compressed_chunk(chunk_idx);
+							cropped.append_chunk(std::vector<std::byte>(compressed.begin(), compressed.end()));
+							rows_remaining -= chunk_rows;
+						}
+						else
+						{
+							// Boundary chunk at the bottom of the crop: only the kept scanlines are
+							// re-encoded, everything before came over without codec work.
+							util::default_init_vector<T> decoded(direct->chunk_elements(chunk_idx));
+							this->get_chunk(std::span<T>(decoded.data(), decoded.size()), chunk_idx);
+
+							auto compression_ctx = blosc2::create_compression_context<T>(
+								m_Nthreads, m_Codec, m_CompressionLevel, this->block_size(), m_Filter
+							);
+							cropped.append_chunk(compression_ctx, std::span<T>(decoded.data(), rows_remaining * m_Width));
+							rows_remaining = 0;
+						}
+						++chunk_idx;
+					}
+
+					std::lock_guard<std::mutex> lock(m_WriteMutex);
+					m_Height = new_height;
+					*m_Schunk = blosc2::schunk_var<T>(std::move(cropped));
+					if (m_ChunkCache)
+					{
+						m_ChunkCache->clear();
+					}
+					return;
+				}
+			}
+
+			// Fallback: decode once and rebuild from the kept rows.
+			auto data = this->get_decompressed();
+			this->rebuild_from_buffer(
+				std::span<const T>(data.data() + y_begin * m_Width, new_height * m_Width),
+				new_height
+			);
+		}
+
+		/// \brief Enable or disable recording of per-chunk min/max/sum at compression time.
+		///
+		/// With tracking enabled every chunk (re)compressed from uncompressed data (e.g. via
+		/// `set_chunk` or the iterator's recompress cycle) additionally records its minimum,
+		/// maximum and sum. Once all chunks carry recorded statistics, `statistics()` answers
+		/// min/max/mean in O(num_chunks) without decompressing anything. Disabling drops the
+		/// recorded statistics.
+		void track_chunk_statistics(bool enabled)
+		{
+			assert(m_Schunk != nullptr);
+			std::visit([&](auto& schunk)
+				{
+					schunk.track_chunk_stats(enabled);
+				}, *m_Schunk);
+		}
+
+		/// \brief Whether per-chunk statistics are recorded at compression time.
+		bool track_chunk_statistics() const
+		{
+			assert(m_Schunk != nullptr);
+			return std::visit([](const auto& schunk)
+				{
+					return schunk.track_chunk_stats();
+				}, *m_Schunk);
+		}
+
+		/// Compute min/max/mean (and optionally a histogram) over the channel without a full decode.
+		///
+		/// The chunks are walked one at a time reusing a single scratch buffer (like iterating the
+		/// channel does) so peak memory stays at one chunk rather than the whole channel. If every
+		/// chunk carries statistics recorded at compression time (see `track_chunk_statistics`)
+		/// min/max/mean are combined from those in O(num_chunks) without any decompression at all.
+		///
+		/// The histogram spans [minimum, maximum] with equally sized bins and requires one walk over
+		/// the chunks, so requesting it on a channel without recorded statistics decodes every chunk
+		/// twice (once to establish the range, once to bin).
+		///
+		/// \param num_bins The number of histogram bins to compute, 0 skips the histogram.
+		/// \return The computed statistics, the histogram is empty if `num_bins` is 0.
+		/// \throws std::runtime_error if the internal `schunk` pointer is not initialized.
+		channel_statistics<T> statistics(size_t num_bins = 0) const
+		{
+			_COMPRESSED_PROFILE_FUNCTION();
+			if (!m_Schunk)
+			{
+				throw std::runtime_error("Internal Error: Channel instance is not properly initialized, unable to compute statistics");
+			}
+
+			channel_statistics<T> result{};
+			std::visit([&](const auto& schunk)
+				{
+					const size_t total_elements = schunk.size();
+					if (total_elements == 0)
+					{
+						return;
+					}
+
+					// Combine the per-chunk statistics recorded at compression time if every chunk
+					// has them, skipping the decode entirely.
+					bool all_recorded = true;
+					double sum = 0.0;
+					bool first = true;
+					for (auto chunk_idx : std::views::iota(size_t{ 0 }, schunk.num_chunks()))
+					{
+						auto stats = schunk.chunk_stats_at(chunk_idx);
+						if (!stats)
+						{
+							all_recorded = false;
+							break;
+						}
+						result.minimum = first ? stats->minimum : std::min(result.minimum, stats->minimum);
+						result.maximum = first ? stats->maximum : std::max(result.maximum, stats->maximum);
+						sum += stats->sum;
+						first = false;
+					}
+
+					util::default_init_vector<T> buffer(schunk.chunk_elements());
+					auto decomp_ctx = blosc2::global_context_pool().checkout_decompression(m_Nthreads);
+
+					if (!all_recorded)
+					{
+						// Streaming reduction pass, one chunk at a time through the scratch buffer.
+						sum = 0.0;
+						first = true;
+						for (auto chunk_idx : std::views::iota(size_t{ 0 }, schunk.num_chunks()))
+						{
+							auto fitted = std::span<T>(buffer.data(), schunk.chunk_elements(chunk_idx));
+							schunk.chunk(decomp_ctx.get(), fitted, chunk_idx);
+							for (const auto& value : fitted)
+							{
+								result.minimum = first ? value : std::min(result.minimum, value);
+								result.maximum = first ? value : std::max(result.maximum, value);
+								sum += static_cast<double>(value);
+								first = false;
+							}
+						}
+					}
+					result.mean = sum / static_cast<double>(total_elements);
+
+					if (num_bins == 0)
+					{
+						return;
+					}
+
+					// Histogram pass over [minimum, maximum], the range had to be established first.
+					result.histogram.resize(num_bins);
+					const double range = static_cast<double>(result.maximum) - static_cast<double>(result.minimum);
+					for (auto chunk_idx : std::views::iota(size_t{ 0 }, schunk.num_chunks()))
+					{
+						auto fitted = std::span<T>(buffer.data(), schunk.chunk_elements(chunk_idx));
+						schunk.chunk(decomp_ctx.get(), fitted, chunk_idx);
+						for (const auto& value : fitted)
+						{
+							size_t bin = 0;
+							if (range > 0.0)
+							{
+								auto normalized = (static_cast<double>(value) - static_cast<double>(result.minimum)) / range;
+								bin = std::min(static_cast<size_t>(normalized * static_cast<double>(num_bins)), num_bins - 1);
+							}
+							++result.histogram[bin];
+						}
+					}
+				}, *m_Schunk);
+			return result;
+		}
+
+		/// \brief Collect machine-readable compression statistics for the channel.
+		///
+		/// Unlike `statistics()` -- which is about the pixel values -- this describes the
+		/// compressed storage itself: byte counts, ratio, codec and the per-chunk breakdown,
+		/// so telemetry can rank channels by footprint or flag incompressible ones for
+		/// re-encoding with a cheaper codec. Computing it only walks the chunk headers,
+		/// nothing is decompressed.
+		///
+		/// On a lazily-stored channel (see `zeros`/`full`) chunks that were never materialized
+		/// report `"lazy": true` with a footprint of sizeof(T), as the lazy representation
+		/// only stores the fill value.
+		///
+		/// \return The statistics as json, e.g.:
+		/// \code{.json}
+		/// {
+		///		"width": 2048, "height": 2048,
+		///		"layout": "scanline", "storage": "schunk",
+		///		"codec": "lz4", "compression_level": 9, "filter": "shuffle",
+		///		"num_chunks": 2, "num_lazy_chunks": 0,
+		///		"compressed_bytes": 164532, "uncompressed_bytes": 4194304,
+		///		"compression_ratio": 25.49,
+		///		"chunks": [ { "index": 0, "compressed_bytes": ..., "uncompressed_bytes": ..., "compression_ratio": ..., "lazy": false }, ... ]
+		/// }
+		/// \endcode
+		///
+		/// \throws std::runtime_error if the internal `schunk` pointer is not initialized.
+		json_ordered compression_statistics() const
+		{
+			_COMPRESSED_PROFILE_FUNCTION();
+			if (!m_Schunk)
+			{
+				throw std::runtime_error("Internal Error: Channel instance is not properly initialized, unable to compute statistics");
+			}
+
+			json_ordered stats{};
+			stats["width"] = m_Width;
+			stats["height"] = m_Height;
+			stats["layout"] = this->is_tiled() ? "tiled" : "scanline";
+			if (this->is_tiled())
+			{
+				stats["tile_width"] = m_TileWidth;
+				stats["tile_height"] = m_TileHeight;
+			}
+
+			size_t num_lazy_chunks = 0;
+			auto chunks = json_ordered::array();
+			std::visit([&](const auto& schunk)
+				{
+					using schunk_type = std::decay_t<decltype(schunk)>;
+					if constexpr (std::is_same_v<schunk_type, blosc2::schunk<T>>)
+					{
+						stats["storage"] = "schunk";
+					}
+					else if constexpr (std::is_same_v<schunk_type, blosc2::lazy_schunk<T>>)
+					{
+						stats["storage"] = "lazy_schunk";
+					}
+					else if constexpr (std::is_same_v<schunk_type, blosc2::dedup_schunk<T>>)
+					{
+						stats["storage"] = "dedup_schunk";
+					}
+					else if constexpr (std::is_same_v<schunk_type, blosc2::frame_schunk<T>>)
+					{
+						stats["storage"] = "frame_schunk";
+					}
+					else
+					{
+						stats["storage"] = "mmap_schunk";
+					}
+
+					for (auto chunk_idx : std::views::iota(size_t{ 0 }, schunk.num_chunks()))
+					{
+						const size_t uncompressed = schunk.chunk_bytes(chunk_idx);
+						size_t compressed = 0;
+						bool lazy = false;
+						if constexpr (std::is_same_v<schunk_type, blosc2::lazy_schunk<T>>)
+						{
+							lazy = schunk.is_lazy(chunk_idx);
+							compressed = lazy ? sizeof(T) : schunk.compressed_chunk(chunk_idx).size();
+							num_lazy_chunks += lazy ? 1 : 0;
+						}
+						else
+						{
+							compressed = schunk.compressed_chunk(chunk_idx).size();
+						}
+
+						json_ordered chunk_stats{};
+						chunk_stats["index"] = chunk_idx;
+						chunk_stats["compressed_bytes"] = compressed;
+						chunk_stats["uncompressed_bytes"] = uncompressed;
+						chunk_stats["compression_ratio"] = compressed > 0
+							? static_cast<double>(uncompressed) / static_cast<double>(compressed)
+							: 0.0;
+						chunk_stats["lazy"] = lazy;
+						chunks.push_back(std::move(chunk_stats));
+					}
+				}, *m_Schunk);
+
+			stats["codec"] = std::string(enums::to_string(m_Codec));
+			stats["compression_level"] = m_CompressionLevel;
+			stats["filter"] = std::string(enums::to_string(m_Filter));
+			stats["num_chunks"] = this->num_chunks();
+			stats["num_lazy_chunks"] = num_lazy_chunks;
+
+			const size_t compressed = this->compressed_bytes();
+			// uncompressed_size() counts elements, the stats report actual bytes.
+			const size_t uncompressed = this->uncompressed_size() * sizeof(T);
+			stats["compressed_bytes"] = compressed;
+			stats["uncompressed_bytes"] = uncompressed;
+			stats["compression_ratio"] = compressed > 0
+				? static_cast<double>(uncompressed) / static_cast<double>(compressed)
+				: 0.0;
+			stats["chunks"] = std::move(chunks);
+			return stats;
+		}
+
+		/// Get the decompressed data as a vector.
+		///
+		/// The result is always in scanline order, on a channel with the tiled chunk layout the
+		/// tiles are scattered back into their scanline positions.
+		///
+		/// \throws std::runtime_error if the internal `schunk` pointer is not initialized.
+		///
+		/// \return A vector containing the decompressed data.
+		std::vector<T> get_decompressed() const
+		{
+			if (!m_Schunk)
+			{
+				throw std::runtime_error("Internal Error: Channel instance is not properly initialized, unable to get decompressed data");
+			}
+			if (this->is_tiled())
+			{
+				auto result = std::vector<T>(m_Width * m_Height);
+				this->get_roi(size_t{ 0 }, m_Width, size_t{ 0 }, m_Height, std::span<T>(result));
+				return result;
+			}
+			auto result = std::visit([&](const auto& schunk)
+				{
+					// blosc2 modifies contexts on decompression so m_DecompressionContext cannot be
+					// shared across concurrent calls, lease an exclusive one from the pool instead.
+					auto decomp_ctx = blosc2::global_context_pool().checkout_decompression(m_Nthreads);
+					return schunk.to_uncompressed(decomp_ctx.ctx());
+				}, *m_Schunk);
+			this->apply_transforms(std::span<T>(result));
+			return result;
+		}
+
+		/// Decompress the whole channel into a caller-provided buffer, chunks in parallel.
+		///
+		/// Every chunk writes to a disjoint region of `buffer` so the chunks are decoded with
+		/// `std::execution::par` rather than the sequential loop of the allocating overload,
+		/// turning a full-channel decode into a memory-bandwidth-bound operation. Combined with
+		/// a reused caller buffer this also skips the per-call allocation entirely.
+		///
+		/// The result is always in scanline order, on a channel with the tiled chunk layout the
+		/// tiles are scattered back into their scanline positions.
+		///
+		/// \param buffer The destination buffer, must hold at least width() * height() elements.
+		///
+		/// \throws std::runtime_error if the internal `schunk` pointer is not initialized.
+		/// \throws std::invalid_argument if the buffer is too small for the channel.
+		void get_decompressed(std::span<T> buffer) const
+		{
+			_COMPRESSED_PROFILE_FUNCTION();
+			if (!m_Schunk)
+			{
+				throw std::runtime_error("Internal Error: Channel instance is not properly initialized, unable to get decompressed data");
+			}
+			const size_t num_elements = m_Width * m_Height;
+			if (buffer.size() < num_elements)
+			{
+				throw std::invalid_argument(
+					std::format(
+						"Unable to decompress channel into buffer as the buffer needs to at least have the size {:L}."
+						" Instead got {:L}", num_elements, buffer.size()
+					)
+				);
+			}
+
+			if (this->is_tiled())
+			{
+				// Each tile is one chunk, decode it into per-thread scratch and scatter the rows
+				// back into their scanline positions, the destination regions are disjoint.
+				auto indices = std::views::iota(size_t{ 0 }, this->num_chunks());
+				std::for_each(std::execution::par, indices.begin(), indices.end(), [&](size_t chunk_idx)
+					{
+						util::default_init_vector<T> tile_buffer(m_TileWidth * m_TileHeight);
+						auto tile_span = std::span<T>(tile_buffer.data(), tile_buffer.size());
+						this->get_chunk(tile_span, chunk_idx);
+
+						const size_t tile_x = chunk_idx % this->num_tiles_x();
+						const size_t tile_y = chunk_idx / this->num_tiles_x();
+						for (auto row : std::views::iota(size_t{ 0 }, m_TileHeight))
+						{
+							std::memcpy(
+								buffer.data() + (tile_y * m_TileHeight + row) * m_Width + tile_x * m_TileWidth,
+								tile_buffer.data() + row * m_TileWidth,
+								m_TileWidth * sizeof(T)
+							);
+						}
+					});
+				return;
+			}
+
+			// Scanline strips are laid out back to back so each chunk decodes straight into its
+			// slice of the destination, no scratch or copy involved.
+			const size_t elems_per_chunk = this->chunk_elems();
+			auto indices = std::views::iota(size_t{ 0 }, this->num_chunks());
+			std::for_each(std::execution::par, indices.begin(), indices.end(), [&](size_t chunk_idx)
+				{
+					auto dst = buffer.subspan(chunk_idx * elems_per_chunk, this->chunk_elems(chunk_idx));
+					this->get_chunk(dst, chunk_idx);
+				});
+		}
+
+		/// Apply `func` to every chunk of the channel, decompressing, applying the functor and recompressing.
+		///
+		/// Unlike iterating the channel with `begin()`/`end()` -- which owns a single pair of compression and
+		/// decompression buffers and therefore has to run strictly sequentially -- this processes the chunks
+		/// according to the passed execution policy with per-chunk scratch buffers and contexts. Since the
+		/// chunks are independent this scales with the number of cores at the chunk level. The blosc2 contexts
+		/// used internally are single-threaded as the parallelism already comes from the chunk level.
+		///
+		/// The functor receives a `container::chunk_span<T>` just like dereferencing a `channel_iterator` would.
+		/// Writes back into the super-chunk are serialized internally so the functor itself may freely run in
+		/// parallel, it must however not touch any other chunk than the one it was handed.
+		///
+		/// Example:
+		/// \code{.cpp}
+		/// compressed::channel<float> channel = ...;
+		/// channel.for_each_chunk(std::execution::par, [](compressed::container::chunk_span<float> chunk)
+		///		{
+		///			for (auto& pixel : chunk)
+		///			{
+		///				pixel *= 2.0f;
+		///			}
+		///		});
+		/// \endcode
+		///
+		/// \param policy The execution policy to run with, e.g. std::execution::par.
+		/// \param func The functor to apply to each chunk.
+		///
+		/// \throws std::runtime_error if the internal `schunk` pointer is not initialized.
+		template <typename ExecutionPolicy, typename Func>
+			requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+				&& std::invocable<std::remove_reference_t<Func>, container::chunk_span<T>>
+		void for_each_chunk(ExecutionPolicy policy, Func&& func)
+		{
+			_COMPRESSED_PROFILE_FUNCTION();
+			if (!m_Schunk)
+			{
+				throw std::runtime_error("Internal Error: Channel instance is not properly initialized, unable to iterate chunks");
+			}
+			{
+				std::lock_guard<std::mutex> lock(m_WriteMutex);
+				this->detach_if_shared();
+			}
+
+			const auto block_size = this->block_size();
+			auto indices = std::views::iota(size_t{ 0 }, this->num_chunks());
+			std::for_each(policy, indices.begin(), indices.end(), [&](size_t chunk_idx)
+				{
+					// Per-chunk scratch buffers, these are local to the calling thread so the chunks
+					// can be processed independently of one another.
+					util::default_init_vector<T> buffer(this->chunk_elems(chunk_idx));
+					auto buffer_span = std::span<T>(buffer.data(), buffer.size());
+					this->get_chunk(buffer_span, chunk_idx);
+
+					func(container::chunk_span<T>(buffer_span, m_Width, m_Height, chunk_idx, this->chunk_size(), m_TileWidth, m_TileHeight));
+
+					// Recompress with a per-chunk single-threaded context leased from the pool, blosc2
+					// modifies contexts on use so we cannot share m_CompressionContext across threads.
+					auto compression_ctx = blosc2::global_context_pool().checkout_compression<T>(1, m_Codec, m_CompressionLevel, block_size, m_Filter);
+					util::default_init_vector<std::byte> compressed(blosc2::min_compressed_size(this->chunk_size()));
+					auto csize = blosc2::compress<T>(compression_ctx.ctx(), buffer_span, std::span<std::byte>(compressed));
+
+					if (m_ChunkCache)
+					{
+						m_ChunkCache->invalidate(chunk_idx);
+					}
+
+					// Publication of the compressed chunk into the schunk is serialized, the compression
+					// itself (the expensive part) ran outside of the lock. Sharing the channel-wide
+					// write mutex keeps this safe against concurrent set_chunk callers too.
+					std::lock_guard<std::mutex> lock(m_WriteMutex);
+					std::visit([&](auto& schunk)
+						{
+							schunk.set_chunk(std::span<const std::byte>(compressed.data(), csize), chunk_idx);
+						}, *m_Schunk);
+				});
+
+			// Every chunk was decoded (which fuses the queued lazy transforms, see `map`) and
+			// recompressed, so the queue is now materialized in storage and must not re-apply.
+			m_PendingTransforms.clear();
+		}
+
+		/// Apply `func` to every chunk of the channel in parallel, equivalent to calling
+		/// `for_each_chunk(std::execution::par, func)`.
+		template <typename Func>
+			requires std::invocable<std::remove_reference_t<Func>, container::chunk_span<T>>
+		void for_each_chunk(Func&& func)
+		{
+			this->for_each_chunk(std::execution::par, std::forward<Func>(func));
+		}
+
+		/// Apply `func` to every chunk of the channel without recompressing, for read-only passes.
+		///
+		/// Identical to the mutable overload except that the functor receives a `container::chunk_span<const T>`
+		/// and the chunks are never recompressed, making read-only scans roughly twice as fast.
+		///
+		/// \param policy The execution policy to run with, e.g. std::execution::par.
+		/// \param func The functor to apply to each chunk.
+		///
+		/// \throws std::runtime_error if the internal `schunk` pointer is not initialized.
+		template <typename ExecutionPolicy, typename Func>
+			requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+				&& std::invocable<std::remove_reference_t<Func>, container::chunk_span<const T>>
+		void for_each_chunk(ExecutionPolicy policy, Func&& func) const
+		{
+			_COMPRESSED_PROFILE_FUNCTION();
+			if (!m_Schunk)
+			{
+				throw std::runtime_error("Internal Error: Channel instance is not properly initialized, unable to iterate chunks");
+			}
+
+			auto indices = std::views::iota(size_t{ 0 }, this->num_chunks());
+			std::for_each(policy, indices.begin(), indices.end(), [&](size_t chunk_idx)
+				{
+					util::default_init_vector<T> buffer(this->chunk_elems(chunk_idx));
+					auto buffer_span = std::span<T>(buffer.data(), buffer.size());
+					this->get_chunk(buffer_span, chunk_idx);
+
+					auto const_span = std::span<const T>(buffer_span.begin(), buffer_span.end());
+					func(container::chunk_span<const T>(const_span, m_Width, m_Height, chunk_idx, this->chunk_size(), m_TileWidth, m_TileHeight));
+				});
+		}
+
+		/// Apply `func` to every chunk of the channel in parallel without recompressing, equivalent to
+		/// calling `for_each_chunk(std::execution::par, func)` on a const channel.
+		template <typename Func>
+			requires std::invocable<std::remove_reference_t<Func>, container::chunk_span<const T>>
+		void for_each_chunk(Func&& func) const
+		{
+			this->for_each_chunk(std::execution::par, std::forward<Func>(func));
+		}
+
+		/// \brief Record a pointwise transform to be fused into the next chunk decode.
+		///
+		/// Where the `PostProcess` hook of `image<T>::read` fuses a transform into the read
+		/// pipeline, `map` is the equivalent for an already-compressed channel: instead of paying a
+		/// full decompress/recompress pass per operation (e.g. applying a LUT before export), the
+		/// functor is queued and executed on each chunk right after it is decoded -- while the data
+		/// is still hot in cache -- by `get_chunk`, `get_roi`, `get_decompressed` and the read-only
+		/// `for_each_chunk`. Chaining several `map` calls runs all of them in that same single pass
+		/// per chunk, in recording order.
+		///
+		/// The compressed storage is left untouched until the queue is materialized: the first
+		/// mutation (`set_chunk`, the mutable `for_each_chunk`, iteration through `begin()`,
+		/// `flip_vertical` or `crop_y`) or an explicit `bake_transforms` call applies the queue to
+		/// every chunk in one decode/recompress pass and clears it. Until then paths that copy the
+		/// compressed bytes verbatim (`save`, `make_contiguous`, `deduplicate`) carry the queue
+		/// alongside (`clone`/`share`) or do not see it at all (serialization) -- call
+		/// `bake_transforms` first when the stored bytes themselves need to reflect the transforms.
+		///
+		/// Example:
+		/// \code{.cpp}
+		/// compressed::channel<float> channel = ...;
+		/// channel.map([](std::span<float> chunk) { for (auto& px : chunk) { px *= 2.0f; } });
+		/// channel.map([](std::span<float> chunk) { for (auto& px : chunk) { px += 1.0f; } });
+		/// auto data = channel.get_decompressed(); // both run fused, one pass per chunk
+		/// \endcode
+		///
+		/// \param func The transform to queue, invoked with the decoded elements of one chunk.
+		template <typename Func>
+			requires std::invocable<std::remove_reference_t<Func>, std::span<T>>
+		void map(Func&& func)
+		{
+			m_PendingTransforms.push_back(std::function<void(std::span<T>)>(std::forward<Func>(func)));
+		}
+
+		/// The number of transforms currently queued through `map` and not yet materialized.
+		size_t num_pending_transforms() const noexcept
+		{
+			return m_PendingTransforms.size();
+		}
+
+		/// \brief Materialize the transforms queued through `map` into the compressed storage.
+		///
+		/// Runs one parallel decode/recompress pass over all chunks with the whole queue fused in,
+		/// then clears the queue. A no-op when nothing is queued. Called implicitly by the mutating
+		/// operations, call it explicitly before handing the compressed bytes on verbatim (e.g.
+		/// serialization).
+		///
+		/// \throws std::runtime_error if the internal `schunk` pointer is not initialized.
+		void bake_transforms()
+		{
+			if (m_PendingTransforms.empty())
+			{
+				return;
+			}
+			// Decoding through `get_chunk` already fuses the queue, recompressing the result
+			// materializes it; the mutable for_each_chunk clears the queue once done.
+			this->for_each_chunk(std::execution::par, []([[maybe_unused]] container::chunk_span<T> chunk) {});
+		}
+
+		/// Equality operators, compares pointers to check for equality
+		bool operator==(const channel<T>& other) const noexcept
+		{
+			return this == &other;
+		}
+
+	private:
+		/// The storage for the internal data, stored contiguously in a compressed data format
+		blosc2::schunk_var_ptr<T> m_Schunk = nullptr;
+
+		/// Ownership token for copy-on-write views created through `share()`. Views copy the
+		/// token so its use count tells how many channels alias the storage; iterators do not
+		/// hold it, keeping iteration from being mistaken for sharing. See `detach_if_shared`.
+		std::shared_ptr<const std::monostate> m_ShareToken = std::make_shared<const std::monostate>();
+
+		/// Invoke `func` with the concrete super-chunk held by the variant.
+		///
+		/// When the variant holds the fully-materialized `blosc2::schunk<T>` -- the common case for
+		/// channels built from data -- the `std::visit` dispatch is skipped and `func` is handed the
+		/// concrete type directly. The schunk wrappers are all `final` so the compiler can devirtualize
+		/// and inline the chunk accessors behind the call, which measurably helps when iterating
+		/// millions of small chunks. The lazy and mmap alternatives fall back to the variant dispatch.
+		template <typename Func>
+		decltype(auto) dispatch_schunk(Func&& func) const
+		{
+			if (auto* direct = std::get_if<blosc2::schunk<T>>(m_Schunk.get()))
+			{
+				return func(*direct);
+			}
+			return std::visit(std::forward<Func>(func), *m_Schunk);
+		}
+		/// Detach the channel's storage from views created through `share()` before a mutation.
+		///
+		/// If other holders still reference the shared storage the compressed chunks are copied
+		/// byte-for-byte into a fresh super-chunk (O(compressed size), no codec work) so the
+		/// other holders keep their snapshot. A no-op for a channel that is not shared. Callers
+		/// must hold `m_WriteMutex`; the chunk cache stays valid as the data is unchanged.
+		void detach_if_shared()
+		{
+			if (!m_ShareToken || m_ShareToken.use_count() == 1)
+			{
+				return;
+			}
+			_COMPRESSED_PROFILE_FUNCTION();
+
+			auto copied = std::visit([](const auto& schunk) -> blosc2::schunk_var<T>
+				{
+					using schunk_t = std::remove_cvref_t<decltype(schunk)>;
+					if constexpr (std::is_same_v<schunk_t, blosc2::mmap_schunk<T>>)
+					{
+						// The spill file is exclusively owned so the compressed chunks are copied
+						// out of the mapping into a heap-backed schunk, mirroring `clone()`.
+						auto copy = blosc2::schunk<T>(schunk.max_block_size(), schunk.max_chunk_size());
+						for (auto chunk_idx : std::views::iota(size_t{ 0 }, schunk.num_chunks()))
+						{
+							auto compressed = schunk.compressed_chunk(chunk_idx);
+							copy.append_chunk(std::vector<std::byte>(compressed.begin(), compressed.end()));
+						}
+						return blosc2::schunk_var<T>(std::move(copy));
+					}
+					else
+					{
+						auto copy = schunk;
+						copy.buffer_pool(nullptr);
+						return blosc2::schunk_var<T>(std::move(copy));
+					}
+				}, *m_Schunk);
+
+			m_Schunk = std::make_shared<blosc2::schunk_var<T>>(std::move(copied));
+			m_ShareToken = std::make_shared<const std::monostate>();
+		}
+
+		/// Apply the queued lazy transforms (see `map`) in recording order to decoded chunk data.
+		/// A no-op when nothing is queued, which keeps the hot decode paths free of overhead.
+		void apply_transforms(std::span<T> buffer) const
+		{
+			for (const auto& transform : m_PendingTransforms)
+			{
+				transform(buffer);
+			}
+		}
+
+		/// Reverse the order of the scanlines in `data`, which must hold whole rows of `width` elements.
+		static void reverse_scanlines(std::span<T> data, size_t width)
+		{
+			const size_t num_rows = data.size() / width;
+			for (auto row : std::views::iota(size_t{ 0 }, num_rows / 2))
+			{
+				std::swap_ranges(
+					data.begin() + row * width,
+					data.begin() + (row + 1) * width,
+					data.begin() + (num_rows - 1 - row) * width
+				);
+			}
+		}
+
+		/// Rebuild the channel's chunks from an uncompressed buffer with the current compression
+		/// parameters, adopting `height` as the new channel height. The tiled layout is preserved
+		/// when the tile grid still divides the new dimensions, otherwise the channel drops to the
+		/// scanline-strip layout.
+		void rebuild_from_buffer(std::span<const T> data, size_t height)
+		{
+			_COMPRESSED_PROFILE_FUNCTION();
+			if (this->is_tiled() && height % m_TileHeight == 0)
+			{
+				auto replacement = channel<T>::tiled(
+					data, m_Width, height, m_TileWidth, m_TileHeight,
+					m_Codec, m_CompressionLevel, this->block_size()
+				);
+				std::lock_guard<std::mutex> lock(m_WriteMutex);
+				m_Height = height;
+				*m_Schunk = std::move(*replacement.m_Schunk);
+			}
+			else
+			{
+				const auto block_size = this->block_size();
+				const size_t chunk_size_aligned = util::align_chunk_to_scanlines_bytes<T>(m_Width, this->chunk_size());
+				auto compression_ctx = blosc2::create_compression_context<T>(
+					m_Nthreads, m_Codec, m_CompressionLevel, block_size, m_Filter
+				);
+				auto rebuilt = blosc2::schunk<T>(data, block_size, chunk_size_aligned, compression_ctx);
+
+				std::lock_guard<std::mutex> lock(m_WriteMutex);
+				m_Height = height;
+				m_TileWidth = 0;
+				m_TileHeight = 0;
+				*m_Schunk = blosc2::schunk_var<T>(std::move(rebuilt));
+			}
+			if (m_ChunkCache)
+			{
+				m_ChunkCache->clear();
+			}
+		}
+
+		enums::codec m_Codec = enums::codec::lz4;
+		/// The pre-compression filter applied when (re)compressing chunks.
+		enums::filter m_Filter = enums::filter::shuffle;
+
+		size_t m_Nthreads = detail::shared_nthreads();
+
+		/// Registration against the library-wide thread budget, newly created channels receive
+		/// a share of `compressed::thread_budget()` divided across all alive channels.
+		std::shared_ptr<void> m_ThreadBudgetToken = detail::register_thread_consumer();
+
+		/// Serializes publication of compressed chunks into the super-chunk, see `set_chunk` and
+		/// `for_each_chunk`. Deliberately not carried over by the move operations, every channel
+		/// owns its own mutex.
+		mutable std::mutex m_WriteMutex;
+
+		/// We store a compression and decompression context here to allow us to reuse them rather than having
+		/// to reinitialize them on launch. May be nullptr;
+		blosc2::context_ptr m_CompressionContext = nullptr;
+		blosc2::context_ptr m_DecompressionContext = nullptr;
+
+		/// Optional LRU cache of decompressed chunks, only allocated once a budget is set via
+		/// `cache_budget`. May be nullptr (cache disabled).
+		mutable std::shared_ptr<detail::chunk_cache<T>> m_ChunkCache = nullptr;
+
+		/// Pointwise transforms recorded through `map`, fused into every chunk decode in recording
+		/// order until a mutation materializes them through `bake_transforms`.
+		std::vector<std::function<void(std::span<T>)>> m_PendingTransforms{};
+
+		/// Compression level.
+		uint8_t m_CompressionLevel = 9;
+
+		/// The width and height of the channel.
+		size_t m_Width = 1;
+		size_t m_Height = 1;
+
+		/// The tile dimensions if the channel uses the tiled chunk layout (see `tiled`),
+		/// both zero for the default scanline-strip layout.
+		size_t m_TileWidth = 0;
+		size_t m_TileHeight = 0;
 	};
 
 } // NAMESPACE_COMPRESSED_IMAGE
\ No newline at end of file
@@ -0,0 +1,245 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <format>
+#include <limits>
+#include <span>
+#include <stdexcept>
+
+#include "macros.h"
+#include "enums.h"
+#include "constants.h"
+#include "util.h"
+#include "channel.h"
+#include "blosc2/schunk.h"
+#include "blosc2/util.h"
+#include "blosc2/wrapper.h"
+#include "detail/scoped_timer.h"
+#include "detail/thread_budget.h"
+
+
+namespace NAMESPACE_COMPRESSED_IMAGE
+{
+
+	/// \brief Streaming construction of a `channel<T>`, scanline by scanline.
+	///
+	/// A `channel<T>` is fixed at construction and expects the full uncompressed data up front,
+	/// which forces progressively produced data (e.g. render buckets arriving scanline by
+	/// scanline) through a full uncompressed staging framebuffer. The builder instead accumulates
+	/// incoming scanlines up to a chunk boundary, compresses the chunk and appends it to the
+	/// super-chunk right away, so at any point only a single uncompressed chunk is held in memory
+	/// while everything already received stays compressed.
+	///
+	/// Example:
+	/// \code{.cpp}
+	/// auto builder = compressed::channel_builder<float>(width, height);
+	/// for (auto y : std::views::iota(size_t{ 0 }, height))
+	/// {
+	///		builder.push_scanlines(render_scanline(y));
+	/// }
+	/// auto channel = std::move(builder).finalize();
+	/// \endcode
+	///
+	/// The scanlines must arrive in order, top to bottom. Once all `height` scanlines were pushed
+	/// the builder can be finalized into a regular `channel<T>`.
+	template <typename T>
+	struct channel_builder
+	{
+		channel_builder() = delete;
+		channel_builder(channel_builder&&) = default;
+		channel_builder& operator=(channel_builder&&) = default;
+		channel_builder(const channel_builder&) = delete;
+		channel_builder& operator=(const channel_builder&) = delete;
+
+		/// Initialize a builder for a channel of `width` x `height` with the given compression
+		/// settings, these match the parameters of the `channel<T>` constructor.
+		///
+		/// \param width The width of the image channel.
+		/// \param height The height of the image channel.
+		/// \param compression_codec The compression codec to be used (default is lz4).
+		/// \param compression_level The compression level (default is 9).
+		/// \param block_size The size of the blocks stored inside the chunks.
+		/// \param chunk_size The size of each individual chunk, aligned down to whole scanlines.
+		///					  Must be a multiple of sizeof(T).
+		channel_builder(
+			size_t width,
+			size_t height,
+			enums::codec compression_codec = enums::codec::lz4,
+			uint8_t compression_level = 9,
+			size_t block_size = s_default_blocksize,
+			size_t chunk_size = s_default_chunksize
+		)
+			: m_Width(width), m_Height(height), m_Codec(compression_codec)
+		{
+			m_CompressionLevel = util::ensure_compression_level(compression_level);
+			if (width == 0 || height == 0)
+			{
+				throw std::invalid_argument("Unable to build a channel with a width or height of zero");
+			}
+			assert(chunk_size < std::numeric_limits<int32_t>::max());
+			assert(block_size < chunk_size);
+
+			// Align the chunks to the scanlines just like the channel constructor would so the
+			// resulting channel is indistinguishable from one built in a single pass.
+			const auto chunk_size_aligned = util::align_chunk_to_scanlines_bytes<T>(m_Width, chunk_size);
+			m_Schunk = blosc2::schunk<T>(block_size, chunk_size_aligned);
+
+			m_CompressionContext = blosc2::create_compression_context<T>(
+				detail::shared_nthreads(),
+				m_Codec,
+				m_CompressionLevel,
+				block_size
+			);
+
+			m_Accumulator = util::default_init_vector<T>(chunk_size_aligned / sizeof(T));
+			m_CompressionBuffer = util::default_init_vector<std::byte>(blosc2::min_compressed_size(chunk_size_aligned));
+		}
+
+		/// Push one or more whole scanlines into the builder, compressing and appending a chunk
+		/// whenever the accumulated data crosses a chunk boundary.
+		///
+		/// \param data The scanline data, its size must be a non-zero multiple of the width.
+		///
+		/// \throws std::invalid_argument if `data` is not a whole number of scanlines.
+		/// \throws std::runtime_error if the pushed scanlines would exceed the channel height or
+		///			the builder was already finalized.
+		void push_scanlines(std::span<const T> data)
+		{
+			_COMPRESSED_PROFILE_FUNCTION();
+			validate_not_finalized();
+			if (data.empty() || data.size() % m_Width != 0)
+			{
+				throw std::invalid_argument(
+					std::format(
+						"Pushed scanline data must be a non-zero multiple of the channel width {:L}, instead got"
+						" {:L} elements", m_Width, data.size()
+					)
+				);
+			}
+			const size_t num_scanlines = data.size() / m_Width;
+			if (m_ScanlinesPushed + num_scanlines > m_Height)
+			{
+				throw std::runtime_error(
+					std::format(
+						"Cannot push {:L} further scanline(s), the channel holds {:L} of which {:L} were already pushed",
+						num_scanlines, m_Height, m_ScanlinesPushed
+					)
+				);
+			}
+
+			// Fill the accumulator up to the chunk boundary, compress and append whenever it runs
+			// full. The final (possibly partial) chunk is flushed on finalize.
+			size_t data_offset = 0;
+			while (data_offset < data.size())
+			{
+				const size_t to_copy = std::min(data.size() - data_offset, m_Accumulator.size() - m_AccumulatorSize);
+				std::memcpy(m_Accumulator.data() + m_AccumulatorSize, data.data() + data_offset, to_copy * sizeof(T));
+				m_AccumulatorSize += to_copy;
+				data_offset += to_copy;
+
+				if (m_AccumulatorSize == m_Accumulator.size())
+				{
+					flush_chunk();
+				}
+			}
+			m_ScanlinesPushed += num_scanlines;
+		}
+
+		/// Push a single scanline, see `push_scanlines`.
+		///
+		/// \param scanline The scanline data, its size must match the width exactly.
+		void push_scanline(std::span<const T> scanline)
+		{
+			if (scanline.size() != m_Width)
+			{
+				throw std::invalid_argument(
+					std::format(
+						"Pushed scanline must match the channel width {:L}, instead got {:L} elements",
+						m_Width, scanline.size()
+					)
+				);
+			}
+			this->push_scanlines(scanline);
+		}
+
+		/// The number of scanlines pushed so far.
+		size_t scanlines_pushed() const noexcept { return m_ScanlinesPushed; }
+
+		/// Whether all `height` scanlines were pushed and the builder is ready to be finalized.
+		bool complete() const noexcept { return m_ScanlinesPushed == m_Height; }
+
+		/// Finalize the builder into a `channel<T>`, flushing the trailing partial chunk.
+		///
+		/// The builder is consumed by this and must not be used afterwards.
+		///
+		/// \return The channel holding all the pushed scanlines in compressed form.
+		/// \throws std::runtime_error if not all scanlines were pushed yet or the builder was
+		///			already finalized.
+		channel<T> finalize() &&
+		{
+			_COMPRESSED_PROFILE_FUNCTION();
+			validate_not_finalized();
+			if (!this->complete())
+			{
+				throw std::runtime_error(
+					std::format(
+						"Cannot finalize channel_builder, only {:L} of {:L} scanlines were pushed",
+						m_ScanlinesPushed, m_Height
+					)
+				);
+			}
+
+			if (m_AccumulatorSize > 0)
+			{
+				flush_chunk();
+			}
+			m_Finalized = true;
+
+			return channel<T>(
+				blosc2::schunk_var<T>(std::move(m_Schunk)),
+				m_Width,
+				m_Height,
+				m_Codec,
+				m_CompressionLevel
+			);
+		}
+
+	private:
+
+		blosc2::schunk<T> m_Schunk;
+		blosc2::context_ptr m_CompressionContext = nullptr;
+
+		/// Uncompressed staging area for the chunk currently being filled, sized to exactly one chunk.
+		util::default_init_vector<T> m_Accumulator;
+		size_t m_AccumulatorSize = 0;
+
+		/// Reused compression scratch, `append_chunk` copies the fitted result out of it.
+		util::default_init_vector<std::byte> m_CompressionBuffer;
+
+		size_t m_Width = 0;
+		size_t m_Height = 0;
+		size_t m_ScanlinesPushed = 0;
+		enums::codec m_Codec = enums::codec::lz4;
+		uint8_t m_CompressionLevel = 9;
+		bool m_Finalized = false;
+
+		void validate_not_finalized() const
+		{
+			if (m_Finalized)
+			{
+				throw std::runtime_error("channel_builder was already finalized and cannot be used further");
+			}
+		}
+
+		/// Compress the accumulated data and append it to the super-chunk, resetting the accumulator.
+		void flush_chunk()
+		{
+			auto uncompressed = std::span<T>(m_Accumulator.data(), m_AccumulatorSize);
+			m_Schunk.append_chunk(m_CompressionContext, uncompressed, std::span<std::byte>(m_CompressionBuffer));
+			m_AccumulatorSize = 0;
+		}
+	};
+
+} // NAMESPACE_COMPRESSED_IMAGE
@@ -9,5 +9,11 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 	constexpr static inline std::size_t s_default_chunksize = 4'194'304;
 	/// Default block size for blosc2 chunks. This equates to 16 scanlines in that same 2048*2048 channel.
 	constexpr static inline std::size_t s_default_blocksize = 32'768;
+	/// Default transient memory budget for `compressed::read_batch`, 1GB of read scratch.
+	constexpr static inline std::size_t s_default_batch_memory_budget = 1'073'741'824;
+	/// Default transient memory budget for the scratch buffers of a single `image<T>::read`,
+	/// 256MB. Wide contiguous channel ranges that would exceed this are read in several
+	/// narrower passes instead of sizing the scratch to the full range.
+	constexpr static inline std::size_t s_default_read_scratch_budget = 268'435'456;
 
 } // NAMESPACE_COMPRESSED_IMAGE
\ No newline at end of file
@@ -35,8 +35,11 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			/// \param width The total width of the full image.
 			/// \param height The total height of the full image.
 			/// \param chunk_index The index of this chunk in the overall compressed image sequence.
-			chunk_span(std::span<T> data, size_t width, size_t height, size_t chunk_index, size_t chunk_size)
-				: m_Data(data), m_ChunkSize(chunk_size), m_Width(width), m_Height(height), m_ChunkIndex(chunk_index) {};
+			/// \param tile_width The tile width if the channel uses the tiled chunk layout, 0 for scanline strips.
+			/// \param tile_height The tile height if the channel uses the tiled chunk layout, 0 for scanline strips.
+			chunk_span(std::span<T> data, size_t width, size_t height, size_t chunk_index, size_t chunk_size, size_t tile_width = 0, size_t tile_height = 0)
+				: m_Data(data), m_ChunkSize(chunk_size), m_Width(width), m_Height(height), m_ChunkIndex(chunk_index),
+				m_TileWidth(tile_width), m_TileHeight(tile_height) {};
 
 			/// Computes the X coordinate of a given index within this chunk, relative to the full image.
 			///
@@ -44,6 +47,10 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			/// \returns The X coordinate in the full image.
 			size_t x(size_t _index) const noexcept
 			{
+				if (this->tiled())
+				{
+					return this->tile_x() * m_TileWidth + _index % m_TileWidth;
+				}
 				const auto global_index = get_global_index(_index);
 				return global_index % m_Width;
 			}
@@ -54,6 +61,10 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			/// \returns The Y coordinate in the full image.
 			size_t y(size_t _index) const noexcept
 			{
+				if (this->tiled())
+				{
+					return this->tile_y() * m_TileHeight + _index / m_TileWidth;
+				}
 				const auto global_index = get_global_index(_index);
 				return global_index / m_Width;
 			}
@@ -64,6 +75,24 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 				return m_ChunkIndex;
 			}
 
+			/// Whether this chunk is a 2D tile rather than a scanline strip, see `channel<T>::tiled`.
+			bool tiled() const noexcept
+			{
+				return m_TileWidth != 0 && m_TileHeight != 0;
+			}
+
+			/// The X coordinate of this chunk in tile units, only meaningful if `tiled()` is true.
+			size_t tile_x() const noexcept
+			{
+				return this->tiled() ? m_ChunkIndex % (m_Width / m_TileWidth) : 0;
+			}
+
+			/// The Y coordinate of this chunk in tile units, only meaningful if `tiled()` is true.
+			size_t tile_y() const noexcept
+			{
+				return this->tiled() ? m_ChunkIndex / (m_Width / m_TileWidth) : 0;
+			}
+
 			/// Returns an iterator to the beginning of the chunk's data.
 			///
 			/// This is required to fulfill the requirements of `std::ranges::view_interface`.
@@ -85,6 +114,8 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			size_t m_Width = 1;     ///< The full image width.
 			size_t m_Height = 1;    ///< The full image height.
 			size_t m_ChunkIndex = 0;///< The index of this chunk in the image sequence.
+			size_t m_TileWidth = 0; ///< Tile width for the tiled chunk layout, 0 for scanline strips.
+			size_t m_TileHeight = 0;///< Tile height for the tiled chunk layout, 0 for scanline strips.
 
 			/// Computes the global index of a given local index within the full image.
 			///
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <mutex>
+#include <vector>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include "compressed/macros.h"
+
+namespace NAMESPACE_COMPRESSED_IMAGE
+{
+
+	namespace detail
+	{
+
+		/// Pool of reusable byte buffers for compressed chunk storage.
+		///
+		/// Recycles the `std::vector<std::byte>` instances holding compressed chunks so hot paths
+		/// like `schunk<T>::set_chunk` and the iterator's recompress cycle do not allocate a fresh
+		/// multi-megabyte vector per chunk. With thousands of chunks this avoids heap fragmentation
+		/// and malloc contention across threads. The pool is internally synchronized and intended
+		/// to be shared across the schunks of a channel (or a whole image) via a shared_ptr.
+		///
+		/// Buffers returned to a full pool are simply dropped so the pool never holds more than
+		/// `max_buffers` buffers alive.
+		struct byte_buffer_pool
+		{
+			byte_buffer_pool() = default;
+
+			/// Initialize the pool with an upper bound on the number of pooled buffers.
+			///
+			/// \param max_buffers The maximum number of free buffers kept alive for reuse.
+			explicit byte_buffer_pool(size_t max_buffers)
+				: m_MaxBuffers(max_buffers)
+			{
+			}
+
+			/// Acquire a buffer with at least `min_size` bytes, reusing a pooled buffer if available.
+			///
+			/// The returned buffer is sized to exactly `min_size`, growing a recycled buffer only
+			/// if its capacity is insufficient.
+			///
+			/// \param min_size The size (in bytes) the returned buffer is resized to.
+			/// \return A buffer of `min_size` bytes, contents unspecified.
+			std::vector<std::byte> acquire(size_t min_size)
+			{
+				std::vector<std::byte> buffer{};
+				{
+					std::lock_guard<std::mutex> lock(m_Mutex);
+					if (!m_Free.empty())
+					{
+						buffer = std::move(m_Free.back());
+						m_Free.pop_back();
+					}
+				}
+				buffer.resize(min_size);
+				return buffer;
+			}
+
+			/// Return a buffer to the pool for later reuse, dropping it if the pool is full.
+			///
+			/// \param buffer The buffer to recycle, left in a moved-from state.
+			void release(std::vector<std::byte>&& buffer)
+			{
+				if (buffer.capacity() == 0)
+				{
+					return;
+				}
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				if (m_Free.size() < m_MaxBuffers)
+				{
+					m_Free.push_back(std::move(buffer));
+				}
+			}
+
+			/// The number of free buffers currently held by the pool.
+			size_t num_pooled() const
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				return m_Free.size();
+			}
+
+			/// The maximum number of free buffers kept alive for reuse.
+			size_t max_buffers() const
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				return m_MaxBuffers;
+			}
+
+			/// Update the maximum number of free buffers, dropping any excess immediately.
+			void max_buffers(size_t _max_buffers)
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_MaxBuffers = _max_buffers;
+				if (m_Free.size() > m_MaxBuffers)
+				{
+					m_Free.resize(m_MaxBuffers);
+				}
+			}
+
+			/// Drop all pooled buffers, releasing their memory back to the allocator.
+			void clear()
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_Free.clear();
+			}
+
+		private:
+
+			mutable std::mutex m_Mutex;
+			std::vector<std::vector<std::byte>> m_Free{};
+			size_t m_MaxBuffers = 32;
+		};
+
+	} // detail
+
+} // NAMESPACE_COMPRESSED_IMAGE
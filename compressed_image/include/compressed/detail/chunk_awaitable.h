@@ -0,0 +1,89 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <span>
+#include <thread>
+
+#include "compressed/macros.h"
+#include "compressed/containers/chunk_span.h"
+
+namespace NAMESPACE_COMPRESSED_IMAGE
+{
+
+	template <typename T>
+	struct channel;
+
+	namespace detail
+	{
+
+		/// Awaitable handed out by `channel<T>::get_chunk_async`, decoding one chunk off-thread.
+		///
+		/// `co_await`-ing the object suspends the caller, runs the decode on a library worker
+		/// thread and resumes the coroutine with the filled `container::chunk_span<T>` once the
+		/// chunk is decompressed. The decode goes through the regular `get_chunk` path so it
+		/// shares the chunk cache, the lazy transform queue and the codec admission scheduler
+		/// (where it counts as interactive work) with the synchronous API - many awaits can be
+		/// in flight without oversubscribing the codec.
+		///
+		/// The coroutine is resumed on the worker thread, not on the thread that suspended; if
+		/// the caller needs to hop back to a specific executor it has to reschedule itself after
+		/// the await, this library deliberately has no opinion on executors. Exceptions thrown by
+		/// the decode are rethrown from the `co_await` expression.
+		///
+		/// The awaitable keeps a reference to the channel and the destination buffer, both must
+		/// outlive the await. It is single-use, move it into exactly one `co_await`.
+		template <typename T>
+		struct chunk_decode_awaitable
+		{
+			chunk_decode_awaitable(const channel<T>& channel_ref, std::span<T> buffer, container::chunk_span<T> result)
+				: m_Channel(&channel_ref), m_Buffer(buffer), m_Result(result)
+			{
+			}
+
+			bool await_ready() const noexcept
+			{
+				return false;
+			}
+
+			void await_suspend(std::coroutine_handle<> handle)
+			{
+				// The decode is cpu-bound work that has to run somewhere, a detached worker mirrors
+				// the prefetching iterator's `std::async` usage. Total codec concurrency stays
+				// bounded by the admission scheduler regardless of how many awaits are in flight.
+				std::thread([this, handle]()
+					{
+						try
+						{
+							m_Channel->get_chunk(m_Buffer, m_Result.chunk_index());
+						}
+						catch (...)
+						{
+							m_Exception = std::current_exception();
+						}
+						// resume() may run the coroutine to completion and destroy this awaitable
+						// with it, it has to be the very last thing this thread does.
+						handle.resume();
+					}).detach();
+			}
+
+			container::chunk_span<T> await_resume()
+			{
+				if (m_Exception)
+				{
+					std::rethrow_exception(m_Exception);
+				}
+				return m_Result;
+			}
+
+		private:
+			const channel<T>* m_Channel = nullptr;
+			std::span<T> m_Buffer{};
+			container::chunk_span<T> m_Result{};
+			std::exception_ptr m_Exception = nullptr;
+		};
+
+	} // detail
+
+} // NAMESPACE_COMPRESSED_IMAGE
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <list>
+#include <unordered_map>
+#include <vector>
+#include <mutex>
+#include <span>
+#include <algorithm>
+
+#include "compressed/macros.h"
+
+namespace NAMESPACE_COMPRESSED_IMAGE
+{
+
+	namespace detail
+	{
+
+		/// Size-bounded LRU cache of decompressed chunks, keyed by chunk index.
+		///
+		/// Used by `channel<T>` to serve repeated random access to the same few chunks from plain
+		/// memory instead of paying a full blosc2 decompression on every `get_chunk` call. The cache
+		/// is bounded by a byte budget; once inserting a chunk would exceed it the least recently
+		/// used entries are evicted until the new chunk fits. All operations are internally
+		/// synchronized so the cache may be consulted from parallel chunk accesses.
+		///
+		/// \tparam T The data type of the decompressed chunks.
+		template <typename T>
+		struct chunk_cache
+		{
+			chunk_cache() = default;
+
+			/// Initialize the cache with the given byte budget.
+			///
+			/// \param byte_budget The maximum number of bytes of decompressed chunk data to hold.
+			explicit chunk_cache(size_t byte_budget)
+				: m_ByteBudget(byte_budget)
+			{
+			}
+
+			/// Retrieve the byte budget of the cache.
+			size_t byte_budget() const noexcept
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				return m_ByteBudget;
+			}
+
+			/// Update the byte budget of the cache, evicting entries if the new budget is smaller
+			/// than the currently held data.
+			void byte_budget(size_t _byte_budget)
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_ByteBudget = _byte_budget;
+				this->evict_to_budget();
+			}
+
+			/// The number of bytes of decompressed chunk data currently held by the cache.
+			size_t stored_bytes() const noexcept
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				return m_StoredBytes;
+			}
+
+			/// Try to copy the cached chunk at `chunk_idx` into `buffer`, marking it as most
+			/// recently used on a hit.
+			///
+			/// \param buffer The destination buffer, must be at least as large as the cached chunk.
+			/// \param chunk_idx The index of the chunk to look up.
+			///
+			/// \return Whether the chunk was found in the cache (and copied into `buffer`).
+			bool try_get(std::span<T> buffer, size_t chunk_idx)
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				auto it = m_Lookup.find(chunk_idx);
+				if (it == m_Lookup.end())
+				{
+					return false;
+				}
+
+				const auto& data = it->second->second;
+				if (buffer.size() < data.size())
+				{
+					return false;
+				}
+
+				std::copy(data.begin(), data.end(), buffer.begin());
+				// Move the entry to the front, marking it as most recently used.
+				m_Entries.splice(m_Entries.begin(), m_Entries, it->second);
+				return true;
+			}
+
+			/// Store a copy of `data` as the decompressed chunk at `chunk_idx`, evicting least
+			/// recently used entries to stay within the byte budget. Chunks larger than the whole
+			/// budget are silently not cached.
+			void insert(std::span<const T> data, size_t chunk_idx)
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				const size_t data_bytes = data.size() * sizeof(T);
+				if (data_bytes > m_ByteBudget)
+				{
+					return;
+				}
+
+				auto it = m_Lookup.find(chunk_idx);
+				if (it != m_Lookup.end())
+				{
+					m_StoredBytes -= it->second->second.size() * sizeof(T);
+					m_Entries.erase(it->second);
+					m_Lookup.erase(it);
+				}
+
+				m_Entries.emplace_front(chunk_idx, std::vector<T>(data.begin(), data.end()));
+				m_Lookup[chunk_idx] = m_Entries.begin();
+				m_StoredBytes += data_bytes;
+				this->evict_to_budget();
+			}
+
+			/// Drop the cached chunk at `chunk_idx` (if present), e.g. because it was overwritten
+			/// with `set_chunk`.
+			void invalidate(size_t chunk_idx)
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				auto it = m_Lookup.find(chunk_idx);
+				if (it != m_Lookup.end())
+				{
+					m_StoredBytes -= it->second->second.size() * sizeof(T);
+					m_Entries.erase(it->second);
+					m_Lookup.erase(it);
+				}
+			}
+
+			/// Drop all cached chunks.
+			void clear()
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_Entries.clear();
+				m_Lookup.clear();
+				m_StoredBytes = 0;
+			}
+
+		private:
+			/// Cache entries with the most recently used entry at the front.
+			std::list<std::pair<size_t, std::vector<T>>> m_Entries{};
+			/// Mapping from chunk index to the entry in m_Entries for O(1) lookup.
+			std::unordered_map<size_t, typename std::list<std::pair<size_t, std::vector<T>>>::iterator> m_Lookup{};
+
+			mutable std::mutex m_Mutex;
+			size_t m_ByteBudget = 0;
+			size_t m_StoredBytes = 0;
+
+			/// Evict least recently used entries until we are within the byte budget again.
+			/// Must be called with m_Mutex held.
+			void evict_to_budget()
+			{
+				while (m_StoredBytes > m_ByteBudget && !m_Entries.empty())
+				{
+					m_StoredBytes -= m_Entries.back().second.size() * sizeof(T);
+					m_Lookup.erase(m_Entries.back().first);
+					m_Entries.pop_back();
+				}
+			}
+		};
+
+	} // detail
+
+} // NAMESPACE_COMPRESSED_IMAGE
@@ -0,0 +1,242 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <tuple>
+
+#include "compressed/macros.h"
+
+namespace NAMESPACE_COMPRESSED_IMAGE
+{
+
+	namespace detail
+	{
+
+		/// Library-wide admission scheduler for codec work.
+		///
+		/// Every blosc2 (de)compression call runs on a context that owns its worker threads, so
+		/// with many images active at once the number of codec threads actually running is
+		/// `in-flight operations x threads per context`. The thread budget (see
+		/// `compressed::thread_budget`) bounds the second factor, this scheduler bounds the first:
+		/// an operation must acquire a slot before it may run and returns the slot when it is done,
+		/// keeping the total amount of concurrent codec work fixed no matter how many images are
+		/// submitting.
+		///
+		/// Slots are not handed out first-come-first-served. Decompression runs at interactive
+		/// priority and is always granted ahead of background compression so reads stay responsive
+		/// while bulk encodes are in flight. Within a priority class the waiter whose submitter has
+		/// the fewest operations currently running goes first, so one image flooding the scheduler
+		/// with chunks cannot starve the others.
+		///
+		/// All operations are internally synchronized, the library-wide instance is available via
+		/// `global_codec_scheduler()`.
+		class codec_scheduler
+		{
+		public:
+
+			/// Priority class of a codec operation, lower values are granted slots first.
+			enum class priority : uint8_t
+			{
+				interactive = 0,	// decompression, somebody is waiting on the result
+				background = 1,		// compression, throughput work
+			};
+
+			/// RAII slot over the scheduler, returns the slot on destruction.
+			struct permit
+			{
+				explicit permit(codec_scheduler* scheduler, const void* submitter)
+					: m_Scheduler(scheduler), m_Submitter(submitter)
+				{
+				}
+
+				permit(const permit&) = delete;
+				permit& operator=(const permit&) = delete;
+
+				permit(permit&& other) noexcept
+					: m_Scheduler(other.m_Scheduler), m_Submitter(other.m_Submitter)
+				{
+					other.m_Scheduler = nullptr;
+				}
+
+				permit& operator=(permit&& other) noexcept
+				{
+					if (this != &other)
+					{
+						this->release();
+						m_Scheduler = other.m_Scheduler;
+						m_Submitter = other.m_Submitter;
+						other.m_Scheduler = nullptr;
+					}
+					return *this;
+				}
+
+				~permit()
+				{
+					this->release();
+				}
+
+			private:
+				codec_scheduler* m_Scheduler = nullptr;
+				const void* m_Submitter = nullptr;
+
+				void release() noexcept
+				{
+					if (m_Scheduler)
+					{
+						m_Scheduler->return_slot(m_Submitter);
+					}
+					m_Scheduler = nullptr;
+				}
+			};
+
+			/// Acquire a slot for a codec operation, blocking until one is granted.
+			///
+			/// \param prio The priority class of the operation, interactive waiters are granted
+			///             slots before background ones.
+			/// \param submitter An opaque id grouping operations of the same consumer (typically
+			///                  the codec context), used to balance slots fairly across submitters.
+			///                  May be nullptr in which case the operation joins the anonymous group.
+			/// \return A permit holding the slot, the slot is returned when the permit is dropped.
+			permit acquire(priority prio, const void* submitter = nullptr)
+			{
+				std::unique_lock<std::mutex> lock(m_Mutex);
+				waiter ticket{ prio, submitter, m_Sequence++ };
+				m_Waiters.push_back(ticket);
+				m_Condition.wait(lock, [this, &ticket]
+				{
+					return m_Running < m_MaxConcurrency && this->is_next(ticket);
+				});
+				std::erase_if(m_Waiters, [&ticket](const waiter& other) { return other.seq == ticket.seq; });
+				++m_Running;
+				++m_InFlight[submitter];
+				lock.unlock();
+				// Taking this slot may have unblocked another waiter too (it only checked
+				// eligibility while our ticket was still queued ahead of it), re-evaluate.
+				m_Condition.notify_all();
+				return permit(this, submitter);
+			}
+
+			/// The maximum number of codec operations allowed to run concurrently.
+			size_t max_concurrency() const
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				return m_MaxConcurrency;
+			}
+
+			/// Set the maximum number of codec operations allowed to run concurrently, clamped
+			/// to at least 1. Operations already running are unaffected, a lowered limit simply
+			/// stops further slots from being granted until enough permits are returned.
+			void max_concurrency(size_t slots)
+			{
+				{
+					std::lock_guard<std::mutex> lock(m_Mutex);
+					m_MaxConcurrency = std::max<size_t>(slots, 1);
+				}
+				m_Condition.notify_all();
+			}
+
+			/// The number of codec operations currently holding a slot.
+			size_t num_running() const
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				return m_Running;
+			}
+
+			/// The number of codec operations currently waiting for a slot.
+			size_t num_waiting() const
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				return m_Waiters.size();
+			}
+
+		private:
+
+			/// A pending acquire, ordered by priority, then by how many operations its submitter
+			/// already has running, then by arrival.
+			struct waiter
+			{
+				priority prio = priority::background;
+				const void* submitter = nullptr;
+				size_t seq = 0;
+			};
+
+			mutable std::mutex m_Mutex;
+			std::condition_variable m_Condition;
+			std::deque<waiter> m_Waiters{};
+			std::map<const void*, size_t> m_InFlight{};
+			size_t m_Running = 0;
+			size_t m_Sequence = 0;
+			size_t m_MaxConcurrency = std::max<size_t>(std::thread::hardware_concurrency() / 2, 1);
+
+			/// Whether `ticket` orders before every other waiter, must be called under `m_Mutex`.
+			bool is_next(const waiter& ticket) const
+			{
+				const auto rank = [this](const waiter& w)
+				{
+					auto it = m_InFlight.find(w.submitter);
+					size_t in_flight = it != m_InFlight.end() ? it->second : 0;
+					return std::tuple<uint8_t, size_t, size_t>{ static_cast<uint8_t>(w.prio), in_flight, w.seq };
+				};
+				const auto ticket_rank = rank(ticket);
+				for (const auto& other : m_Waiters)
+				{
+					if (other.seq != ticket.seq && rank(other) < ticket_rank)
+					{
+						return false;
+					}
+				}
+				return true;
+			}
+
+			/// Return a slot to the scheduler, waking the next eligible waiter.
+			void return_slot(const void* submitter)
+			{
+				{
+					std::lock_guard<std::mutex> lock(m_Mutex);
+					--m_Running;
+					auto it = m_InFlight.find(submitter);
+					if (it != m_InFlight.end() && --it->second == 0)
+					{
+						m_InFlight.erase(it);
+					}
+				}
+				m_Condition.notify_all();
+			}
+		};
+
+
+		/// The library-wide codec scheduler shared by all compression and decompression calls.
+		inline codec_scheduler& global_codec_scheduler()
+		{
+			static codec_scheduler s_scheduler;
+			return s_scheduler;
+		}
+
+	} // detail
+
+
+	/// Retrieve the maximum number of codec operations the library runs concurrently.
+	///
+	/// Defaults to half the hardware concurrency. Together with `thread_budget` this bounds the
+	/// total amount of codec threads alive at once: at most `codec_concurrency()` operations run
+	/// in parallel, each on a context sized to its share of the thread budget.
+	inline size_t codec_concurrency()
+	{
+		return detail::global_codec_scheduler().max_concurrency();
+	}
+
+	/// Set the maximum number of codec operations the library runs concurrently.
+	///
+	/// \param slots The number of concurrent codec operations to allow, clamped to at least 1.
+	inline void codec_concurrency(size_t slots)
+	{
+		detail::global_codec_scheduler().max_concurrency(slots);
+	}
+
+} // NAMESPACE_COMPRESSED_IMAGE
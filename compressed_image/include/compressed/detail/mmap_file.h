@@ -0,0 +1,273 @@
+#pragma once
+
+#include <filesystem>
+#include <stdexcept>
+#include <format>
+#include <utility>
+#include <cstddef>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "compressed/macros.h"
+
+namespace NAMESPACE_COMPRESSED_IMAGE
+{
+
+	namespace detail
+	{
+
+		/// Thin RAII wrapper around a writable memory-mapped spill file.
+		///
+		/// Used by `blosc2::mmap_schunk<T>` to keep compressed chunks out-of-core, letting the OS
+		/// page cache manage residency instead of the heap. The mapping can be grown with `resize`
+		/// which extends the file on disk and re-establishes the view, invalidating any previously
+		/// obtained pointers. The file is removed from disk on destruction.
+		struct mmap_file
+		{
+			mmap_file() = default;
+
+			mmap_file(const mmap_file&) = delete;
+			mmap_file& operator=(const mmap_file&) = delete;
+
+			mmap_file(mmap_file&& other) noexcept
+			{
+				*this = std::move(other);
+			}
+
+			mmap_file& operator=(mmap_file&& other) noexcept
+			{
+				if (this != &other)
+				{
+					this->close();
+					m_Path = std::move(other.m_Path);
+					m_Data = other.m_Data;
+					m_Capacity = other.m_Capacity;
+#ifdef _WIN32
+					m_FileHandle = other.m_FileHandle;
+					m_MappingHandle = other.m_MappingHandle;
+					other.m_FileHandle = INVALID_HANDLE_VALUE;
+					other.m_MappingHandle = nullptr;
+#else
+					m_FileDescriptor = other.m_FileDescriptor;
+					other.m_FileDescriptor = -1;
+#endif
+					other.m_Data = nullptr;
+					other.m_Capacity = 0;
+					other.m_Path.clear();
+				}
+				return *this;
+			}
+
+			/// Create (or truncate) the file at `path` and map `capacity` bytes of it.
+			///
+			/// \param path The file to create, parent directories must already exist.
+			/// \param capacity The initial capacity (in bytes) of the mapping, must be non-zero.
+			/// \throws std::runtime_error if the file cannot be created or mapped.
+			mmap_file(std::filesystem::path path, size_t capacity)
+				: m_Path(std::move(path))
+			{
+				if (capacity == 0)
+				{
+					throw std::invalid_argument("Unable to create mmap_file with a capacity of zero bytes");
+				}
+
+#ifdef _WIN32
+				m_FileHandle = CreateFileW(
+					m_Path.wstring().c_str(),
+					GENERIC_READ | GENERIC_WRITE,
+					0,
+					nullptr,
+					CREATE_ALWAYS,
+					FILE_ATTRIBUTE_TEMPORARY,
+					nullptr
+				);
+				if (m_FileHandle == INVALID_HANDLE_VALUE)
+				{
+					throw std::runtime_error(std::format("Unable to create spill file {}", m_Path.string()));
+				}
+#else
+				m_FileDescriptor = ::open(m_Path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+				if (m_FileDescriptor < 0)
+				{
+					throw std::runtime_error(std::format("Unable to create spill file {}", m_Path.string()));
+				}
+#endif
+				this->map(capacity);
+			}
+
+			~mmap_file()
+			{
+				this->close();
+			}
+
+			/// Whether the file is currently open and mapped.
+			bool valid() const noexcept
+			{
+				return m_Data != nullptr;
+			}
+
+			/// Pointer to the start of the mapped region.
+			std::byte* data() noexcept
+			{
+				return m_Data;
+			}
+
+			/// Pointer to the start of the mapped region.
+			const std::byte* data() const noexcept
+			{
+				return m_Data;
+			}
+
+			/// The currently mapped capacity in bytes.
+			size_t capacity() const noexcept
+			{
+				return m_Capacity;
+			}
+
+			/// The path of the backing file on disk.
+			const std::filesystem::path& path() const noexcept
+			{
+				return m_Path;
+			}
+
+			/// Grow the backing file to `new_capacity` bytes and re-map it.
+			///
+			/// Any previously obtained pointers into the mapping are invalidated by this call.
+			///
+			/// \throws std::runtime_error if the file cannot be extended or re-mapped.
+			/// \throws std::invalid_argument if `new_capacity` would shrink the file.
+			void resize(size_t new_capacity)
+			{
+				if (new_capacity < m_Capacity)
+				{
+					throw std::invalid_argument(
+						std::format(
+							"Unable to shrink mmap_file from {:L} to {:L} bytes, only growing is supported",
+							m_Capacity, new_capacity
+						)
+					);
+				}
+				if (new_capacity == m_Capacity)
+				{
+					return;
+				}
+				this->unmap();
+				this->map(new_capacity);
+			}
+
+			/// Flush the mapped region back to disk.
+			void flush()
+			{
+				if (!m_Data)
+				{
+					return;
+				}
+#ifdef _WIN32
+				FlushViewOfFile(m_Data, m_Capacity);
+#else
+				::msync(m_Data, m_Capacity, MS_ASYNC);
+#endif
+			}
+
+		private:
+
+			std::filesystem::path m_Path;
+			std::byte* m_Data = nullptr;
+			size_t m_Capacity = 0;
+#ifdef _WIN32
+			HANDLE m_FileHandle = INVALID_HANDLE_VALUE;
+			HANDLE m_MappingHandle = nullptr;
+#else
+			int m_FileDescriptor = -1;
+#endif
+
+			/// Extend the file to `capacity` bytes and establish the mapping.
+			void map(size_t capacity)
+			{
+#ifdef _WIN32
+				LARGE_INTEGER size{};
+				size.QuadPart = static_cast<LONGLONG>(capacity);
+				if (!SetFilePointerEx(m_FileHandle, size, nullptr, FILE_BEGIN) || !SetEndOfFile(m_FileHandle))
+				{
+					throw std::runtime_error(std::format("Unable to extend spill file {} to {:L} bytes", m_Path.string(), capacity));
+				}
+				m_MappingHandle = CreateFileMappingW(m_FileHandle, nullptr, PAGE_READWRITE, size.HighPart, size.LowPart, nullptr);
+				if (!m_MappingHandle)
+				{
+					throw std::runtime_error(std::format("Unable to create file mapping for spill file {}", m_Path.string()));
+				}
+				m_Data = static_cast<std::byte*>(MapViewOfFile(m_MappingHandle, FILE_MAP_ALL_ACCESS, 0, 0, capacity));
+				if (!m_Data)
+				{
+					throw std::runtime_error(std::format("Unable to map view of spill file {}", m_Path.string()));
+				}
+#else
+				if (::ftruncate(m_FileDescriptor, static_cast<off_t>(capacity)) != 0)
+				{
+					throw std::runtime_error(std::format("Unable to extend spill file {} to {:L} bytes", m_Path.string(), capacity));
+				}
+				void* mapped = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, m_FileDescriptor, 0);
+				if (mapped == MAP_FAILED)
+				{
+					throw std::runtime_error(std::format("Unable to map view of spill file {}", m_Path.string()));
+				}
+				m_Data = static_cast<std::byte*>(mapped);
+#endif
+				m_Capacity = capacity;
+			}
+
+			/// Tear down the current mapping leaving the file itself intact.
+			void unmap() noexcept
+			{
+				if (m_Data)
+				{
+#ifdef _WIN32
+					UnmapViewOfFile(m_Data);
+					CloseHandle(m_MappingHandle);
+					m_MappingHandle = nullptr;
+#else
+					::munmap(m_Data, m_Capacity);
+#endif
+					m_Data = nullptr;
+					m_Capacity = 0;
+				}
+			}
+
+			/// Tear down the mapping, close the file and remove it from disk.
+			void close() noexcept
+			{
+				this->unmap();
+#ifdef _WIN32
+				if (m_FileHandle != INVALID_HANDLE_VALUE)
+				{
+					CloseHandle(m_FileHandle);
+					m_FileHandle = INVALID_HANDLE_VALUE;
+				}
+#else
+				if (m_FileDescriptor >= 0)
+				{
+					::close(m_FileDescriptor);
+					m_FileDescriptor = -1;
+				}
+#endif
+				if (!m_Path.empty())
+				{
+					std::error_code ec{};
+					std::filesystem::remove(m_Path, ec);
+					m_Path.clear();
+				}
+			}
+		};
+
+	} // detail
+
+} // NAMESPACE_COMPRESSED_IMAGE
@@ -1,37 +1,68 @@
 //
-// Basic instrumentation profiler by Cherno to be used for chrome://tracing
+// Basic instrumentation profiler by Cherno to be used for chrome://tracing, grown into the
+// library's instrumentation surface: on top of the tracing JSON export this aggregates codec
+// telemetry (bytes/chunks compressed and decompressed) and can forward every completed scope
+// to a user callback so the data can be attached to external telemetry without a rebuild.
 
 // Usage: include this header file somewhere in your code (eg. precompiled header), and then use like:
 //
-// Instrumentor::Get().BeginSession("Session Name");        // Begin session 
+// Instrumentor::Get().BeginSession("Session Name");        // Begin session
 // {
 //     PROFILE_FUNCTION();   // Place code like this in scopes you'd like to include in profiling
 //     // Code
 // }
 // Instrumentor::Get().EndSession();                        // End Session
+//
+// The timers are compiled in unconditionally but are runtime-gated: unless a session is open or a
+// profile callback is registered a scope costs a single relaxed atomic load. Codec telemetry is
+// always aggregated and can be queried via compressed::telemetry() / compressed::reset_telemetry().
 #pragma once
 
 #include "compressed/macros.h"
 
 #include <string>
+#include <string_view>
 #include <chrono>
 #include <algorithm>
 #include <fstream>
+#include <functional>
+#include <atomic>
+#include <cstdint>
 
 #include <mutex>
 #include <thread>
 
-#ifdef _COMPRESSED_PROFILE
 #define _COMPRESSED_PROFILE_SCOPE(name) NAMESPACE_COMPRESSED_IMAGE::detail::InstrumentationTimer timer##__LINE__(name)
 #define _COMPRESSED_PROFILE_FUNCTION()  NAMESPACE_COMPRESSED_IMAGE::detail::InstrumentationTimer timer##__FUNCTION__##__LINE__(__FUNCTION__)
-#else
-#define _COMPRESSED_PROFILE_SCOPE(name)
-#define _COMPRESSED_PROFILE_FUNCTION()
-#endif
 
 namespace NAMESPACE_COMPRESSED_IMAGE
 {
 
+    /// A single completed instrumentation scope as handed to the profile callback.
+    ///
+    /// `name` points at the static scope name and is only valid for the duration of the callback.
+    struct profile_event
+    {
+        std::string_view name;
+        long long start_us = 0;
+        long long end_us = 0;
+        uint32_t thread_id = 0;
+    };
+
+    /// Aggregated codec telemetry, queried via `compressed::telemetry()`.
+    ///
+    /// The counters are process-wide and cover every channel/image in flight, a chunk counts as
+    /// 'touched' once per compression or decompression of it. The byte counts refer to the
+    /// uncompressed side of the codec so throughput can be derived directly.
+    struct telemetry_counters
+    {
+        uint64_t bytes_compressed = 0;
+        uint64_t bytes_decompressed = 0;
+        uint64_t chunks_compressed = 0;
+        uint64_t chunks_decompressed = 0;
+    };
+
+
     namespace detail
     {
 
@@ -54,6 +85,9 @@ namespace NAMESPACE_COMPRESSED_IMAGE
             std::ofstream m_OutputStream;
             int m_ProfileCount;
             std::mutex m_lock;
+            std::function<void(const profile_event&)> m_Callback;
+            std::atomic<bool> m_SessionOpen{ false };
+            std::atomic<bool> m_CallbackSet{ false };
         public:
             Instrumentor()
                 : m_CurrentSession(nullptr), m_ProfileCount(0)
@@ -65,10 +99,12 @@ namespace NAMESPACE_COMPRESSED_IMAGE
                 m_OutputStream.open(filepath);
                 WriteHeader();
                 m_CurrentSession = new InstrumentationSession{ name };
+                m_SessionOpen.store(true, std::memory_order_relaxed);
             }
 
             void EndSession()
             {
+                m_SessionOpen.store(false, std::memory_order_relaxed);
                 WriteFooter();
                 m_OutputStream.close();
                 delete m_CurrentSession;
@@ -76,10 +112,38 @@ namespace NAMESPACE_COMPRESSED_IMAGE
                 m_ProfileCount = 0;
             }
 
+            /// Register a callback receiving every completed instrumentation scope, or reset it by
+            /// passing an empty function. The callback may be invoked concurrently from any thread
+            /// that runs instrumented code and must not itself call into instrumented functions.
+            void SetCallback(std::function<void(const profile_event&)> callback)
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                m_Callback = std::move(callback);
+                m_CallbackSet.store(static_cast<bool>(m_Callback), std::memory_order_relaxed);
+            }
+
+            /// Whether scopes need to be timestamped at all, i.e. a session is open or a callback
+            /// is registered. Cheap enough to query on every scope entry.
+            bool Enabled() const
+            {
+                return m_SessionOpen.load(std::memory_order_relaxed) ||
+                    m_CallbackSet.load(std::memory_order_relaxed);
+            }
+
             void WriteProfile(const ProfileResult& result)
             {
                 std::lock_guard<std::mutex> lock(m_lock);
 
+                if (m_Callback)
+                {
+                    m_Callback(profile_event{ result.Name, result.Start, result.End, result.ThreadID });
+                }
+
+                if (!m_CurrentSession)
+                {
+                    return;
+                }
+
                 if (m_ProfileCount++ > 0)
                     m_OutputStream << ",";
 
@@ -124,7 +188,13 @@ namespace NAMESPACE_COMPRESSED_IMAGE
             InstrumentationTimer(const char* name)
                 : m_Name(name), m_Stopped(false)
             {
-                m_StartTimepoint = std::chrono::high_resolution_clock::now();
+                // Runtime gate: without an open session or registered callback this is the only
+                // cost of an instrumented scope.
+                m_Active = Instrumentor::Get().Enabled();
+                if (m_Active)
+                {
+                    m_StartTimepoint = std::chrono::high_resolution_clock::now();
+                }
             }
 
             ~InstrumentationTimer()
@@ -135,6 +205,10 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 
             void Stop()
             {
+                m_Stopped = true;
+                if (!m_Active)
+                    return;
+
                 auto endTimepoint = std::chrono::high_resolution_clock::now();
 
                 long long start = std::chrono::time_point_cast<std::chrono::microseconds>(m_StartTimepoint).time_since_epoch().count();
@@ -142,14 +216,80 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 
                 uint32_t threadID = static_cast<uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id()));
                 Instrumentor::Get().WriteProfile({ m_Name, start, end, threadID });
-
-                m_Stopped = true;
             }
         private:
             const std::string m_Name{};
             std::chrono::time_point<std::chrono::high_resolution_clock> m_StartTimepoint;
             bool m_Stopped = false;
+            bool m_Active = false;
         };
 
+
+        /// Process-wide codec telemetry aggregation, fed by the blosc2 wrapper functions.
+        struct telemetry_state
+        {
+            std::atomic<uint64_t> bytes_compressed{ 0 };
+            std::atomic<uint64_t> bytes_decompressed{ 0 };
+            std::atomic<uint64_t> chunks_compressed{ 0 };
+            std::atomic<uint64_t> chunks_decompressed{ 0 };
+        };
+
+        inline telemetry_state& global_telemetry()
+        {
+            static telemetry_state state;
+            return state;
+        }
+
+        /// Record one chunk compression of `bytes` uncompressed bytes.
+        inline void record_compression(uint64_t bytes)
+        {
+            auto& state = global_telemetry();
+            state.bytes_compressed.fetch_add(bytes, std::memory_order_relaxed);
+            state.chunks_compressed.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /// Record one chunk decompression of `bytes` uncompressed bytes.
+        inline void record_decompression(uint64_t bytes)
+        {
+            auto& state = global_telemetry();
+            state.bytes_decompressed.fetch_add(bytes, std::memory_order_relaxed);
+            state.chunks_decompressed.fetch_add(1, std::memory_order_relaxed);
+        }
+
     } // detail
+
+
+    /// Take a snapshot of the aggregated codec telemetry (bytes and chunks compressed/decompressed
+    /// across the whole process since startup or the last `reset_telemetry()`).
+    inline telemetry_counters telemetry()
+    {
+        const auto& state = detail::global_telemetry();
+        return telemetry_counters{
+            state.bytes_compressed.load(std::memory_order_relaxed),
+            state.bytes_decompressed.load(std::memory_order_relaxed),
+            state.chunks_compressed.load(std::memory_order_relaxed),
+            state.chunks_decompressed.load(std::memory_order_relaxed)
+        };
+    }
+
+    /// Reset the aggregated codec telemetry back to zero, e.g. between frames or render tasks.
+    inline void reset_telemetry()
+    {
+        auto& state = detail::global_telemetry();
+        state.bytes_compressed.store(0, std::memory_order_relaxed);
+        state.bytes_decompressed.store(0, std::memory_order_relaxed);
+        state.chunks_compressed.store(0, std::memory_order_relaxed);
+        state.chunks_decompressed.store(0, std::memory_order_relaxed);
+    }
+
+    /// Register a callback receiving every completed instrumentation scope, or reset it by passing
+    /// `nullptr`. While a callback is registered all instrumented scopes are timestamped and
+    /// forwarded to it, no `_COMPRESSED_PROFILE` rebuild is required.
+    ///
+    /// The callback may be invoked concurrently from any thread running instrumented code.
+    inline void profile_callback(std::function<void(const profile_event&)> callback)
+    {
+        detail::Instrumentor::Get().SetCallback(std::move(callback));
+    }
+
 } // NAMESPACE_COMPRESSED_IMAGE
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <fstream>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <span>
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <format>
+#include <stdexcept>
+#include <type_traits>
+
+#include "compressed/macros.h"
+
+namespace NAMESPACE_COMPRESSED_IMAGE
+{
+
+	namespace detail
+	{
+
+		// Helpers for the native compressed serialization format used by image<T>::save / image<T>::load.
+		// The format stores the already-compressed blosc2 chunks verbatim so round-tripping an image is
+		// pure sequential I/O with zero codec work. Scalars are written in native byte order, the format
+		// is not intended as an interchange format across differently-ordered machines.
+		namespace serialization
+		{
+
+			/// Magic bytes identifying a native compressed-image file.
+			constexpr static inline std::array<char, 8> s_magic = { 'C', 'I', 'M', 'G', 'B', 'L', '2', '\0' };
+
+			/// Version of the serialization format, bump when the layout changes.
+			constexpr static inline uint32_t s_version = 1;
+
+			/// Discriminators for the schunk alternatives held by blosc2::schunk_var<T>.
+			enum class schunk_kind : uint8_t
+			{
+				schunk = 0,
+				lazy_schunk = 1,
+			};
+
+			/// Single-character tag describing the category of the stored element type, used to catch
+			/// e.g. loading a float file as uint32_t (which would share the typesize).
+			template <typename T>
+			constexpr char type_tag()
+			{
+				if constexpr (std::is_integral_v<T>)
+				{
+					return std::is_signed_v<T> ? 'i' : 'u';
+				}
+				else
+				{
+					// float, double and half-float types all fall into this category.
+					return 'f';
+				}
+			}
+
+			/// Write a trivially copyable scalar to the stream.
+			template <typename U>
+				requires std::is_trivially_copyable_v<U>
+			void write_scalar(std::ofstream& stream, U value)
+			{
+				stream.write(reinterpret_cast<const char*>(&value), sizeof(U));
+			}
+
+			/// Read a trivially copyable scalar from the stream.
+			///
+			/// \throws std::runtime_error if the stream does not hold enough data.
+			template <typename U>
+				requires std::is_trivially_copyable_v<U>
+			U read_scalar(std::ifstream& stream)
+			{
+				U value{};
+				stream.read(reinterpret_cast<char*>(&value), sizeof(U));
+				if (!stream)
+				{
+					throw std::runtime_error("Unexpected end of file while reading compressed-image file");
+				}
+				return value;
+			}
+
+			/// Write a length-prefixed byte buffer to the stream.
+			inline void write_bytes(std::ofstream& stream, std::span<const std::byte> bytes)
+			{
+				write_scalar<uint64_t>(stream, bytes.size());
+				stream.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+			}
+
+			/// Read a length-prefixed byte buffer from the stream.
+			///
+			/// \throws std::runtime_error if the stream does not hold enough data.
+			inline std::vector<std::byte> read_bytes(std::ifstream& stream)
+			{
+				auto size = read_scalar<uint64_t>(stream);
+				std::vector<std::byte> bytes(size);
+				stream.read(reinterpret_cast<char*>(bytes.data()), size);
+				if (!stream)
+				{
+					throw std::runtime_error("Unexpected end of file while reading compressed-image file");
+				}
+				return bytes;
+			}
+
+			/// Write a length-prefixed utf-8 string to the stream.
+			inline void write_string(std::ofstream& stream, const std::string& str)
+			{
+				write_scalar<uint64_t>(stream, str.size());
+				stream.write(str.data(), str.size());
+			}
+
+			/// Read a length-prefixed utf-8 string from the stream.
+			///
+			/// \throws std::runtime_error if the stream does not hold enough data.
+			inline std::string read_string(std::ifstream& stream)
+			{
+				auto size = read_scalar<uint64_t>(stream);
+				std::string str(size, '\0');
+				stream.read(str.data(), size);
+				if (!stream)
+				{
+					throw std::runtime_error("Unexpected end of file while reading compressed-image file");
+				}
+				return str;
+			}
+
+		} // serialization
+
+	} // detail
+
+} // NAMESPACE_COMPRESSED_IMAGE
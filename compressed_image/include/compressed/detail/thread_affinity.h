@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <cstddef>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "compressed/macros.h"
+
+namespace NAMESPACE_COMPRESSED_IMAGE
+{
+
+	namespace detail
+	{
+
+		/// Storage for the library-wide pipeline affinity group count, see `compressed::affinity_groups`.
+		inline std::atomic<size_t>& affinity_groups_storage()
+		{
+			static std::atomic<size_t> s_groups{ 0 };
+			return s_groups;
+		}
+
+		/// Pin the calling thread to one slice of the machine's logical CPUs.
+		///
+		/// The CPUs are split into `affinity_groups()` contiguous slices and the thread is pinned
+		/// to slice `worker_index % affinity_groups()`. On multi-socket machines the OS numbers
+		/// CPUs so that a contiguous slice stays within one socket, so with one group per NUMA
+		/// node this keeps a pipeline - and everything it first-touches, most importantly its
+		/// read scratch buffers - on a single node instead of migrating mid-read.
+		///
+		/// No-op when affinity is disabled (the default) or on platforms without a thread
+		/// affinity API. Pinning failures are silently ignored, affinity is purely a performance
+		/// hint and must never fail a read.
+		inline void pin_current_thread(size_t worker_index)
+		{
+			const size_t num_groups = affinity_groups_storage().load(std::memory_order_relaxed);
+			const size_t num_cpus = std::thread::hardware_concurrency();
+			if (num_groups < 2 || num_cpus < num_groups)
+			{
+				return;
+			}
+
+			// Contiguous slice of CPUs for this group, the remainder CPUs go to the last group.
+			const size_t group = worker_index % num_groups;
+			const size_t cpus_per_group = num_cpus / num_groups;
+			const size_t cpu_begin = group * cpus_per_group;
+			const size_t cpu_end = (group == num_groups - 1) ? num_cpus : cpu_begin + cpus_per_group;
+
+#ifdef _WIN32
+			// SetThreadAffinityMask is limited to the first 64 logical CPUs of the processor group.
+			DWORD_PTR mask = 0;
+			for (size_t cpu = cpu_begin; cpu < std::min<size_t>(cpu_end, 64); ++cpu)
+			{
+				mask |= DWORD_PTR{ 1 } << cpu;
+			}
+			if (mask != 0)
+			{
+				SetThreadAffinityMask(GetCurrentThread(), mask);
+			}
+#elif defined(__linux__)
+			cpu_set_t cpuset;
+			CPU_ZERO(&cpuset);
+			for (size_t cpu = cpu_begin; cpu < cpu_end; ++cpu)
+			{
+				CPU_SET(static_cast<int>(cpu), &cpuset);
+			}
+			pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+#else
+			// No affinity API available, leave thread placement to the scheduler.
+			(void)cpu_begin;
+			(void)cpu_end;
+#endif
+		}
+
+	} // detail
+
+
+	/// Retrieve the number of affinity groups worker pipelines are partitioned into.
+	///
+	/// 0 (the default) disables affinity entirely, threads go wherever the OS scheduler
+	/// puts them.
+	inline size_t affinity_groups()
+	{
+		return detail::affinity_groups_storage().load(std::memory_order_relaxed);
+	}
+
+	/// Set the number of affinity groups worker pipelines are partitioned into.
+	///
+	/// Typically set to the number of NUMA nodes of the machine. The worker threads spun up
+	/// by `compressed::read_parallel` and `compressed::read_batch` then pin themselves
+	/// round-robin to one contiguous slice of the logical CPUs each, so a pipeline and the
+	/// scratch buffers it first-touches stay on one memory node for the whole read instead
+	/// of paying remote accesses when the scheduler migrates it across sockets mid-read.
+	/// Channels spread across workers are thereby also partitioned across the nodes.
+	///
+	/// Like `compressed::thread_budget` this is a library-wide knob, it only affects worker
+	/// threads created after the call and never threads owned by the caller.
+	///
+	/// \param groups The number of groups to split the logical CPUs into, 0 or 1 disables pinning.
+	inline void affinity_groups(size_t groups)
+	{
+		detail::affinity_groups_storage().store(groups, std::memory_order_relaxed);
+	}
+
+} // NAMESPACE_COMPRESSED_IMAGE
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <algorithm>
+#include <cstddef>
+
+#include "compressed/macros.h"
+
+namespace NAMESPACE_COMPRESSED_IMAGE
+{
+
+	namespace detail
+	{
+
+		/// Storage for the library-wide worker thread budget, see `compressed::thread_budget`.
+		inline std::atomic<size_t>& thread_budget_storage()
+		{
+			static std::atomic<size_t> s_budget{ std::max<size_t>(std::thread::hardware_concurrency() / 2, 1) };
+			return s_budget;
+		}
+
+		/// Number of currently alive consumers (channels) sharing the thread budget.
+		inline std::atomic<size_t>& thread_consumer_count()
+		{
+			static std::atomic<size_t> s_count{ 0 };
+			return s_count;
+		}
+
+		/// Register a consumer against the global thread budget.
+		///
+		/// The returned token keeps the registration alive, dropping the last reference
+		/// unregisters the consumer again. Held by every channel so the budget can be divided
+		/// across whatever is currently alive.
+		inline std::shared_ptr<void> register_thread_consumer()
+		{
+			thread_consumer_count().fetch_add(1, std::memory_order_relaxed);
+			return std::shared_ptr<void>(
+				reinterpret_cast<void*>(0x1),
+				[]([[maybe_unused]] void* token)
+				{
+					thread_consumer_count().fetch_sub(1, std::memory_order_relaxed);
+				}
+			);
+		}
+
+		/// The per-consumer share of the global thread budget, at least one thread.
+		///
+		/// Dividing the budget across the alive consumers keeps many concurrent images from
+		/// oversubscribing the machine where previously every channel sized its contexts to
+		/// hardware_concurrency() / 2 on its own.
+		inline size_t shared_nthreads()
+		{
+			size_t consumers = std::max<size_t>(thread_consumer_count().load(std::memory_order_relaxed), 1);
+			return std::max<size_t>(thread_budget_storage().load(std::memory_order_relaxed) / consumers, 1);
+		}
+
+	} // detail
+
+
+	/// Retrieve the library-wide worker thread budget shared by all images and channels.
+	///
+	/// Defaults to half the hardware concurrency. Newly created channels size their blosc2
+	/// contexts to their share of this budget (budget divided by the number of alive channels).
+	/// Already-created channels keep their sizing until `update_nthreads` is called.
+	inline size_t thread_budget()
+	{
+		return detail::thread_budget_storage().load(std::memory_order_relaxed);
+	}
+
+	/// Set the library-wide worker thread budget shared by all images and channels.
+	///
+	/// Call `image<T>::update_nthreads()` on alive images afterwards to rebalance them
+	/// to their new share.
+	///
+	/// \param budget The total number of worker threads to spread across all consumers, clamped to at least 1.
+	inline void thread_budget(size_t budget)
+	{
+		detail::thread_budget_storage().store(std::max<size_t>(budget, 1), std::memory_order_relaxed);
+	}
+
+} // NAMESPACE_COMPRESSED_IMAGE
@@ -0,0 +1,494 @@
+#pragma once
+
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#ifdef COMPRESSED_IMAGE_OIIO_AVAILABLE
+#include <OpenImageIO/imageio.h>
+#endif
+
+#include "macros.h"
+#include "enums.h"
+#include "constants.h"
+#include "channel.h"
+#include "image.h"
+#include "json_alias.h"
+
+namespace NAMESPACE_COMPRESSED_IMAGE
+{
+
+	/// Variant over the element types a `dynamic_image` channel may be stored as.
+	using channel_variant = std::variant<
+		channel<uint8_t>,
+		channel<uint16_t>,
+		channel<uint32_t>,
+		channel<half>,
+		channel<float>
+	>;
+
+
+	/// A compressed image whose channels may each be stored at their own precision.
+	///
+	/// `image<T>` forces every channel to a single element type, so a file that mixes e.g. half
+	/// color AOVs with a float depth AOV has to promote everything to the widest type and pay the
+	/// memory for it. `dynamic_image` instead stores a `channel_variant` per channel: each channel
+	/// keeps its native precision side by side with the others and the memory footprint follows
+	/// suit.
+	///
+	/// The interface mirrors the type-independent subset of `image<T>` (channel access by index or
+	/// name, channelnames, dimensions, compression ratio, metadata). Anything element-type specific
+	/// is reached by visiting the `channel_variant`, or through `channel_as<T>` when the type is
+	/// known up front.
+	struct dynamic_image
+	{
+
+		dynamic_image() = default;
+
+		/// Construct an empty dynamic image with the given dimensions, to be filled via `add_channel`.
+		///
+		/// \param width The width of the image.
+		/// \param height The height of the image.
+		dynamic_image(size_t width, size_t height)
+			: m_Width(width), m_Height(height)
+		{
+		}
+
+		/// Construct from a homogeneous image, moving all of its channels, channelnames and
+		/// metadata over. The source image is left empty.
+		///
+		/// \tparam T The element type of the source image.
+		/// \param img The image whose channels to take over.
+		template <typename T>
+		explicit dynamic_image(image<T> img)
+			: m_Width(img.width()), m_Height(img.height()), m_ChannelNames(img.channelnames()), m_Metadata(img.metadata())
+		{
+			for (auto& channel : img.channels())
+			{
+				m_Channels.push_back(channel_variant(std::move(channel)));
+			}
+		}
+
+
+#ifdef COMPRESSED_IMAGE_OIIO_AVAILABLE
+
+		/// \brief Read a compressed image from a file with every channel at its native precision.
+		///
+		/// Requires CompressedImage to have been compiled with OpenImageIO support.
+		///
+		/// Where `image<T>::read` converts all channels to one type this inspects the per-channel
+		/// formats of the file (e.g. exr files may store half color next to float depth), groups
+		/// the channels by format and reads each group through the typed reader at exactly that
+		/// precision. The resulting channels are stored side by side in their original file order.
+		///
+		/// \param filepath The path to the image file, must be a format supported by OpenImageIO.
+		/// \param subimage The subimage to read (default: 0). Only relevant for multi-part images.
+		/// \param compression_codec The compression codec to use (default: LZ4).
+		/// \param compression_level The compression level (default: 9).
+		/// \param block_size The size of the blocks stored inside the chunks, see `image<T>::read`.
+		/// \param chunk_size The size of each individual chunk, see `image<T>::read`. Must be a
+		///					  multiple of the size of the largest channel format in the file.
+		/// \param scratch_memory_budget Upper bound in bytes for the transient scratch buffers of
+		///								  each per-format read pass, see `image<T>::read`.
+		/// \return A dynamic image holding each channel at its native precision.
+		/// \throws std::invalid_argument if the file does not exist or the subimage is invalid.
+		/// \throws std::runtime_error if the file stores a channel format the library cannot represent.
+		static dynamic_image read(
+			std::filesystem::path filepath,
+			int subimage = 0,
+			enums::codec compression_codec = enums::codec::lz4,
+			size_t compression_level = 9,
+			size_t block_size = s_default_blocksize,
+			size_t chunk_size = s_default_chunksize,
+			size_t scratch_memory_budget = s_default_read_scratch_budget
+		)
+		{
+			_COMPRESSED_PROFILE_FUNCTION();
+			auto input_ptr = OIIO::ImageInput::open(filepath.string());
+			if (!input_ptr)
+			{
+				throw std::invalid_argument(std::format("File {} does not exist on disk", filepath.string()));
+			}
+			if (!input_ptr->seek_subimage(subimage, 0))
+			{
+				throw std::invalid_argument(
+					std::format("File does not have a subimage {}, cannot seek to it", subimage)
+				);
+			}
+			const auto& spec = input_ptr->spec();
+
+			// Per-channel native formats, files without per-channel information store everything
+			// in the image-wide format.
+			std::vector<OIIO::TypeDesc> formats(spec.channelformats.begin(), spec.channelformats.end());
+			if (formats.empty())
+			{
+				formats.assign(spec.nchannels, spec.format);
+			}
+
+			dynamic_image result(static_cast<size_t>(spec.width), static_cast<size_t>(spec.height));
+			result.m_ChannelNames = spec.channelnames;
+			result.m_Metadata = image<float>::read_oiio_metadata(spec);
+
+			// Group the channel indices by format, read each group at its precision through the
+			// typed reader and slot the channels back into their original file order.
+			std::map<int, std::vector<int>> format_groups{};
+			for (int idx = 0; idx < spec.nchannels; ++idx)
+			{
+				format_groups[static_cast<int>(formats[idx].basetype)].push_back(idx);
+			}
+
+			std::vector<std::optional<channel_variant>> slots(formats.size());
+			for (const auto& [basetype, indices] : format_groups)
+			{
+				dispatch_format(OIIO::TypeDesc(static_cast<OIIO::TypeDesc::BASETYPE>(basetype)), [&]<typename T>(T)
+				{
+					auto group_input = OIIO::ImageInput::open(filepath.string());
+					if (!group_input)
+					{
+						throw std::invalid_argument(std::format("File {} does not exist on disk", filepath.string()));
+					}
+					auto img = image<T>::read(
+						std::move(group_input),
+						indices,
+						subimage,
+						compression_codec,
+						compression_level,
+						block_size,
+						chunk_size,
+						scratch_memory_budget
+					);
+					auto& group_channels = img.channels();
+					for (size_t pos = 0; pos < indices.size(); ++pos)
+					{
+						slots[indices[pos]].emplace(std::move(group_channels[pos]));
+					}
+				});
+			}
+
+			for (auto& slot : slots)
+			{
+				result.m_Channels.push_back(std::move(slot.value()));
+			}
+			return result;
+		}
+
+#endif // COMPRESSED_IMAGE_OIIO_AVAILABLE
+
+
+		/// Adds a channel to the image, the channel may be of any supported element type.
+		///
+		/// This method moves the provided channel into the image's internal storage, adding it to
+		/// the list of channels. If the image holds no channels yet and was default-constructed its
+		/// dimensions are adopted from the channel.
+		///
+		/// \tparam T The element type of the channel.
+		/// \param _channel The channel to be added to the image.
+		/// \param name (Optional) Channel name of the channel to be inserted. If no channel names are set this argument is ignored.
+		/// \throws std::invalid_argument if the channel dimensions do not match the image.
+		template <typename T>
+		void add_channel(compressed::channel<T> _channel, std::optional<std::string> name = std::nullopt)
+		{
+			if (m_Channels.empty() && m_Width == 0 && m_Height == 0)
+			{
+				m_Width = _channel.width();
+				m_Height = _channel.height();
+			}
+
+			if (_channel.width() != this->width())
+			{
+				throw std::invalid_argument(
+					std::format(
+						"Cannot add channel '{}' to the image as its width does not match that of the image."
+						" Expected {:L} pixels but instead got {:L} pixels",
+						name.value_or(""),
+						this->width(), _channel.width()
+					)
+				);
+			}
+			if (_channel.height() != this->height())
+			{
+				throw std::invalid_argument(
+					std::format(
+						"Cannot add channel '{}' to the image as its height does not match that of the image."
+						" Expected {:L} pixels but instead got {:L} pixels",
+						name.value_or(""),
+						this->height(), _channel.height()
+					)
+				);
+			}
+
+			if (name.has_value() && m_ChannelNames.size() == m_Channels.size())
+			{
+				m_ChannelNames.push_back(name.value());
+			}
+			else if (m_ChannelNames.size() > 0)
+			{
+				m_ChannelNames.push_back(name.value_or(""));
+			}
+
+			m_Channels.push_back(channel_variant(std::move(_channel)));
+		}
+
+		/// Remove a channel by its index.
+		///
+		/// \param index The index of the channel to remove.
+		/// \throws std::out_of_range if the index is out of bounds.
+		void remove_channel(size_t index)
+		{
+			if (index >= m_Channels.size())
+			{
+				throw std::out_of_range("Channel index out of range");
+			}
+			m_Channels.erase(m_Channels.begin() + index);
+			if (index < m_ChannelNames.size())
+			{
+				m_ChannelNames.erase(m_ChannelNames.begin() + index);
+			}
+		}
+
+		/// Remove a channel by its name.
+		///
+		/// \param name The name of the channel to remove.
+		/// \throws std::invalid_argument if the channel name is invalid.
+		void remove_channel(const std::string_view name)
+		{
+			this->remove_channel(this->get_channel_offset(name));
+		}
+
+
+		// ---------------------------------------------------------------------------------------------------------------------
+		// Accessors
+		// ---------------------------------------------------------------------------------------------------------------------
+
+		/// Retrieves a reference to a channel by its index.
+		///
+		/// \param index The index of the channel to retrieve.
+		/// \return A reference to the requested channel variant.
+		/// \throws std::out_of_range if the index is out of bounds.
+		channel_variant& channel(size_t index)
+		{
+			if (index >= m_Channels.size())
+			{
+				throw std::out_of_range("Channel index out of range");
+			}
+			return m_Channels[index];
+		}
+
+		/// Retrieves a reference to a channel by its name.
+		///
+		/// \param name The name of the channel to retrieve.
+		/// \return A reference to the requested channel variant.
+		/// \throws std::invalid_argument if the channel name is invalid.
+		channel_variant& channel(const std::string_view name)
+		{
+			return m_Channels[this->get_channel_offset(name)];
+		}
+
+		/// Retrieves a reference to a channel by its index as a concrete element type.
+		///
+		/// \tparam T The element type the channel is expected to be stored as.
+		/// \param index The index of the channel to retrieve.
+		/// \return A reference to the requested typed channel.
+		/// \throws std::out_of_range if the index is out of bounds.
+		/// \throws std::invalid_argument if the channel is stored as a different element type.
+		template <typename T>
+		compressed::channel<T>& channel_as(size_t index)
+		{
+			auto* typed = std::get_if<compressed::channel<T>>(&this->channel(index));
+			if (!typed)
+			{
+				throw std::invalid_argument(
+					std::format(
+						"Channel {} is not stored as the requested element type, it holds {} byte elements",
+						index,
+						this->channel_element_size(index)
+					)
+				);
+			}
+			return *typed;
+		}
+
+		/// Retrieves a reference to a channel by its name as a concrete element type.
+		///
+		/// \tparam T The element type the channel is expected to be stored as.
+		/// \param name The name of the channel to retrieve.
+		/// \return A reference to the requested typed channel.
+		/// \throws std::invalid_argument if the channel name is invalid or the channel is stored
+		///			as a different element type.
+		template <typename T>
+		compressed::channel<T>& channel_as(const std::string_view name)
+		{
+			return this->channel_as<T>(this->get_channel_offset(name));
+		}
+
+		/// The channels stored on the image, one variant per channel.
+		std::vector<channel_variant>& channels() noexcept
+		{
+			return m_Channels;
+		}
+
+		/// The channels stored on the image, one variant per channel.
+		const std::vector<channel_variant>& channels() const noexcept
+		{
+			return m_Channels;
+		}
+
+		/// The element size in bytes a channel is stored at.
+		///
+		/// \param index The index of the channel to query.
+		/// \return The sizeof of the channel's element type.
+		/// \throws std::out_of_range if the index is out of bounds.
+		size_t channel_element_size(size_t index) const
+		{
+			if (index >= m_Channels.size())
+			{
+				throw std::out_of_range("Channel index out of range");
+			}
+			return std::visit([]<typename ChannelT>([[maybe_unused]] const ChannelT& channel)
+			{
+				return sizeof(typename ChannelT::value_type);
+			}, m_Channels[index]);
+		}
+
+		/// Retrieve the logical index of the given channel.
+		///
+		/// \param channelname The name of the channel to search for.
+		/// \return The index of the channel if found.
+		/// \throws std::invalid_argument if the channel is not available.
+		size_t get_channel_offset(const std::string_view channelname) const
+		{
+			for (size_t i = 0; i < m_ChannelNames.size(); ++i)
+			{
+				if (m_ChannelNames[i] == channelname)
+				{
+					return i;
+				}
+			}
+			throw std::invalid_argument(std::format("Unknown channelname '{}' encountered", channelname));
+		}
+
+		/// Width of the Image
+		size_t width() const noexcept
+		{
+			return m_Width;
+		}
+
+		/// Height of the image
+		size_t height() const noexcept
+		{
+			return m_Height;
+		}
+
+		/// Total number of channels in the image
+		size_t num_channels() const noexcept
+		{
+			return m_Channels.size();
+		}
+
+		/// Names of the channels stored on the image, stored in the same order as the logical indices.
+		std::vector<std::string> channelnames() const noexcept
+		{
+			return m_ChannelNames;
+		}
+
+		/// Set the channelnames according to their logical indices.
+		void channelnames(std::vector<std::string> _channelnames)
+		{
+			if (_channelnames.size() != m_Channels.size())
+			{
+				throw std::invalid_argument(std::format(
+					"Invalid number of arguments received for setting channelnames. Expected vector size to be exactly {} but instead got {}",
+					m_Channels.size(),
+					_channelnames.size()
+				).c_str()
+				);
+			}
+			m_ChannelNames = _channelnames;
+		}
+
+		/// Return the compression ratio over all channels.
+		double compression_ratio() const noexcept
+		{
+			size_t total_uncompressed = 1;
+			size_t total_compressed = 1;
+			for (const auto& channel : m_Channels)
+			{
+				std::visit([&]<typename ChannelT>(const ChannelT& typed)
+				{
+					total_compressed += typed.compressed_bytes();
+					total_uncompressed += typed.uncompressed_size() * sizeof(typename ChannelT::value_type);
+				}, channel);
+			}
+			return static_cast<double>(total_uncompressed) / total_compressed;
+		}
+
+		/// Update the number of threads each channel uses for compression and decompression.
+		///
+		/// \param nthreads The number of threads to use per channel.
+		void update_nthreads(size_t nthreads)
+		{
+			for (auto& channel : m_Channels)
+			{
+				std::visit([&](auto& typed)
+				{
+					typed.update_nthreads(nthreads);
+				}, channel);
+			}
+		}
+
+		/// Set the metadata associated with this image.
+		void metadata(const json_ordered& _metadata) noexcept
+		{
+			m_Metadata = _metadata;
+		}
+
+		/// Retrieve the metadata associated with this image.
+		json_ordered& metadata() noexcept
+		{
+			return m_Metadata;
+		}
+
+		/// Retrieve the metadata associated with this image.
+		const json_ordered& metadata() const noexcept
+		{
+			return m_Metadata;
+		}
+
+	private:
+
+		std::vector<channel_variant> m_Channels{};
+		std::vector<std::string> m_ChannelNames{};
+		size_t m_Width = 0;
+		size_t m_Height = 0;
+		json_ordered m_Metadata{};
+
+#ifdef COMPRESSED_IMAGE_OIIO_AVAILABLE
+
+		/// Invoke `func` with a default-constructed value of the element type matching `format`.
+		///
+		/// \throws std::runtime_error if the format has no matching element type in `channel_variant`.
+		template <typename Func>
+		static void dispatch_format(const OIIO::TypeDesc& format, Func&& func)
+		{
+			switch (format.basetype)
+			{
+			case OIIO::TypeDesc::UINT8:		func(uint8_t{});	break;
+			case OIIO::TypeDesc::UINT16:	func(uint16_t{});	break;
+			case OIIO::TypeDesc::UINT32:	func(uint32_t{});	break;
+			case OIIO::TypeDesc::HALF:		func(half{});		break;
+			case OIIO::TypeDesc::FLOAT:		func(float{});		break;
+			default:
+				throw std::runtime_error(
+					std::format("Unsupported channel format '{}' encountered while reading a dynamic image", format.c_str())
+				);
+			}
+		}
+
+#endif // COMPRESSED_IMAGE_OIIO_AVAILABLE
+
+	};
+
+} // NAMESPACE_COMPRESSED_IMAGE
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <string_view>
+
 #include "macros.h"
 
 #ifdef COMPRESSED_IMAGE_OIIO_AVAILABLE
@@ -24,6 +26,45 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 		};
 
 
+		/// Enum representing the pre-compression filter applied to the data.
+		///
+		/// Filters reorder the bytes before the codec sees them to make the data more compressible,
+		/// they are lossless and the applied filter is recorded in each chunk so decoding picks the
+		/// right inverse automatically.
+		enum class filter
+		{
+			shuffle,		///< The generic blosc2 byte shuffle, groups the n-th byte of every element together.
+			half_shuffle,	///< Byte shuffle with a delta-encoded high-byte plane, tuned for the sign/exponent/mantissa
+							///< layout of 16-bit floats. Only valid for 2-byte element types.
+		};
+
+
+		/// Get a human-readable name for the given codec, e.g. for statistics or log output.
+		constexpr std::string_view to_string(codec _codec)
+		{
+			switch (_codec)
+			{
+			case codec::blosclz:	return "blosclz";
+			case codec::lz4:		return "lz4";
+			case codec::lz4hc:		return "lz4hc";
+			case codec::zstd:		return "zstd";
+			}
+			return "unknown";
+		}
+
+
+		/// Get a human-readable name for the given filter, e.g. for statistics or log output.
+		constexpr std::string_view to_string(filter _filter)
+		{
+			switch (_filter)
+			{
+			case filter::shuffle:		return "shuffle";
+			case filter::half_shuffle:	return "half_shuffle";
+			}
+			return "unknown";
+		}
+
+
 #ifdef COMPRESSED_IMAGE_OIIO_AVAILABLE
 
 		/// Get a OpenImageIO TypeDesc based on the given template parameter returning OIIO::TypeDesc::Unknown
@@ -9,12 +9,14 @@
 #include <execution>
 #include <tuple>
 #include <filesystem>
+#include <future>
 
 #include <blosc2.h>
 #include <nlohmann/json.hpp>
 
 #ifdef COMPRESSED_IMAGE_OIIO_AVAILABLE
 #include <OpenImageIO/imageio.h>
+#include <OpenImageIO/filesystem.h>
 #endif
 
 #include "macros.h"
@@ -28,6 +30,9 @@
 #include "image_algo.h"
 #include "detail/oiio_util.h"
 #include "detail/scoped_timer.h"
+#include "detail/serialization.h"
+#include "detail/buffer_pool.h"
+#include "detail/thread_budget.h"
 
 #include "iterators/iterator.h"
 
@@ -325,6 +330,242 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 		}
 
 
+		/// \brief Save the image to disk in the native compressed serialization format.
+		///
+		/// The already-compressed blosc2 chunks are written verbatim alongside the channelnames and
+		/// metadata, so saving is pure sequential I/O without any codec work. The resulting file can
+		/// be restored with `image<T>::load` which equally performs no decompression or recompression.
+		///
+		/// The file is written in native byte order and is not intended as an interchange format
+		/// across differently-ordered machines. For interchange use `image<T>::read` compatible
+		/// formats via OpenImageIO instead.
+		///
+		/// Example:
+		/// \code{.cpp}
+		/// compressed::image<float> my_image = ...;
+		/// my_image.save("image.cimg");
+		/// auto restored = compressed::image<float>::load("image.cimg");
+		/// \endcode
+		///
+		/// \param filepath The file path to save the image to, gets overwritten if it already exists.
+		/// \throws std::runtime_error if the file cannot be opened for writing or any channel uses
+		///			the tiled chunk layout which the serialization format cannot represent yet.
+		void save(std::filesystem::path filepath) const
+		{
+			_COMPRESSED_PROFILE_FUNCTION();
+			namespace ser = detail::serialization;
+
+			// The chunks are written verbatim and the loader assumes scanline-strip order, a tiled
+			// channel would silently come back with its tiles reinterpreted as strips.
+			for (const auto& channel : m_Channels)
+			{
+				if (channel.is_tiled())
+				{
+					throw std::runtime_error(
+						"Unable to save an image containing channels with the tiled chunk layout, the serialization"
+						" format does not represent tile geometry yet"
+					);
+				}
+			}
+
+			std::ofstream stream(filepath, std::ios::binary | std::ios::trunc);
+			if (!stream)
+			{
+				throw std::runtime_error(std::format("Unable to open file {} for writing", filepath.string()));
+			}
+
+			stream.write(ser::s_magic.data(), ser::s_magic.size());
+			ser::write_scalar<uint32_t>(stream, ser::s_version);
+			ser::write_scalar<uint32_t>(stream, static_cast<uint32_t>(sizeof(T)));
+			ser::write_scalar<char>(stream, ser::type_tag<T>());
+
+			// The structural information is stored as a json header so the format can grow fields
+			// without invalidating old readers.
+			json_ordered header{};
+			header["width"] = m_Width;
+			header["height"] = m_Height;
+			header["channelnames"] = m_ChannelNames;
+			header["metadata"] = m_Metadata;
+			ser::write_string(stream, header.dump());
+
+			ser::write_scalar<uint64_t>(stream, m_Channels.size());
+			for (const auto& channel : m_Channels)
+			{
+				ser::write_scalar<uint8_t>(stream, static_cast<uint8_t>(channel.compression()));
+				ser::write_scalar<uint8_t>(stream, channel.compression_level());
+				ser::write_scalar<uint64_t>(stream, channel.block_size());
+				ser::write_scalar<uint64_t>(stream, channel.chunk_size());
+
+				std::visit([&](const auto& schunk)
+					{
+						using schunk_t = std::remove_cvref_t<decltype(schunk)>;
+						if constexpr (!std::is_same_v<schunk_t, blosc2::lazy_schunk<T>>)
+						{
+							// Both the heap-backed and the mmap-backed schunk store plain compressed
+							// chunks, on load these always materialize as a heap-backed schunk.
+							ser::write_scalar<uint8_t>(stream, static_cast<uint8_t>(ser::schunk_kind::schunk));
+							ser::write_scalar<uint64_t>(stream, schunk.num_chunks());
+							for (auto idx : std::views::iota(size_t{ 0 }, schunk.num_chunks()))
+							{
+								ser::write_bytes(stream, std::span<const std::byte>(schunk.compressed_chunk(idx)));
+							}
+						}
+						else
+						{
+							ser::write_scalar<uint8_t>(stream, static_cast<uint8_t>(ser::schunk_kind::lazy_schunk));
+							ser::write_scalar<uint64_t>(stream, schunk.num_chunks());
+							for (auto idx : std::views::iota(size_t{ 0 }, schunk.num_chunks()))
+							{
+								ser::write_scalar<uint8_t>(stream, schunk.is_lazy(idx) ? 1 : 0);
+								if (schunk.is_lazy(idx))
+								{
+									// A lazy chunk was never materialized so it is fully described by its
+									// fill value and element count, no compressed bytes exist for it.
+									ser::write_scalar<T>(stream, schunk.lazy_value(idx));
+									ser::write_scalar<uint64_t>(stream, schunk.chunk_elements(idx));
+								}
+								else
+								{
+									ser::write_bytes(stream, std::span<const std::byte>(schunk.compressed_chunk(idx)));
+								}
+							}
+						}
+					}, channel.schunk());
+			}
+
+			if (!stream)
+			{
+				throw std::runtime_error(std::format("Failure while writing compressed-image file {}", filepath.string()));
+			}
+		}
+
+
+		/// \brief Load an image previously written with `image<T>::save`.
+		///
+		/// The compressed chunks are read back verbatim so loading performs no decompression or
+		/// recompression, making a save-load roundtrip pure sequential I/O.
+		///
+		/// \param filepath The file path to load the image from.
+		/// \return The restored image including channelnames and metadata.
+		/// \throws std::runtime_error if the file does not exist, is not a native compressed-image
+		///							   file or was written with an incompatible element type.
+		static image load(std::filesystem::path filepath)
+		{
+			_COMPRESSED_PROFILE_FUNCTION();
+			namespace ser = detail::serialization;
+
+			std::ifstream stream(filepath, std::ios::binary);
+			if (!stream)
+			{
+				throw std::runtime_error(std::format("Unable to open file {} for reading", filepath.string()));
+			}
+
+			std::array<char, 8> magic{};
+			stream.read(magic.data(), magic.size());
+			if (!stream || magic != ser::s_magic)
+			{
+				throw std::runtime_error(
+					std::format("File {} is not a native compressed-image file (magic mismatch)", filepath.string())
+				);
+			}
+
+			auto version = ser::read_scalar<uint32_t>(stream);
+			if (version != ser::s_version)
+			{
+				throw std::runtime_error(
+					std::format(
+						"File {} was written with serialization format version {} but this library only"
+						" supports version {}", filepath.string(), version, ser::s_version
+					)
+				);
+			}
+
+			auto typesize = ser::read_scalar<uint32_t>(stream);
+			auto tag = ser::read_scalar<char>(stream);
+			if (typesize != sizeof(T) || tag != ser::type_tag<T>())
+			{
+				throw std::runtime_error(
+					std::format(
+						"File {} stores elements of type '{}{}' which does not match the requested type '{}{}'",
+						filepath.string(), tag, typesize * 8, ser::type_tag<T>(), sizeof(T) * 8
+					)
+				);
+			}
+
+			auto header = json_ordered::parse(ser::read_string(stream));
+			size_t width = header.at("width").template get<size_t>();
+			size_t height = header.at("height").template get<size_t>();
+			auto channel_names = header.at("channelnames").template get<std::vector<std::string>>();
+
+			auto num_channels = ser::read_scalar<uint64_t>(stream);
+			std::vector<compressed::channel<T>> channels{};
+			channels.reserve(num_channels);
+			for ([[maybe_unused]] auto channel_idx : std::views::iota(uint64_t{ 0 }, num_channels))
+			{
+				auto codec = ser::read_scalar<uint8_t>(stream);
+				auto compression_level = ser::read_scalar<uint8_t>(stream);
+				auto block_size = ser::read_scalar<uint64_t>(stream);
+				auto chunk_size = ser::read_scalar<uint64_t>(stream);
+				auto kind = ser::read_scalar<uint8_t>(stream);
+				auto num_chunks = ser::read_scalar<uint64_t>(stream);
+
+				if (kind == static_cast<uint8_t>(ser::schunk_kind::schunk))
+				{
+					auto schunk = blosc2::schunk<T>(block_size, chunk_size);
+					for ([[maybe_unused]] auto chunk_idx : std::views::iota(uint64_t{ 0 }, num_chunks))
+					{
+						schunk.append_chunk(ser::read_bytes(stream));
+					}
+					channels.push_back(compressed::channel<T>(
+						blosc2::schunk_var<T>(std::move(schunk)),
+						width,
+						height,
+						static_cast<enums::codec>(codec),
+						compression_level
+					));
+				}
+				else if (kind == static_cast<uint8_t>(ser::schunk_kind::lazy_schunk))
+				{
+					auto schunk = blosc2::lazy_schunk<T>(T{}, 0, block_size, chunk_size);
+					for ([[maybe_unused]] auto chunk_idx : std::views::iota(uint64_t{ 0 }, num_chunks))
+					{
+						auto is_lazy = ser::read_scalar<uint8_t>(stream);
+						if (is_lazy)
+						{
+							auto value = ser::read_scalar<T>(stream);
+							auto num_elements = ser::read_scalar<uint64_t>(stream);
+							schunk.append_lazy_chunk(value, num_elements);
+						}
+						else
+						{
+							schunk.append_chunk(ser::read_bytes(stream));
+						}
+					}
+					channels.push_back(compressed::channel<T>(
+						blosc2::schunk_var<T>(std::move(schunk)),
+						width,
+						height,
+						static_cast<enums::codec>(codec),
+						compression_level
+					));
+				}
+				else
+				{
+					throw std::runtime_error(
+						std::format(
+							"File {} holds an unknown schunk kind {} for channel {}, the file is likely corrupt",
+							filepath.string(), kind, channel_idx
+						)
+					);
+				}
+			}
+
+			auto result = image(std::move(channels), width, height, std::move(channel_names));
+			result.metadata(header.at("metadata").template get<json_ordered>());
+			return result;
+		}
+
+
 #ifdef COMPRESSED_IMAGE_OIIO_AVAILABLE
 
 		/// \brief Reads a compressed image from a file using OpenImageIO and compresses it during reading.
@@ -356,6 +597,12 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 		///					  This should be tweaked to be no larger than the size of the usual images you are expecting  
 		///					  to compress for optimal performance but this could be upped which might give better compression
 		///					  ratios. Must be a multiple of sizeof(T).
+		/// \param scratch_memory_budget Upper bound in bytes for the transient scratch buffers of this read
+		///								  (default: 256MB). Contiguous channel ranges whose scratch would blow
+		///								  past the budget are read in several narrower passes, trading a few
+		///								  extra read calls for a bounded peak allocation. A single channel's
+		///								  worth of scratch is the floor, the actual peak is reported as
+		///								  "read_scratch_peak_bytes" by `compression_statistics`.
 		/// \return A compressed image instance.
 		static image read(
 			std::filesystem::path filepath,
@@ -363,7 +610,8 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			enums::codec compression_codec = enums::codec::lz4,
 			size_t compression_level = 9,
 			size_t block_size = s_default_blocksize,
-			size_t chunk_size = s_default_chunksize
+			size_t chunk_size = s_default_chunksize,
+			size_t scratch_memory_budget = s_default_read_scratch_budget
 		)
 		{
 			// Initialize the OIIO primitives
@@ -392,7 +640,8 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 				compression_codec,
 				compression_level,
 				block_size,
-				chunk_size
+				chunk_size,
+				scratch_memory_budget
 			);
 		}
 
@@ -460,6 +709,12 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 		///					  This should be tweaked to be no larger than the size of the usual images you are expecting  
 		///					  to compress for optimal performance but this could be upped which might give better compression
 		///					  ratios. Must be a multiple of sizeof(T).
+		/// \param scratch_memory_budget Upper bound in bytes for the transient scratch buffers of this read
+		///								  (default: 256MB). Contiguous channel ranges whose scratch would blow
+		///								  past the budget are read in several narrower passes, trading a few
+		///								  extra read calls for a bounded peak allocation. A single channel's
+		///								  worth of scratch is the floor, the actual peak is reported as
+		///								  "read_scratch_peak_bytes" by `compression_statistics`.
 		/// \return A compressed image instance.
 		template <typename PostProcess>
 			requires std::invocable<std::remove_reference_t<PostProcess>, size_t, std::span<T>>
@@ -470,7 +725,8 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			enums::codec compression_codec = enums::codec::lz4,
 			size_t compression_level = 9,
 			size_t block_size = s_default_blocksize,
-			size_t chunk_size = s_default_chunksize
+			size_t chunk_size = s_default_chunksize,
+			size_t scratch_memory_budget = s_default_read_scratch_budget
 		)
 		{
 			_COMPRESSED_PROFILE_FUNCTION();
@@ -501,7 +757,8 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 				compression_codec,
 				compression_level,
 				block_size,
-				chunk_size
+				chunk_size,
+				scratch_memory_budget
 			);
 		}
 
@@ -550,6 +807,12 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 		///					  This should be tweaked to be no larger than the size of the usual images you are expecting  
 		///					  to compress for optimal performance but this could be upped which might give better compression
 		///					  ratios. Must be a multiple of sizeof(T).
+		/// \param scratch_memory_budget Upper bound in bytes for the transient scratch buffers of this read
+		///								  (default: 256MB). Contiguous channel ranges whose scratch would blow
+		///								  past the budget are read in several narrower passes, trading a few
+		///								  extra read calls for a bounded peak allocation. A single channel's
+		///								  worth of scratch is the floor, the actual peak is reported as
+		///								  "read_scratch_peak_bytes" by `compression_statistics`.
 		/// \return A compressed image instance.
 		static image read(
 			std::unique_ptr<OIIO::ImageInput> input_ptr,
@@ -558,7 +821,8 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			enums::codec compression_codec = enums::codec::lz4,
 			size_t compression_level = 9,
 			size_t block_size = s_default_blocksize,
-			size_t chunk_size = s_default_chunksize
+			size_t chunk_size = s_default_chunksize,
+			size_t scratch_memory_budget = s_default_read_scratch_budget
 		)
 		{
 			_COMPRESSED_PROFILE_FUNCTION();
@@ -588,7 +852,8 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 				compression_codec,
 				compression_level,
 				block_size,
-				chunk_size
+				chunk_size,
+				scratch_memory_budget
 			);
 		}
 
@@ -671,6 +936,12 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 		///					  This should be tweaked to be no larger than the size of the usual images you are expecting  
 		///					  to compress for optimal performance but this could be upped which might give better compression
 		///					  ratios. Must be a multiple of sizeof(T).
+		/// \param scratch_memory_budget Upper bound in bytes for the transient scratch buffers of this read
+		///								  (default: 256MB). Contiguous channel ranges whose scratch would blow
+		///								  past the budget are read in several narrower passes, trading a few
+		///								  extra read calls for a bounded peak allocation. A single channel's
+		///								  worth of scratch is the floor, the actual peak is reported as
+		///								  "read_scratch_peak_bytes" by `compression_statistics`.
 		/// \return A compressed image instance.
 		template <typename PostProcess>
 			requires std::invocable<std::remove_reference_t<PostProcess>, size_t, std::span<T>>
@@ -682,7 +953,8 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			enums::codec compression_codec = enums::codec::lz4,
 			size_t compression_level = 9,
 			size_t block_size = s_default_blocksize,
-			size_t chunk_size = s_default_chunksize
+			size_t chunk_size = s_default_chunksize,
+			size_t scratch_memory_budget = s_default_read_scratch_budget
 		)
 		{
 			_COMPRESSED_PROFILE_FUNCTION();
@@ -713,7 +985,8 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 				compression_codec,
 				compression_level,
 				block_size,
-				chunk_size
+				chunk_size,
+				scratch_memory_budget
 			);
 		}
 
@@ -763,6 +1036,12 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 		///					  This should be tweaked to be no larger than the size of the usual images you are expecting  
 		///					  to compress for optimal performance but this could be upped which might give better compression
 		///					  ratios. Must be a multiple of sizeof(T).
+		/// \param scratch_memory_budget Upper bound in bytes for the transient scratch buffers of this read
+		///								  (default: 256MB). Contiguous channel ranges whose scratch would blow
+		///								  past the budget are read in several narrower passes, trading a few
+		///								  extra read calls for a bounded peak allocation. A single channel's
+		///								  worth of scratch is the floor, the actual peak is reported as
+		///								  "read_scratch_peak_bytes" by `compression_statistics`.
 		/// \return A compressed image instance.
 		static image read(
 			std::unique_ptr<OIIO::ImageInput> input_ptr,
@@ -771,7 +1050,8 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			enums::codec compression_codec = enums::codec::lz4,
 			size_t compression_level = 9,
 			size_t block_size = s_default_blocksize,
-			size_t chunk_size = s_default_chunksize
+			size_t chunk_size = s_default_chunksize,
+			size_t scratch_memory_budget = s_default_read_scratch_budget
 		)
 		{
 			_COMPRESSED_PROFILE_FUNCTION();
@@ -783,7 +1063,8 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 				compression_codec,
 				compression_level,
 				block_size,
-				chunk_size
+				chunk_size,
+				scratch_memory_budget
 			);
 		}
 
@@ -868,6 +1149,12 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 		///					  This should be tweaked to be no larger than the size of the usual images you are expecting  
 		///					  to compress for optimal performance but this could be upped which might give better compression
 		///					  ratios. Must be a multiple of sizeof(T).
+		/// \param scratch_memory_budget Upper bound in bytes for the transient scratch buffers of this read
+		///								  (default: 256MB). Contiguous channel ranges whose scratch would blow
+		///								  past the budget are read in several narrower passes, trading a few
+		///								  extra read calls for a bounded peak allocation. A single channel's
+		///								  worth of scratch is the floor, the actual peak is reported as
+		///								  "read_scratch_peak_bytes" by `compression_statistics`.
 		/// \return A compressed image instance.
 		template <typename PostProcess>
 			requires std::invocable<std::remove_reference_t<PostProcess>, size_t, std::span<T>>
@@ -879,7 +1166,8 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			enums::codec compression_codec = enums::codec::lz4,
 			size_t compression_level = 9,
 			size_t block_size = s_default_blocksize,
-			size_t chunk_size = s_default_chunksize
+			size_t chunk_size = s_default_chunksize,
+			size_t scratch_memory_budget = s_default_read_scratch_budget
 			)
 		{
 			_COMPRESSED_PROFILE_FUNCTION();
@@ -891,10 +1179,149 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 				compression_codec,
 				compression_level,
 				block_size,
-				chunk_size
+				chunk_size,
+				scratch_memory_budget
+			);
+		}
+
+
+		/// \brief Reads a compressed image straight out of an in-memory encoded blob.
+		///
+		/// Requires CompressedImage to have been compiled with OpenImageIO support.
+		///
+		/// Identical to `read` from a filepath except that the encoded bytes (e.g. an EXR pulled
+		/// from object storage) are decoded through an OpenImageIO `IOMemReader` proxy, so the
+		/// blob goes straight into compressed chunks without ever touching local disk. The buffer
+		/// only has to stay alive for the duration of the call.
+		///
+		/// Example:
+		/// \code{.cpp}
+		/// std::vector<std::byte> blob = fetch_from_object_storage("asset.exr");
+		/// auto img = compressed::image<uint8_t>::read_from_memory(std::span<const std::byte>(blob), "asset.exr");
+		/// \endcode
+		///
+		/// \param buffer The encoded image bytes, exactly as they would appear on disk.
+		/// \param filename_hint A pseudo filename whose extension drives OpenImageIO's format
+		///						 detection (e.g. "blob.exr"), nothing is read from or written to
+		///						 this path.
+		/// \param subimage The subimage to extract the channels from (default: 0). Only relevant for multi-part images.
+		/// \param compression_codec The compression codec to use (default: LZ4).
+		/// \param compression_level The compression level (default: 9).
+		/// \param block_size The size of the blocks stored inside the chunks, defaults to 32KB.
+		/// \param chunk_size The size of each individual chunk, defaults to 4MB. Must be a multiple of sizeof(T).
+		/// \param scratch_memory_budget Upper bound in bytes for the transient scratch buffers of this read, see `read`.
+		/// \return A compressed image instance.
+		static image read_from_memory(
+			std::span<const std::byte> buffer,
+			std::string_view filename_hint,
+			int subimage = 0,
+			enums::codec compression_codec = enums::codec::lz4,
+			size_t compression_level = 9,
+			size_t block_size = s_default_blocksize,
+			size_t chunk_size = s_default_chunksize,
+			size_t scratch_memory_budget = s_default_read_scratch_budget
+		)
+		{
+			_COMPRESSED_PROFILE_FUNCTION();
+			// The reader never writes into the buffer, the cast only bridges OIIO's non-const
+			// proxy interface.
+			auto memreader = OIIO::Filesystem::IOMemReader(
+				const_cast<void*>(static_cast<const void*>(buffer.data())), buffer.size()
+			);
+			auto input_ptr = OIIO::ImageInput::open(std::string(filename_hint), nullptr, &memreader);
+			if (!input_ptr)
+			{
+				throw std::invalid_argument(
+					std::format(
+						"Unable to open the in-memory image blob as '{}', the format could not be recognized",
+						filename_hint
+					)
+				);
+			}
+
+			auto res = input_ptr->seek_subimage(subimage, 0);
+			if (!res)
+			{
+				throw std::invalid_argument(
+					std::format(
+						"The in-memory image blob does not have a subimage {}, cannot seek to it", subimage
+					)
+				);
+			}
+			const OIIO::ImageSpec& spec = input_ptr->spec();
+
+			// The proxy lives on this stack frame and read_impl consumes the input synchronously,
+			// so the pointer OIIO holds onto stays valid for the whole decode.
+			return image<T>::read_impl(
+				std::move(input_ptr),
+				spec.channelnames,
+				std::nullopt,
+				subimage,
+				compression_codec,
+				compression_level,
+				block_size,
+				chunk_size,
+				scratch_memory_budget
 			);
 		}
 
+		/// \brief Reads a compressed image straight out of an in-memory encoded blob, applying a
+		/// postprocess to every chunk between decode and compression.
+		///
+		/// See the overload without `postprocess` for the in-memory semantics and the
+		/// postprocessing `read` overloads for what the functor receives.
+		template <typename PostProcess>
+			requires std::invocable<std::remove_reference_t<PostProcess>, size_t, std::span<T>>
+		static image read_from_memory(
+			std::span<const std::byte> buffer,
+			PostProcess&& postprocess,
+			std::string_view filename_hint,
+			int subimage = 0,
+			enums::codec compression_codec = enums::codec::lz4,
+			size_t compression_level = 9,
+			size_t block_size = s_default_blocksize,
+			size_t chunk_size = s_default_chunksize,
+			size_t scratch_memory_budget = s_default_read_scratch_budget
+		)
+		{
+			_COMPRESSED_PROFILE_FUNCTION();
+			auto memreader = OIIO::Filesystem::IOMemReader(
+				const_cast<void*>(static_cast<const void*>(buffer.data())), buffer.size()
+			);
+			auto input_ptr = OIIO::ImageInput::open(std::string(filename_hint), nullptr, &memreader);
+			if (!input_ptr)
+			{
+				throw std::invalid_argument(
+					std::format(
+						"Unable to open the in-memory image blob as '{}', the format could not be recognized",
+						filename_hint
+					)
+				);
+			}
+
+			auto res = input_ptr->seek_subimage(subimage, 0);
+			if (!res)
+			{
+				throw std::invalid_argument(
+					std::format(
+						"The in-memory image blob does not have a subimage {}, cannot seek to it", subimage
+					)
+				);
+			}
+			const OIIO::ImageSpec& spec = input_ptr->spec();
+
+			return image<T>::read_impl(
+				std::move(input_ptr),
+				spec.channelnames,
+				std::forward<PostProcess>(postprocess),
+				subimage,
+				compression_codec,
+				compression_level,
+				block_size,
+				chunk_size,
+				scratch_memory_budget
+			);
+		}
 
 		/// \brief Read the metadata from the openimageio pointer into a json representation
 		/// \param input_ptr The input file to query
@@ -923,6 +1350,132 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 		}
 
 
+		/// \brief Write the image to disk using OpenImageIO, decompressing it chunk by chunk.
+		///
+		/// Requires CompressedImage to have been compiled with OpenImageIO support.
+		///
+		/// This is the mirror of `image<T>::read`: rather than materializing the full uncompressed
+		/// image with `get_decompressed()` the channels are decoded one chunk-row of scanlines at a
+		/// time, interleaved and handed to `OIIO::ImageOutput::write_scanlines`. The blosc2 decode of
+		/// the next chunk-row runs on a background thread while OpenImageIO encodes the current one so
+		/// neither side stalls on the other, and peak memory stays at roughly two chunk-rows instead
+		/// of the whole image.
+		///
+		/// Scalar metadata entries (strings, integers and floats) are written back as attributes,
+		/// nested metadata is skipped as OpenImageIO has no equivalent representation.
+		///
+		/// Example:
+		/// \code{.cpp}
+		/// compressed::image<float> my_image = ...;
+		/// my_image.write("image.exr");
+		/// \endcode
+		///
+		/// \param filepath The file path to write the image to, the format is deduced from the extension.
+		/// \throws std::invalid_argument if no OpenImageIO plugin can write the given file format.
+		/// \throws std::runtime_error if the image holds no channels or OpenImageIO fails during the write.
+		void write(std::filesystem::path filepath) const
+		{
+			_COMPRESSED_PROFILE_FUNCTION();
+			if (m_Channels.empty())
+			{
+				throw std::runtime_error("Internal Error: Image instance holds no channels, unable to write");
+			}
+
+			auto output_ptr = OIIO::ImageOutput::create(filepath.string());
+			if (!output_ptr)
+			{
+				throw std::invalid_argument(
+					std::format("Unable to find an OpenImageIO plugin capable of writing the file {}", filepath.string())
+				);
+			}
+
+			OIIO::ImageSpec spec(
+				static_cast<int>(m_Width),
+				static_cast<int>(m_Height),
+				static_cast<int>(m_Channels.size()),
+				enums::get_type_desc<T>()
+			);
+			if (m_ChannelNames.size() == m_Channels.size())
+			{
+				spec.channelnames = m_ChannelNames;
+			}
+			// Only scalar attributes have a direct OpenImageIO equivalent, anything nested stays
+			// with the native `save` format.
+			for (const auto& [key, value] : m_Metadata.items())
+			{
+				if (value.is_string())
+				{
+					spec.attribute(key, value.template get<std::string>());
+				}
+				else if (value.is_number_integer())
+				{
+					spec.attribute(key, static_cast<int>(value.template get<int64_t>()));
+				}
+				else if (value.is_number_float())
+				{
+					spec.attribute(key, value.template get<float>());
+				}
+			}
+
+			if (!output_ptr->open(filepath.string(), spec))
+			{
+				throw std::runtime_error(
+					std::format("Unable to open file {} for writing: {}", filepath.string(), output_ptr->geterror())
+				);
+			}
+
+			// Double-buffered pipeline: while OpenImageIO encodes the current chunk-row the next one
+			// is already being decompressed on a worker thread (which parallelizes internally across
+			// the channels, see `get_chunk_planes`).
+			const auto num_chunks = m_Channels.front().num_chunks();
+			const auto typedesc = enums::get_type_desc<T>();
+			util::default_init_vector<T> interleaved(m_Channels.front().chunk_elems() * m_Channels.size());
+
+			auto pending = std::async(std::launch::async, [this]() { return this->get_chunk_planes(0); });
+			size_t scanline = 0;
+			for (auto chunk_idx : std::views::iota(size_t{ 0 }, num_chunks))
+			{
+				auto planes = pending.get();
+				if (chunk_idx + 1 < num_chunks)
+				{
+					pending = std::async(std::launch::async, [this, chunk_idx]() { return this->get_chunk_planes(chunk_idx + 1); });
+				}
+
+				std::vector<std::span<const T>> plane_spans{};
+				for (const auto& plane : planes)
+				{
+					plane_spans.push_back(std::span<const T>(plane));
+				}
+				auto interleaved_fitted = std::span<T>(interleaved.data(), planes.front().size() * planes.size());
+				image_algo::interleave(interleaved_fitted, plane_spans);
+
+				// Chunks are scanline-aligned (see `read_impl`) so a chunk always maps to whole scanlines.
+				const size_t num_scanlines = planes.front().size() / m_Width;
+				auto res = output_ptr->write_scanlines(
+					static_cast<int>(scanline),
+					static_cast<int>(scanline + num_scanlines),
+					0,
+					typedesc,
+					interleaved_fitted.data()
+				);
+				if (!res)
+				{
+					throw std::runtime_error(
+						std::format("Failure while writing file {}: {}", filepath.string(), output_ptr->geterror())
+					);
+				}
+				scanline += num_scanlines;
+			}
+
+			if (!output_ptr->close())
+			{
+				throw std::runtime_error(
+					std::format("Failure while closing file {}: {}", filepath.string(), output_ptr->geterror())
+				);
+			}
+		}
+
+
 #endif // COMPRESSED_IMAGE_OIIO_AVAILABLE
 
 		/// Adds a compressed channel to the image.
@@ -1097,20 +1650,52 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			return extract_channel(index);
 		}
 
-		/// \brief Prints statistical information about the image file structure.
-		/// 
-		/// This function outputs various details about the compressed image, 
-		/// including dimensions, number of channels, compression ratio, and metadata.
-		/// 
-		/// Example output:
-		/// 
-		///		Statistics for image buffer:
-		///		 Width:             1024
-		///		 Height:            768
-		///		 Channels:          3
-		///		 Channelnames:      [R, G, B]
-		///		 --------------
-		///		 Compressed Size:   123456 bytes
+		/// \brief Create a cheap copy-on-write view of a channel without removing it from the image.
+		///
+		/// Unlike `extract_channel` the channel stays part of the image and unlike `clone()` no
+		/// compressed data is copied: the view aliases the channel's storage and the first side to
+		/// mutate detaches onto its own copy, see `channel<T>::share`. This lets fan-out pipelines
+		/// hand the same channel to several stages in O(1).
+		///
+		/// \param index The index of the channel to share.
+		/// \return A copy-on-write view of the channel.
+		/// \throws std::out_of_range if the index is out of bounds.
+		compressed::channel<T> share_channel(size_t index) const
+		{
+			if (index >= m_Channels.size())
+			{
+				throw std::out_of_range("Channel index out of range");
+			}
+			return m_Channels[index].share();
+		}
+
+		/// \brief Create a cheap copy-on-write view of a channel without removing it from the image.
+		///
+		/// See the index overload for the sharing semantics.
+		///
+		/// \param name The name of the channel to share.
+		/// \return A copy-on-write view of the channel.
+		/// \throws std::out_of_range if the channel name is invalid.
+		compressed::channel<T> share_channel(const std::string_view name) const
+		{
+			size_t index = get_channel_offset(name);
+			return share_channel(index);
+		}
+
+		/// \brief Prints statistical information about the image file structure.
+		/// 
+		/// This function outputs various details about the compressed image, 
+		/// including dimensions, number of channels, compression ratio, and metadata.
+		/// 
+		/// Example output:
+		/// 
+		///		Statistics for image buffer:
+		///		 Width:             1024
+		///		 Height:            768
+		///		 Channels:          3
+		///		 Channelnames:      [R, G, B]
+		///		 --------------
+		///		 Compressed Size:   123456 bytes
 		///		 Uncompressed Size: 3145728 bytes
 		///		 Compression ratio: 25.5x
 		///		 Num Chunks:        512
@@ -1156,6 +1741,144 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 		}
 
 
+		/// \brief Collect machine-readable compression statistics for the whole image.
+		///
+		/// The structured counterpart to `print_statistics`: per-channel and per-chunk
+		/// compressed/uncompressed byte counts, ratios, codec and lazy-vs-materialized chunk
+		/// state (see `channel<T>::compression_statistics`), returned as json so it can feed
+		/// telemetry or scheduling directly. Computing it only walks the chunk headers,
+		/// nothing is decompressed.
+		///
+		/// \return The statistics as json with the image totals at the top level and one
+		///			entry per channel under "channels".
+		json_ordered compression_statistics() const
+		{
+			_COMPRESSED_PROFILE_FUNCTION();
+			json_ordered stats{};
+			stats["width"] = m_Width;
+			stats["height"] = m_Height;
+			stats["num_channels"] = m_Channels.size();
+
+			size_t compressed = 0;
+			size_t uncompressed = 0;
+			auto channels = json_ordered::array();
+			for (auto channel_idx : std::views::iota(size_t{ 0 }, m_Channels.size()))
+			{
+				json_ordered entry{};
+				entry["name"] = channel_idx < m_ChannelNames.size() ? m_ChannelNames[channel_idx] : "";
+				entry.update(m_Channels[channel_idx].compression_statistics());
+
+				compressed += entry["compressed_bytes"].template get<size_t>();
+				uncompressed += entry["uncompressed_bytes"].template get<size_t>();
+				channels.push_back(std::move(entry));
+			}
+
+			stats["compressed_bytes"] = compressed;
+			stats["uncompressed_bytes"] = uncompressed;
+			stats["read_scratch_peak_bytes"] = m_ReadScratchPeakBytes;
+			stats["compression_ratio"] = compressed > 0
+				? static_cast<double>(uncompressed) / static_cast<double>(compressed)
+				: 0.0;
+			stats["channels"] = std::move(channels);
+			return stats;
+		}
+
+
+		/// \brief Deduplicate identical compressed chunks across all channels of the image.
+		///
+		/// Opt-in pass that moves the channels' chunks into one shared content-addressed store:
+		/// chunks that compress to identical bytes -- within a channel or across channels -- are
+		/// stored once and refcounted, see `blosc2::dedup_schunk<T>`. Matte and cryptomatte heavy
+		/// images where many channels are dominated by the same constant regions typically hold
+		/// 30-60% duplicate chunks, which this collapses without any codec work.
+		///
+		/// Modifications after the pass stay safe through copy-on-write, writing to a shared chunk
+		/// detaches it instead of affecting the other channels. New chunk writes keep being interned
+		/// into the shared store, so rewrites producing identical content re-share automatically.
+		/// Lazy and mmap-backed channels are left untouched, see `channel<T>::deduplicate`.
+		///
+		/// \return The number of compressed bytes saved, i.e. how much smaller the sum of the
+		///         channels' previous compressed sizes is after sharing duplicate chunks.
+		size_t deduplicate_chunks()
+		{
+			_COMPRESSED_PROFILE_FUNCTION();
+			auto store = std::make_shared<blosc2::detail::chunk_store>();
+
+			size_t before = 0;
+			for (const auto& channel : m_Channels)
+			{
+				before += channel.compressed_bytes();
+			}
+			for (auto& channel : m_Channels)
+			{
+				channel.deduplicate(store);
+			}
+
+			// The store's footprint is the deduplicated size across all channels, the per-channel
+			// return values cannot see chunks shared between channels. Channels the pass left
+			// untouched (lazy, mmap) did not intern anything, keep counting them at full size.
+			size_t after = store->total_bytes();
+			for (const auto& channel : m_Channels)
+			{
+				if (!std::holds_alternative<blosc2::dedup_schunk<T>>(channel.schunk()))
+				{
+					after += channel.compressed_bytes();
+				}
+			}
+			return before > after ? before - after : 0;
+		}
+
+
+		/// \brief Flip the image vertically, working on compressed chunks wherever possible.
+		///
+		/// Flips every channel in place, see `channel<T>::flip_vertical` for the per-layout
+		/// strategies -- channels storing one scanline per chunk flip by pure chunk reordering
+		/// without any codec work. A generated mip pyramid is discarded as the levels would be
+		/// stale, call `generate_mips` again if needed.
+		void flip_vertical()
+		{
+			_COMPRESSED_PROFILE_FUNCTION();
+			for (auto& channel : m_Channels)
+			{
+				channel.flip_vertical();
+			}
+			m_MipLevels.clear();
+		}
+
+		/// \brief Crop the image to the scanline range [y_begin, y_end).
+		///
+		/// Crops every channel in place, see `channel<T>::crop_y` -- with scanline-aligned chunks
+		/// and a chunk-aligned `y_begin` this drops chunks in the compressed domain and only
+		/// re-encodes the boundary chunk at the bottom. A generated mip pyramid is discarded as
+		/// the levels would be stale, call `generate_mips` again if needed.
+		///
+		/// \param y_begin The first scanline to keep.
+		/// \param y_end One past the last scanline to keep, must be greater than `y_begin` and at
+		///              most the image height.
+		///
+		/// \throws std::invalid_argument if the scanline range is not valid.
+		void crop_y(size_t y_begin, size_t y_end)
+		{
+			_COMPRESSED_PROFILE_FUNCTION();
+			if (y_end <= y_begin || y_end > m_Height)
+			{
+				throw std::invalid_argument(
+					std::format(
+						"Invalid crop range [{}, {}) for an image of height {}. The range must be non-empty and"
+						" lie within the image.",
+						y_begin, y_end, m_Height
+					)
+				);
+			}
+			for (auto& channel : m_Channels)
+			{
+				channel.crop_y(y_begin, y_end);
+			}
+			m_Height = y_end - y_begin;
+			m_MipLevels.clear();
+		}
+
+
 		/// Return the compression ratio over all channels.
 		double compression_ratio() const noexcept
 		{
@@ -1314,6 +2037,128 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			return result;
 		}
 
+		/// Decompress the chunk at `chunk_idx` of every channel concurrently and return the planes.
+		///
+		/// All channels created through `image<T>::read` share the same scanline-aligned chunk geometry
+		/// so chunk `i` covers the same pixel region in every channel. This decompresses that region
+		/// across all channels in parallel rather than paying the per-channel decompressions sequentially,
+		/// which is the common access pattern for per-tile operators needing e.g. R, G, B and A at once.
+		///
+		/// The planes are returned in channel order, each holding `channel(0).chunk_elems(chunk_idx)`
+		/// elements. To decompress into caller-owned memory use the span overload instead.
+		///
+		/// \param chunk_idx The index of the chunk to retrieve from every channel.
+		/// \return A vector with one decompressed plane per channel.
+		/// \throws std::out_of_range if `chunk_idx` exceeds the number of chunks.
+		std::vector<std::vector<T>> get_chunk_planes(size_t chunk_idx) const
+		{
+			_COMPRESSED_PROFILE_FUNCTION();
+			this->validate_chunk_planes_index(chunk_idx);
+
+			std::vector<std::vector<T>> planes(m_Channels.size());
+			auto indices = std::views::iota(size_t{ 0 }, m_Channels.size());
+			std::for_each(std::execution::par, indices.begin(), indices.end(), [&](size_t channel_idx)
+				{
+					planes[channel_idx].resize(m_Channels[channel_idx].chunk_elems(chunk_idx));
+					m_Channels[channel_idx].get_chunk(std::span<T>(planes[channel_idx]), chunk_idx);
+				});
+			return planes;
+		}
+
+		/// Decompress the chunk at `chunk_idx` of every channel concurrently into the provided buffers.
+		///
+		/// Identical to `get_chunk_planes(size_t)` but decompresses into caller-owned memory, one buffer
+		/// per channel in channel order. Each buffer must hold at least `channel(0).chunk_elems(chunk_idx)`
+		/// elements.
+		///
+		/// \param buffers One destination buffer per channel to decompress into.
+		/// \param chunk_idx The index of the chunk to retrieve from every channel.
+		/// \throws std::out_of_range if `chunk_idx` exceeds the number of chunks.
+		/// \throws std::invalid_argument if the number of buffers does not match the number of channels.
+		void get_chunk_planes(std::span<std::span<T>> buffers, size_t chunk_idx) const
+		{
+			_COMPRESSED_PROFILE_FUNCTION();
+			this->validate_chunk_planes_index(chunk_idx);
+			this->validate_chunk_planes_count(buffers.size());
+
+			auto indices = std::views::iota(size_t{ 0 }, m_Channels.size());
+			std::for_each(std::execution::par, indices.begin(), indices.end(), [&](size_t channel_idx)
+				{
+					m_Channels[channel_idx].get_chunk(buffers[channel_idx], chunk_idx);
+				});
+		}
+
+		/// Compress the provided planes into the chunk at `chunk_idx` of every channel concurrently.
+		///
+		/// The counterpart to `get_chunk_planes`: one source buffer per channel in channel order, each
+		/// compressed and written into its channel's super-chunk in parallel (channels own independent
+		/// compression contexts so the writes do not contend).
+		///
+		/// \param buffers One source buffer per channel to compress and store.
+		/// \param chunk_idx The index of the chunk to overwrite in every channel.
+		/// \throws std::out_of_range if `chunk_idx` exceeds the number of chunks.
+		/// \throws std::invalid_argument if the number of buffers does not match the number of channels.
+		void set_chunk_planes(std::span<std::span<T>> buffers, size_t chunk_idx)
+		{
+			_COMPRESSED_PROFILE_FUNCTION();
+			this->validate_chunk_planes_index(chunk_idx);
+			this->validate_chunk_planes_count(buffers.size());
+
+			auto indices = std::views::iota(size_t{ 0 }, m_Channels.size());
+			std::for_each(std::execution::par, indices.begin(), indices.end(), [&](size_t channel_idx)
+				{
+					m_Channels[channel_idx].set_chunk(buffers[channel_idx], chunk_idx);
+				});
+		}
+
+		/// Decompress only the scanline range [y_begin, y_end) of every channel concurrently.
+		///
+		/// The per-channel work is delegated to `channel<T>::get_roi` which touches only the chunks
+		/// intersecting the range and uses blosc2 partial decompression within them, so grading a
+		/// small strip never decodes the full image.
+		///
+		/// \param y_begin The first scanline to decompress (inclusive).
+		/// \param y_end The scanline to stop at (exclusive).
+		/// \return A vector with one plane of (y_end - y_begin) * width() elements per channel.
+		/// \throws std::out_of_range if the scanline range is empty or exceeds the image height.
+		std::vector<std::vector<T>> get_roi(size_t y_begin, size_t y_end) const
+		{
+			_COMPRESSED_PROFILE_FUNCTION();
+			if (m_Channels.empty())
+			{
+				throw std::runtime_error("Internal Error: Image instance holds no channels, unable to access a region of interest");
+			}
+
+			std::vector<std::vector<T>> planes(m_Channels.size());
+			auto indices = std::views::iota(size_t{ 0 }, m_Channels.size());
+			std::for_each(std::execution::par, indices.begin(), indices.end(), [&](size_t channel_idx)
+				{
+					planes[channel_idx].resize((y_end - y_begin) * m_Width);
+					m_Channels[channel_idx].get_roi(y_begin, y_end, std::span<T>(planes[channel_idx]));
+				});
+			return planes;
+		}
+
+		/// Decompress only the scanline range [y_begin, y_end) of every channel concurrently into the
+		/// provided buffers, one per channel in channel order. See `channel<T>::get_roi` for the details.
+		///
+		/// \param buffers One destination buffer per channel, each holding at least (y_end - y_begin) * width() elements.
+		/// \param y_begin The first scanline to decompress (inclusive).
+		/// \param y_end The scanline to stop at (exclusive).
+		/// \throws std::out_of_range if the scanline range is empty or exceeds the image height.
+		/// \throws std::invalid_argument if the number of buffers does not match the number of channels.
+		void get_roi(std::span<std::span<T>> buffers, size_t y_begin, size_t y_end) const
+		{
+			_COMPRESSED_PROFILE_FUNCTION();
+			this->validate_chunk_planes_count(buffers.size());
+
+			auto indices = std::views::iota(size_t{ 0 }, m_Channels.size());
+			std::for_each(std::execution::par, indices.begin(), indices.end(), [&](size_t channel_idx)
+				{
+					m_Channels[channel_idx].get_roi(y_begin, y_end, buffers[channel_idx]);
+				});
+		}
+
 
 		/// Retrieve the logical index of the given channel.
 		/// 
@@ -1353,6 +2198,93 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			return m_Channels.size();
 		}
 
+		/// \brief Set up a lazily-computed compressed mip pyramid over the image.
+		///
+		/// This only records how many levels the pyramid has, the levels themselves are computed
+		/// on first access through `mip_level` so setting up the pyramid is free until a proxy
+		/// resolution is actually requested. Level 0 is half resolution, level 1 quarter resolution
+		/// and so on down to 1x1, each level being box-filtered from the previous one.
+		///
+		/// The levels are snapshots of the channel content at the time they are first accessed,
+		/// modifying the full-resolution channels afterwards does not update them. Call
+		/// `generate_mips` again to discard any cached levels and start over.
+		///
+		/// \throws std::runtime_error if the image holds no channels.
+		void generate_mips()
+		{
+			if (m_Channels.empty())
+			{
+				throw std::runtime_error("Internal Error: Image instance holds no channels, unable to generate mip levels");
+			}
+
+			size_t levels = 0;
+			size_t width = m_Width;
+			size_t height = m_Height;
+			while (width > 1 || height > 1)
+			{
+				width = std::max<size_t>(width / 2, 1);
+				height = std::max<size_t>(height / 2, 1);
+				++levels;
+			}
+			m_MipLevels.assign(levels, std::nullopt);
+		}
+
+		/// Number of levels in the mip pyramid, 0 if `generate_mips` has not been called.
+		size_t num_mip_levels() const noexcept
+		{
+			return m_MipLevels.size();
+		}
+
+		/// \brief Access a level of the mip pyramid, computing it on first access.
+		///
+		/// Level 0 is half resolution, level 1 quarter resolution and so on, the channels of a
+		/// level are in the same order as `channels()` and carry their own dimensions. The level
+		/// is built chunk-by-chunk from the (possibly itself still uncomputed) previous level:
+		/// one chunk strip is decoded, box-filtered and appended into the level's compressed
+		/// storage, so requesting a proxy never materializes any full-resolution channel.
+		///
+		/// \param level The pyramid level to access.
+		///
+		/// \return The compressed channels of the level.
+		///
+		/// \throws std::runtime_error if `generate_mips` has not been called.
+		/// \throws std::out_of_range if the level exceeds the pyramid depth.
+		const std::vector<compressed::channel<T>>& mip_level(size_t level)
+		{
+			_COMPRESSED_PROFILE_FUNCTION();
+			if (m_MipLevels.empty())
+			{
+				throw std::runtime_error("No mip pyramid available, call generate_mips() before accessing a mip level");
+			}
+			if (level >= m_MipLevels.size())
+			{
+				throw std::out_of_range(
+					std::format(
+						"Invalid mip level {} requested, the pyramid only holds {} levels", level, m_MipLevels.size()
+					)
+				);
+			}
+
+			// Fill in any missing levels above the requested one, each level is box-filtered
+			// from the previous so they have to be computed top-down.
+			for (auto idx : std::views::iota(size_t{ 0 }, level + 1))
+			{
+				if (m_MipLevels[idx])
+				{
+					continue;
+				}
+				const auto& parents = idx == 0 ? m_Channels : *m_MipLevels[idx - 1];
+				std::vector<compressed::channel<T>> level_channels;
+				level_channels.reserve(parents.size());
+				for (const auto& parent : parents)
+				{
+					level_channels.push_back(image<T>::downsample_channel(parent));
+				}
+				m_MipLevels[idx] = std::move(level_channels);
+			}
+			return *m_MipLevels[level];
+		}
+
 		/// Names of the channels stored on the image, are stored in the same order as the logical indices. So if the channelnames
 		/// are { "B", "G", "R" } accessing channel "R" would be index 2.
 		std::vector<std::string> channelnames() const noexcept
@@ -1393,6 +2325,65 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			return m_Metadata;
 		}
 
+		/// Apply `func` to every chunk of every channel, decompressing, applying the functor and recompressing.
+		///
+		/// The channels are visited in order while their chunks are processed according to the passed execution
+		/// policy, see `channel<T>::for_each_chunk` for the details. The functor additionally receives the index
+		/// of the channel the chunk belongs to (mirroring the `PostProcess` hook on `image<T>::read`).
+		///
+		/// Example:
+		/// \code{.cpp}
+		/// compressed::image<float> image = ...;
+		/// image.for_each_chunk(std::execution::par, [](size_t channel_idx, compressed::container::chunk_span<float> chunk)
+		///		{
+		///			for (auto& pixel : chunk)
+		///			{
+		///				pixel *= 2.0f;
+		///			}
+		///		});
+		/// \endcode
+		///
+		/// \param policy The execution policy to run with, e.g. std::execution::par.
+		/// \param func The functor to apply to each chunk, invoked with the channel index and the chunk.
+		template <typename ExecutionPolicy, typename Func>
+			requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+				&& std::invocable<std::remove_reference_t<Func>, size_t, container::chunk_span<T>>
+		void for_each_chunk(ExecutionPolicy policy, Func&& func)
+		{
+			_COMPRESSED_PROFILE_FUNCTION();
+			for (size_t channel_idx = 0; channel_idx < m_Channels.size(); ++channel_idx)
+			{
+				m_Channels[channel_idx].for_each_chunk(policy, [&](container::chunk_span<T> chunk)
+					{
+						func(channel_idx, chunk);
+					});
+			}
+		}
+
+		/// Apply `func` to every chunk of every channel in parallel, equivalent to calling
+		/// `for_each_chunk(std::execution::par, func)`.
+		template <typename Func>
+			requires std::invocable<std::remove_reference_t<Func>, size_t, container::chunk_span<T>>
+		void for_each_chunk(Func&& func)
+		{
+			this->for_each_chunk(std::execution::par, std::forward<Func>(func));
+		}
+
+		/// Attach a chunk buffer pool shared across all channels of the image.
+		///
+		/// With a pool attached, chunk rewrites across all channels recycle their compressed
+		/// buffers through the pool instead of allocating a fresh heap vector per chunk, see
+		/// `channel<T>::buffer_pool`. Passing nullptr detaches the pool from every channel.
+		///
+		/// \param pool The pool to share across the channels, nullptr to restore plain heap allocation.
+		void buffer_pool(std::shared_ptr<detail::byte_buffer_pool> pool)
+		{
+			for (auto& channel : m_Channels)
+			{
+				channel.buffer_pool(pool);
+			}
+		}
+
 		/// Update the number of threads used internally by c-blosc2 for compression and decompression.
 		/// This is automatically set when iterating through the images with compressed::for_each for example
 		/// by specifying the compression codec.
@@ -1404,6 +2395,16 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			}
 		}
 
+		/// Rebalance the image to its current share of the library-wide thread budget.
+		///
+		/// Each channel is resized to `compressed::thread_budget()` divided across all alive
+		/// channels, call this after changing the budget with `compressed::thread_budget(size_t)`
+		/// or after creating/destroying images to avoid oversubscribing the machine.
+		void update_nthreads()
+		{
+			this->update_nthreads(detail::shared_nthreads());
+		}
+
 		/// \brief Get the chunk size used for compression, this is the same across all channels.
 		/// 
 		/// \throws std::runtime_error If the channels of the image do not all share the same chunk size as this is 
@@ -1461,6 +2462,205 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 		/// The height of the image file
 		size_t m_Height = 1;
 
+		/// The lazily-computed compressed mip pyramid, empty until `generate_mips` is called.
+		/// Each slot is one level (level 0 being half resolution), std::nullopt until the level
+		/// is first accessed through `mip_level`.
+		std::vector<std::optional<std::vector<compressed::channel<T>>>> m_MipLevels{};
+
+		/// Peak transient scratch allocation of the `read` call that produced this image in bytes,
+		/// 0 for images not created through `read`. See the `scratch_memory_budget` read parameter.
+		size_t m_ReadScratchPeakBytes = 0;
+
+	private:
+
+		/// \brief Box-filter a channel down to half resolution, staying compressed on both ends.
+		///
+		/// The parent is decoded one chunk strip (or tile strip) at a time, every 2x2 block is
+		/// averaged and the halved scanlines are appended into a fresh `blosc2::schunk<T>` as
+		/// soon as they fill an output chunk, so at no point does more than roughly one parent
+		/// chunk plus one output chunk live uncompressed. Odd parent dimensions clamp the filter
+		/// at the edges, the output is always max(1, dimension / 2).
+		///
+		/// \param parent The channel to downsample, scanline or tiled layout.
+		///
+		/// \return The half-resolution channel in scanline layout, inheriting the parent's
+		///			codec, compression level and block size.
+		static compressed::channel<T> downsample_channel(const compressed::channel<T>& parent)
+		{
+			_COMPRESSED_PROFILE_FUNCTION();
+			const size_t parent_width = parent.width();
+			const size_t parent_height = parent.height();
+			const size_t out_width = std::max<size_t>(parent_width / 2, 1);
+			const size_t out_height = std::max<size_t>(parent_height / 2, 1);
+
+			// Align the output chunks to whole scanlines so the generated level supports the
+			// partial decode paths (`get_roi` etc.) just like a channel coming from `read`.
+			const size_t out_chunk_bytes = util::align_chunk_to_scanlines_bytes<T>(out_width, s_default_chunksize);
+			const size_t out_chunk_elems = out_chunk_bytes / sizeof(T);
+
+			auto compression_ctx = blosc2::create_compression_context<T>(
+				detail::shared_nthreads(),
+				parent.compression(),
+				parent.compression_level(),
+				parent.block_size()
+			);
+			auto schunk = blosc2::schunk<T>(parent.block_size(), out_chunk_bytes);
+			util::default_init_vector<std::byte> compression_buffer(blosc2::min_compressed_size(out_chunk_bytes));
+			util::default_init_vector<T> out_buffer(out_chunk_elems);
+			size_t out_fill = 0;
+
+			auto flush = [&]()
+				{
+					schunk.append_chunk(
+						compression_ctx,
+						std::span<T>(out_buffer.data(), out_fill),
+						std::span<std::byte>(compression_buffer)
+					);
+					out_fill = 0;
+				};
+
+			// Average one pair of parent rows into the next output row, flushing the output
+			// chunk once it is full. The x lookups clamp so a single-column parent works too.
+			auto downsample_row_pair = [&](const T* upper, const T* lower)
+				{
+					T* dst = out_buffer.data() + out_fill;
+					for (auto x : std::views::iota(size_t{ 0 }, out_width))
+					{
+						const size_t x0 = x * 2;
+						const size_t x1 = std::min(x0 + 1, parent_width - 1);
+						if constexpr (std::is_integral_v<T>)
+						{
+							const int64_t sum = static_cast<int64_t>(upper[x0]) + upper[x1] + lower[x0] + lower[x1];
+							dst[x] = static_cast<T>((sum + 2) / 4);
+						}
+						else
+						{
+							dst[x] = static_cast<T>((upper[x0] + upper[x1] + lower[x0] + lower[x1]) / static_cast<T>(4));
+						}
+					}
+					out_fill += out_width;
+					if (out_fill == out_chunk_elems)
+					{
+						flush();
+					}
+				};
+
+			if (!parent.is_tiled())
+			{
+				// Scanline parent: decode chunk by chunk and keep the rows that did not yet
+				// form a complete pair around for the next chunk, this way the parent's chunks
+				// do not need to be scanline-aligned.
+				util::default_init_vector<T> chunk_buffer(parent.chunk_elems());
+				std::vector<T> pending;
+				pending.reserve(parent.chunk_elems() + 2 * parent_width);
+				size_t out_rows = 0;
+
+				for (auto chunk_idx : std::views::iota(size_t{ 0 }, parent.num_chunks()))
+				{
+					auto chunk_span = std::span<T>(chunk_buffer.data(), parent.chunk_elems(chunk_idx));
+					parent.get_chunk(chunk_span, chunk_idx);
+					pending.insert(pending.end(), chunk_span.begin(), chunk_span.end());
+
+					size_t offset = 0;
+					while (pending.size() - offset >= 2 * parent_width && out_rows < out_height)
+					{
+						downsample_row_pair(pending.data() + offset, pending.data() + offset + parent_width);
+						offset += 2 * parent_width;
+						++out_rows;
+					}
+					pending.erase(pending.begin(), pending.begin() + offset);
+				}
+
+				// A single-row parent never forms a pair, filter the row against itself.
+				if (out_rows < out_height)
+				{
+					downsample_row_pair(pending.data(), pending.data());
+				}
+			}
+			else
+			{
+				// Tiled parent: pull strips of a tile row's height through the rectangular ROI
+				// so every tile is only decoded once.
+				const size_t strip_rows = std::max<size_t>(parent.tile_height() & ~size_t{ 1 }, 2);
+				util::default_init_vector<T> strip(strip_rows * parent_width);
+				size_t out_row = 0;
+				while (out_row < out_height)
+				{
+					const size_t parent_row = out_row * 2;
+					const size_t rows = std::min(strip_rows, parent_height - parent_row);
+					parent.get_roi(
+						size_t{ 0 }, parent_width,
+						parent_row, parent_row + rows,
+						std::span<T>(strip.data(), rows * parent_width)
+					);
+
+					const size_t pairs = std::min(rows / 2, out_height - out_row);
+					if (pairs == 0)
+					{
+						// Only reachable for a single-row (1x1 tiled) parent.
+						downsample_row_pair(strip.data(), strip.data());
+						++out_row;
+						continue;
+					}
+					for (auto pair : std::views::iota(size_t{ 0 }, pairs))
+					{
+						downsample_row_pair(
+							strip.data() + (pair * 2) * parent_width,
+							strip.data() + (pair * 2 + 1) * parent_width
+						);
+					}
+					out_row += pairs;
+				}
+			}
+
+			if (out_fill > 0)
+			{
+				flush();
+			}
+
+			return compressed::channel<T>(
+				std::move(schunk),
+				out_width,
+				out_height,
+				parent.compression(),
+				parent.compression_level()
+			);
+		}
+
+		/// Validate that `chunk_idx` is a valid chunk index for the batched plane accessors.
+		void validate_chunk_planes_index(size_t chunk_idx) const
+		{
+			if (m_Channels.empty())
+			{
+				throw std::runtime_error("Internal Error: Image instance holds no channels, unable to access chunk planes");
+			}
+			// All channels share the same scanline-aligned chunk geometry so checking the first is sufficient.
+			if (chunk_idx >= m_Channels.front().num_chunks())
+			{
+				throw std::out_of_range(
+					std::format(
+						"chunk_idx is out of range for the total number of chunks in the image."
+						" Max chunk number is {} but received {}",
+						m_Channels.front().num_chunks() - 1, chunk_idx
+					)
+				);
+			}
+		}
+
+		/// Validate that the batched plane accessors received exactly one buffer per channel.
+		void validate_chunk_planes_count(size_t num_buffers) const
+		{
+			if (num_buffers != m_Channels.size())
+			{
+				throw std::invalid_argument(
+					std::format(
+						"Invalid number of buffers received for accessing chunk planes. Expected exactly {} (one per channel) but instead got {}",
+						m_Channels.size(), num_buffers
+					)
+				);
+			}
+		}
+
 	private:
 
 
@@ -1482,6 +2682,7 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 		/// \param compression_level The compression level to compress with
 		/// \param block_size The block size to apply to the compressed data
 		/// \param chunk_size The chunk size to apply to the compressed data
+		/// \param scratch_memory_budget Upper bound in bytes for the scratch buffers, wide contiguous channel ranges are split to fit
 		/// 
 		/// \returns The decoded image.
 		template <typename PostProcess = std::nullopt_t>
@@ -1494,7 +2695,8 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			enums::codec compression_codec = enums::codec::lz4,
 			size_t compression_level = 9,
 			size_t block_size = s_default_blocksize,
-			size_t chunk_size = s_default_chunksize
+			size_t chunk_size = s_default_chunksize,
+			size_t scratch_memory_budget = s_default_read_scratch_budget
 			)
 		{
 			_COMPRESSED_PROFILE_FUNCTION();
@@ -1532,7 +2734,28 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			// minimizing memory footprint by only ever allocating as much as we need for the max amount of contiguous
 			// channels we can encounter.
 			std::vector<compressed::channel<T>> channels;
-			auto channel_ranges_contiguous = detail::get_contiguous_channels(input_ptr, channelnames);
+
+			// Scratch memory scales with the widest contiguous range: two interleaved swap
+			// buffers spanning the whole range plus one deinterleave buffer per channel, each
+			// one chunk in size. Cap the range width so a wide contiguous group (e.g. a
+			// 30-channel cryptomatte layer) cannot blow past the requested budget, reading it
+			// in several narrower passes instead. One channel's worth of scratch is the floor,
+			// below that the read cannot be expressed.
+			const size_t scratch_bytes_per_channel = 3 * chunk_size_aligned;
+			const size_t max_channels_per_pass = std::max<size_t>(size_t{ 1 }, scratch_memory_budget / scratch_bytes_per_channel);
+
+			std::vector<std::pair<int, int>> channel_ranges_contiguous;
+			for (const auto& [range_begin, range_end] : detail::get_contiguous_channels(input_ptr, channelnames))
+			{
+				int begin = range_begin;
+				while (begin < range_end)
+				{
+					int end = std::min(range_end, begin + static_cast<int>(max_channels_per_pass));
+					channel_ranges_contiguous.emplace_back(begin, end);
+					begin = end;
+				}
+			}
+
 			size_t max_num_channels = 0;
 			for (const auto& [chbegin, chend] : channel_ranges_contiguous)
 			{
@@ -1551,8 +2774,11 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			const size_t max_chunk_size = chunk_size_aligned * max_num_channels;
 
 			// Initialize our swap buffers, these are going to be either discarded after
-			// or compressed from.
+			// or compressed from. We keep two interleaved buffers around so the read of the
+			// next batch of scanlines can overlap with deinterleaving + compression of the
+			// current one (double-buffered producer/consumer pipeline).
 			util::default_init_vector<T> interleaved_buffer(max_chunk_size / sizeof(T));
+			util::default_init_vector<T> interleaved_buffer_back(max_chunk_size / sizeof(T));
 			std::vector<util::default_init_vector<T>> deinterleaved_buffer(max_num_channels);
 			std::for_each(std::execution::par_unseq, deinterleaved_buffer.begin(), deinterleaved_buffer.end(), [&](auto& buffer)
 				{
@@ -1584,6 +2810,7 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 
 				// Refit the swap buffers as `read_contiguous_channels_impl` expects these to be exactly sized.
 				auto interleaved_fitted = std::span<T>(interleaved_buffer.begin(), chunk_size_all / sizeof(T));
+				auto interleaved_back_fitted = std::span<T>(interleaved_buffer_back.begin(), chunk_size_all / sizeof(T));
 				std::vector<std::span<T>> deinterleaved_fitted{};
 				for (auto idx : std::views::iota(0, nchannels))
 				{
@@ -1594,14 +2821,16 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 				}
 
 				// Create and initialize the contexts and schunks. These are pretty light weight so we don't need
-				// to worry about creating them outside of the loop/reusing them.
+				// to worry about creating them outside of the loop/reusing them. The contexts take their share
+				// of the global thread budget so concurrent reads (e.g. via `read_batch`) divide the blosc2
+				// threads between them instead of each sizing to the full machine.
 				std::vector<blosc2::context_ptr> contexts;
 				std::vector<blosc2::schunk<T>> schunks;
 				for ([[maybe_unused]] auto _ : std::views::iota(0, nchannels))
 				{
 					schunks.push_back(blosc2::schunk<T>(block_size, chunk_size_aligned));
 					contexts.push_back(blosc2::create_compression_context<T>(
-						std::thread::hardware_concurrency(),
+						detail::shared_nthreads(),
 						compression_codec,
 						comp_level_adjusted,
 						block_size
@@ -1619,6 +2848,7 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 							chbegin,
 							chend,
 							interleaved_fitted,
+							interleaved_back_fitted,
 							deinterleaved_fitted,
 							scanlines_per_chunk,
 							contexts,
@@ -1635,6 +2865,7 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 							chbegin,
 							chend,
 							interleaved_fitted,
+							interleaved_back_fitted,
 							deinterleaved_fitted,
 							scanlines_per_chunk,
 							contexts,
@@ -1654,6 +2885,7 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 							chbegin,
 							chend,
 							interleaved_fitted,
+							interleaved_back_fitted,
 							deinterleaved_fitted,
 							scanlines_per_chunk,
 							contexts,
@@ -1670,6 +2902,7 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 							chbegin,
 							chend,
 							interleaved_fitted,
+							interleaved_back_fitted,
 							deinterleaved_fitted,
 							scanlines_per_chunk,
 							contexts,
@@ -1706,6 +2939,7 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			// Construct the image instance.
 			auto img = compressed::image<T>(std::move(channels), spec.width, spec.height, new_channelnames);
 			img.metadata(compressed::image<T>::read_oiio_metadata(spec));
+			img.m_ReadScratchPeakBytes = scratch_bytes_per_channel * max_num_channels + chunk_buffer.size();
 			return std::move(img);
 		}
 
@@ -1715,21 +2949,27 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 		/// When reading with OpenImageIO it is a lot more efficient to parse as many channels as possible in one go
 		/// rather than reading one channel at a time as the ImageInput keeps the data as compressed (in many cases).
 		/// If we were to read one channel at a time this would significantly slow down our read speeds.
-		/// 
+		///
 		/// Due to us only being able to read contiguous channels at a time this helper function allows us to do that.
-		/// 
+		///
+		/// Internally this runs as a double-buffered pipeline: while one batch of scanlines is being deinterleaved
+		/// and compressed the next batch is already being read from disk into the back buffer. This way neither
+		/// the disk nor the cpu sit idle waiting for each other.
+		///
 		/// \param input_ptr The opened OpenImageIO ImageInput.
 		/// \param chbegin The start channel to read
 		/// \param chend The end channel to read
 		/// \param interleaved_buffer The buffer into which we will read the channels (before then interleaving).
 		///							  must be sized to exactly fit nchannels * width * height
+		/// \param interleaved_buffer_back The second interleaved buffer used to overlap read and compression,
+		///								   must be sized identically to `interleaved_buffer`.
 		/// \param deinterleaved_buffer The buffers to deinterleave into, must be exactly of size nchannels with each
 		///								sub-buffer being exactly width * height.
 		/// \param scanlines_per_chunk The number of scanlines that fit into one chunk (exactly).
 		/// \param contexts The contexts for compression, must be exactly nchannels amount
 		/// \param schunks The schunks for compression, must be exactly nchannels amount
 		/// \param chunk_buffer A scratch buffer for compression (from which we copy).
-		/// 
+		///
 		/// \throws std::invalid_argument if any of the above conditions is not met.
 		template <bool read_tiles, typename PostProcess = std::nullopt_t>
 			requires std::invocable<std::remove_reference_t<PostProcess>, size_t, std::span<T>> || std::is_same_v<std::remove_cvref_t<PostProcess>, std::nullopt_t>
@@ -1739,6 +2979,7 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			int chbegin,
 			int chend,
 			std::span<T> interleaved_buffer,
+			std::span<T> interleaved_buffer_back,
 			std::vector<std::span<T>>& deinterleaved_buffer,
 			size_t scanlines_per_chunk,
 			std::vector<blosc2::context_ptr>& contexts,
@@ -1776,6 +3017,18 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 					)
 				);
 			}
+			// Ensure the back buffer matches the front buffer, we ping-pong between the two during the read.
+			if (interleaved_buffer_back.size() != interleaved_buffer.size())
+			{
+				throw std::invalid_argument(
+					std::format(
+						"read_contiguous_channels_impl: Received incorrectly sized interleaved back buffer, should be exactly"
+						" {:L} elements large (matching the front buffer) but instead got {:L}.",
+						interleaved_buffer.size(),
+						interleaved_buffer_back.size()
+					)
+				);
+			}
 			// Ensure the deinterleaved buffer, and its subbuffers, are correctly sized.
 			if (deinterleaved_buffer.size() != static_cast<size_t>(nchannels))
 			{
@@ -1817,67 +3070,92 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 				);
 			}
 
-			// Iterate all scanlines and read as many scanlines as possible in one go, compressing them on the fly 
-			// into all of the super-chunks. This works for data windows as well where the y and x may not start at zero
+			// Read one batch of scanlines (or tiles) into the given interleaved buffer, returning whether
+			// the OIIO read succeeded. Since the passed `scanlines_per_chunk` is already appropriately aligned
+			// to either tiles or scanlines, we can safely call either `read_tiles` or `read_scanlines` here
+			// making sure we are correctly aligned.
+			auto read_batch = [&](std::span<T> buffer, int ybegin, int nscanlines) -> bool
+				{
+					_COMPRESSED_PROFILE_SCOPE("Read Scanlines/Tiles");
+					if constexpr (read_tiles)
+					{
+						return input_ptr->read_tiles(
+							subimage,
+							0, // miplevel
+							spec.x, // xbegin
+							spec.width, // xend
+							ybegin, // ybegin
+							ybegin + nscanlines, // yend
+							0, // zbegin
+							1, // zend
+							chbegin,
+							chend,
+							typedesc,
+							static_cast<void*>(buffer.data())
+						);
+					}
+					else
+					{
+						return input_ptr->read_scanlines(
+							subimage,
+							0, // miplevel
+							ybegin, // ybegin
+							ybegin + nscanlines, // yend
+							0, // z
+							chbegin,
+							chend,
+							typedesc,
+							static_cast<void*>(buffer.data())
+						);
+					}
+				};
+
+			// Iterate all scanlines and read as many scanlines as possible in one go, compressing them on the fly
+			// into all of the super-chunks. This works for data windows as well where the y and x may not start at zero.
+			//
+			// The read of batch N+1 is kicked off asynchronously into the back buffer before we deinterleave and
+			// compress batch N out of the front buffer, overlapping disk i/o with blosc2 compression. The ImageInput
+			// is only ever touched by one thread at a time as we wait on the pending read before issuing the next.
+			const int yend = spec.height + spec.y;
+			auto scanlines_at = [&](int ybegin)
+				{
+					return static_cast<int>(std::min<size_t>(scanlines_per_chunk, static_cast<size_t>(yend - ybegin)));
+				};
+
+			std::span<T> front_buffer = interleaved_buffer;
+			std::span<T> back_buffer = interleaved_buffer_back;
+
 			int y = spec.y;
-			while (y < (spec.height + spec.y))
+			int scanlines_to_read = scanlines_at(y);
+			if (y < yend && !read_batch(front_buffer, y, scanlines_to_read))
 			{
-				_COMPRESSED_PROFILE_SCOPE("Read Scanlines/Tiles and compress");
-				int scanlines_to_read = static_cast<int>(std::min<size_t>(
-					scanlines_per_chunk, static_cast<size_t>(spec.height + spec.y - y)
-				));
-
+				throw std::runtime_error(
+					std::format(
+						"OIIO read failure when reading scanlines {}-{} for channels {}-{}: '{}'",
+						y, y + scanlines_to_read, chbegin, chend, input_ptr->geterror()
+					)
+				);
+			}
 
-				bool read_successful = false;
-				// Since the passed `scanlines_per_chunk` is already appropriately aligned to either tiles or scanlines,
-				// we can safely call either `read_tiles` or `read_scanlines` here making sure we are correctly aligned
-				if constexpr (read_tiles)
-				{
-					read_successful = input_ptr->read_tiles(
-						subimage,
-						0, // miplevel
-						spec.x, // xbegin
-						spec.width, // xend
-						y, // ybegin
-						y + scanlines_to_read, // yend
-						0, // zbegin	
-						1, // zend
-						chbegin,
-						chend,
-						typedesc,
-						static_cast<void*>(interleaved_buffer.data())
-					);
-				}
-				else
-				{
-					read_successful = input_ptr->read_scanlines(
-						subimage,
-						0, // miplevel
-						y, // ybegin
-						y + scanlines_to_read, // yend
-						0, // z
-						chbegin,
-						chend,
-						typedesc,
-						static_cast<void*>(interleaved_buffer.data())
-					);
-				}
+			while (y < yend)
+			{
+				_COMPRESSED_PROFILE_SCOPE("Deinterleave and compress batch");
 
-				if (!read_successful)
+				// Kick off the read of the next batch into the back buffer (if there is one left).
+				const int y_next = y + scanlines_to_read;
+				int scanlines_next = 0;
+				std::future<bool> pending_read;
+				if (y_next < yend)
 				{
-					throw std::runtime_error(
-						std::format(
-							"OIIO read failure when reading scanlines {}-{} for channels {}-{}: '{}'",
-							y, y + scanlines_to_read, chbegin, chend, input_ptr->geterror()
-						)
-					);
+					scanlines_next = scanlines_at(y_next);
+					pending_read = std::async(std::launch::async, read_batch, back_buffer, y_next, scanlines_next);
 				}
 
-				// Deinterleave the buffers, in some cases we may be deinterleaving empty space here but that 
+				// Deinterleave the buffers, in some cases we may be deinterleaving empty space here but that
 				// is ok as we refit the buffers. Since in most cases the size will only be off by at most one
 				// scanline. In the case of the last chunk, we may be at worst deinterleaving only one scanline
 				// with the rest being empty space but that is also ok.
-				image_algo::deinterleave(std::span<const T>(interleaved_buffer), deinterleaved_buffer);
+				image_algo::deinterleave(util::as_const_span(front_buffer), deinterleaved_buffer);
 
 				// Now start compressing the chunks and appending them into the super-chunks.
 				for (auto channel_idx : std::views::iota(0, nchannels))
@@ -1900,7 +3178,24 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 						std::span<std::byte>(chunk_buffer)
 					);
 				}
-				y += scanlines_to_read;
+
+				// Wait for the next batch to land before swapping the buffers and advancing.
+				if (pending_read.valid())
+				{
+					if (!pending_read.get())
+					{
+						throw std::runtime_error(
+							std::format(
+								"OIIO read failure when reading scanlines {}-{} for channels {}-{}: '{}'",
+								y_next, y_next + scanlines_next, chbegin, chend, input_ptr->geterror()
+							)
+						);
+					}
+					std::swap(front_buffer, back_buffer);
+				}
+
+				y = y_next;
+				scanlines_to_read = scanlines_next;
 			}
 		}
 
@@ -5,6 +5,8 @@
 #include "detail/scoped_timer.h"
 
 #include <algorithm>
+#include <array>
+#include <cstring>
 #include <span>
 #include <vector>
 #include <execution>
@@ -15,6 +17,90 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 	namespace image_algo
 	{
 
+		namespace detail
+		{
+
+			/// Number of pixels each (de)interleave work item processes. Large enough to amortize the
+			/// parallel dispatch overhead, small enough that a block of 4 float channels stays inside L2.
+			constexpr static inline size_t s_interleave_block_size = 16'384;
+
+			/// Interleave `count` pixels starting at `begin` for a channel count known at compile time.
+			///
+			/// With the channel count being a constant the inner loop is fully unrolled and the strided
+			/// stores become a shuffle-based transpose under SSE/AVX2/NEON via the compiler's
+			/// autovectorizer, which the runtime-channel-count loop never achieves.
+			template <typename T, size_t NumChannels>
+			void interleave_block(std::span<T> buffer, const std::vector<std::span<const T>>& spans, size_t begin, size_t count)
+			{
+				std::array<const T*, NumChannels> srcs{};
+				for (size_t i = 0; i < NumChannels; ++i)
+				{
+					srcs[i] = spans[i].data() + begin;
+				}
+				T* dst = buffer.data() + begin * NumChannels;
+				for (size_t idx = 0; idx < count; ++idx)
+				{
+					for (size_t i = 0; i < NumChannels; ++i)
+					{
+						dst[idx * NumChannels + i] = srcs[i][idx];
+					}
+				}
+			}
+
+			/// Interleave `count` pixels starting at `begin` for any runtime channel count.
+			template <typename T>
+			void interleave_block(std::span<T> buffer, const std::vector<std::span<const T>>& spans, size_t begin, size_t count)
+			{
+				const size_t num_channels = spans.size();
+				T* dst = buffer.data() + begin * num_channels;
+				for (size_t idx = 0; idx < count; ++idx)
+				{
+					for (size_t i = 0; i < num_channels; ++i)
+					{
+						dst[idx * num_channels + i] = spans[i][begin + idx];
+					}
+				}
+			}
+
+			/// Deinterleave `count` pixels starting at `begin` for a channel count known at compile time.
+			///
+			/// See `interleave_block` for why the channel count is lifted into a template parameter.
+			template <typename T, size_t NumChannels>
+			void deinterleave_block(std::span<const T> interleaved, std::vector<std::span<T>>& channel_spans, size_t begin, size_t count)
+			{
+				std::array<T*, NumChannels> dsts{};
+				for (size_t i = 0; i < NumChannels; ++i)
+				{
+					dsts[i] = channel_spans[i].data() + begin;
+				}
+				const T* src = interleaved.data() + begin * NumChannels;
+				for (size_t idx = 0; idx < count; ++idx)
+				{
+					for (size_t i = 0; i < NumChannels; ++i)
+					{
+						dsts[i][idx] = src[idx * NumChannels + i];
+					}
+				}
+			}
+
+			/// Deinterleave `count` pixels starting at `begin` for any runtime channel count.
+			template <typename T>
+			void deinterleave_block(std::span<const T> interleaved, std::vector<std::span<T>>& channel_spans, size_t begin, size_t count)
+			{
+				const size_t num_channels = channel_spans.size();
+				const T* src = interleaved.data() + begin * num_channels;
+				for (size_t idx = 0; idx < count; ++idx)
+				{
+					for (size_t i = 0; i < num_channels; ++i)
+					{
+						channel_spans[i][begin + idx] = src[idx * num_channels + i];
+					}
+				}
+			}
+
+		} // detail
+
+
 		/// Interleave the spans into a unified buffer taking any number of input spans (could be channels).
 		///
 		/// could be called like this for example:
@@ -52,13 +138,33 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 				throw std::invalid_argument("Interleave: Provided buffer is not large enough to hold all the elements to interleave.");
 			}
 
-			auto indices = std::views::iota(static_cast<std::size_t>(0), spans.front().size());
-			std::for_each(std::execution::par_unseq, indices.begin(), indices.end(), [&buffer, &spans](auto idx)
+			// Parallelize over pixel blocks rather than single pixels and dispatch to a kernel with
+			// a compile-time channel count for the common cases so the compiler can vectorize the
+			// transpose with shuffles instead of per-pixel scalar gathers.
+			const size_t num_pixels = spans.front().size();
+			const size_t num_blocks = (num_pixels + detail::s_interleave_block_size - 1) / detail::s_interleave_block_size;
+			auto blocks = std::views::iota(static_cast<std::size_t>(0), num_blocks);
+			std::for_each(std::execution::par_unseq, blocks.begin(), blocks.end(), [&buffer, &spans, num_pixels](auto block_idx)
 				{
-					const std::size_t start_idx = spans.size() * idx;
-					for (size_t i = 0; i < spans.size(); ++i)
+					const size_t begin = block_idx * detail::s_interleave_block_size;
+					const size_t count = std::min(detail::s_interleave_block_size, num_pixels - begin);
+					switch (spans.size())
 					{
-						buffer[start_idx + i] = spans[i][idx];
+					case 1:
+						std::memcpy(buffer.data() + begin, spans.front().data() + begin, count * sizeof(T));
+						break;
+					case 2:
+						detail::interleave_block<T, 2>(buffer, spans, begin, count);
+						break;
+					case 3:
+						detail::interleave_block<T, 3>(buffer, spans, begin, count);
+						break;
+					case 4:
+						detail::interleave_block<T, 4>(buffer, spans, begin, count);
+						break;
+					default:
+						detail::interleave_block<T>(buffer, spans, begin, count);
+						break;
 					}
 				});
 		}
@@ -97,15 +203,32 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 				throw std::invalid_argument("Deinterleave: Input buffer size does not match the expected size for deinterleaving.");
 			}
 
-			// Perform deinterleaving
-			const std::size_t spans_size = channel_spans.size();
-			auto indices = std::views::iota(static_cast<std::size_t>(0), channel_spans.front().size());
-			std::for_each(std::execution::par_unseq, indices.begin(), indices.end(), [&](auto idx)
+			// Perform deinterleaving, parallelized over pixel blocks with kernels specialized on the
+			// channel count for the common cases, see `interleave` for the rationale.
+			const size_t num_pixels = channel_spans.front().size();
+			const size_t num_blocks = (num_pixels + detail::s_interleave_block_size - 1) / detail::s_interleave_block_size;
+			auto blocks = std::views::iota(static_cast<std::size_t>(0), num_blocks);
+			std::for_each(std::execution::par_unseq, blocks.begin(), blocks.end(), [&interleaved, &channel_spans, num_pixels](auto block_idx)
 				{
-					const size_t interleaved_base_idx = idx * spans_size;
-					for (size_t i = 0; i < spans_size; ++i)
+					const size_t begin = block_idx * detail::s_interleave_block_size;
+					const size_t count = std::min(detail::s_interleave_block_size, num_pixels - begin);
+					switch (channel_spans.size())
 					{
-						channel_spans[i][idx] = interleaved[interleaved_base_idx + i];
+					case 1:
+						std::memcpy(channel_spans.front().data() + begin, interleaved.data() + begin, count * sizeof(T));
+						break;
+					case 2:
+						detail::deinterleave_block<T, 2>(interleaved, channel_spans, begin, count);
+						break;
+					case 3:
+						detail::deinterleave_block<T, 3>(interleaved, channel_spans, begin, count);
+						break;
+					case 4:
+						detail::deinterleave_block<T, 4>(interleaved, channel_spans, begin, count);
+						break;
+					default:
+						detail::deinterleave_block<T>(interleaved, channel_spans, begin, count);
+						break;
 					}
 				});
 		}
@@ -3,23 +3,40 @@
 #include <ranges>
 #include <vector>
 #include <span>
+#include <functional>
 #include <future>
+#include <memory>
 
 #include "compressed/detail/scoped_timer.h"
 #include "compressed/macros.h"
+#include "compressed/enums.h"
 #include "compressed/blosc2/wrapper.h"
+#include "compressed/blosc2/context_pool.h"
+#include "compressed/blosc2/typedefs.h"
 #include "compressed/containers/chunk_span.h"
 
 namespace NAMESPACE_COMPRESSED_IMAGE
 {
 
-	// Image iterator, cannot be used in parallel as it iterates the chunks. Dereferencing it gives a span view over the current decompressed 
+	// Image iterator over the chunks of a channel. Dereferencing it gives a span view over the current decompressed
 	// context.
+	//
+	// The iterator is random-access: seeking (+=, -, [] etc.) is pure chunk index arithmetic and does not touch
+	// blosc2 at all, only dereferencing decodes. This makes partitioning a channel for standard (parallel)
+	// algorithms and adaptors like `std::views::drop` cheap. Both the decode on dereference and the write-back
+	// of the previously held chunk lease an exclusive context from the global pool (blosc2 modifies contexts on
+	// use), so partitioned copies of the iterator can walk disjoint chunk ranges concurrently. The dereferenced
+	// view itself borrows the iterator's buffer and must not be shared across threads; for parallel in-place
+	// modification with a bounded memory footprint prefer `channel<T>::for_each_chunk`.
+	//
+	// The iterator optionally supports prefetching (see `prefetch()` or `channel::async_begin()`): with it enabled,
+	// dereferencing chunk N kicks off decompression of chunk N+1 on a worker thread into a second buffer so that
+	// streaming passes no longer stall on blosc2 between chunks.
 	template <typename T>
 	struct channel_iterator
 	{
 		// Iterator type definitions
-		using iterator_category = std::forward_iterator_tag;
+		using iterator_category = std::random_access_iterator_tag;
 		using difference_type = std::ptrdiff_t;
 		using value_type = container::chunk_span<T>;
 		using pointer = value_type*;
@@ -29,19 +46,33 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 
 		channel_iterator(
 			blosc2::schunk_var_ptr<T> schunk,
-			blosc2::context_raw_ptr compression_context,
-			blosc2::context_raw_ptr decompression_context,
 			size_t chunk_index,
 			size_t width,
-			size_t height
+			size_t height,
+			enums::codec compression_codec,
+			uint8_t compression_level,
+			size_t block_size,
+			enums::filter compression_filter,
+			size_t tile_width = 0,
+			size_t tile_height = 0,
+			size_t nthreads = 1
 			)
 			: m_Schunk(schunk),
-			m_CompressionContext(compression_context),
-			m_DecompressionContext(decompression_context),
 			m_ChunkIndex(chunk_index),
 			m_Width(width),
-			m_Height(height)
+			m_Height(height),
+			m_TileWidth(tile_width),
+			m_TileHeight(tile_height),
+			m_Nthreads(nthreads),
+			m_Codec(compression_codec),
+			m_CompressionLevel(compression_level),
+			m_BlockSize(block_size),
+			m_Filter(compression_filter)
 		{
+			// Resolve the variant once up front: when it holds the fully-materialized schunk (the
+			// common case) every per-chunk access below can skip the std::visit dispatch.
+			m_DirectSchunk = m_Schunk ? std::get_if<blosc2::schunk<T>>(m_Schunk.get()) : nullptr;
+
 			// Check that we are not out of range, throw if we are
 			std::visit([&](auto& schunk)
 				{
@@ -72,95 +103,108 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 		~channel_iterator()
 		{
 			_COMPRESSED_PROFILE_FUNCTION();
-			// We need to ensure that the last chunk also gets compressed on destruction
-			// because of e.g. scope exit
-			if (m_DecompressionBufferWasRefitted)
+			// We need to ensure that the chunk held in the buffer also gets compressed on
+			// destruction because of e.g. scope exit. m_BufferChunkIndex tracks which chunk
+			// that is, independent of where the iterator was seeked to since. Chunks whose
+			// content hash is unchanged since decode are skipped, see `buffer_dirty`.
+			if (m_DecompressionBufferWasRefitted && this->buffer_dirty())
 			{
-				compress_chunk(m_CompressionContext);
-				// If we iterated through the whole range at this point we'd have a
-				// chunk index == nchunks but the last chunk was not yet compressed. In this case
-				// we have to ensure we set the index back to compress again.
-				auto chunk_idx = m_ChunkIndex;
-				std::visit([&](auto& schunk)
-					{
-						if (m_ChunkIndex == schunk.num_chunks())
-						{
-							chunk_idx = chunk_idx - 1;
-						}
-					}, *m_Schunk);
-				update_chunk(chunk_idx);
+				compress_chunk();
+				update_chunk(m_BufferChunkIndex);
 			}
 		}
 
-		/// Dereference operator: decompress the current chunk and recompress (if necessary) the previously compressed
+		/// Dereference operator: decompress the current chunk and recompress (if necessary) the previously held
 		/// chunk. value_type is a view over the current buffers. Iterator going out of scope while value_type is accessed is UB.
-		value_type operator*()
+		value_type operator*() const
 		{
-			_COMPRESSED_PROFILE_FUNCTION();
+			return this->dereference_chunk(m_ChunkIndex);
+		}
 
-			// Initialize the data, this allows the base iterator to be copied over
-			// quite cheaply
-			if (!m_Initialized)
+		/// Seek by `offset` chunks in either direction, pure index arithmetic without any decode.
+		///
+		/// \throws std::out_of_range if the target position is outside [0, num_chunks].
+		channel_iterator& operator+=(difference_type offset)
+		{
+			const auto target = static_cast<difference_type>(m_ChunkIndex) + offset;
+			if (m_Schunk)
 			{
-				m_CompressionBuffer.resize(blosc2::min_compressed_size(this->chunk_bytes()));
-				m_CompressionBufferSize = m_CompressionBuffer.size();
-				m_DecompressionBuffer.resize(blosc2::min_decompressed_size(this->chunk_bytes()));
-				m_DecompressionBufferSize = m_DecompressionBuffer.size();
-				m_Initialized = true;
+				this->dispatch_schunk([&](auto& schunk)
+					{
+						if (target < 0 || target > static_cast<difference_type>(schunk.num_chunks()))
+						{
+							throw std::out_of_range("Iterator: seek target is outside the number of chunks");
+						};
+					});
 			}
+			m_ChunkIndex = static_cast<size_t>(target);
+			return *this;
+		}
 
-			if (!this->valid())
-			{
-				throw std::runtime_error("Invalid Iterator struct encountered, cannot dereference item");
-			}
+		channel_iterator& operator-=(difference_type offset)
+		{
+			return *this += -offset;
+		}
 
-			// Compress the previously decompressed chunk if it has been modified.
-			if (m_DecompressionBufferWasRefitted && m_ChunkIndex != 0)
-			{
-				this->compress_chunk(m_CompressionContext);
-				this->update_chunk(m_ChunkIndex - 1);
-			}
+		// Pre-increment operator: move to the next chunk
+		channel_iterator& operator++()
+		{
+			return *this += 1;
+		}
 
-			// In most cases m_Decompressed.fitted_data should be identical to m_Decompressed.data. However, this is not true
-			// for the last chunk in the schunk which may not be the same decompressed size.
-			this->decompress_chunk(m_DecompressionContext);
+		channel_iterator operator++(int)
+		{
+			channel_iterator temp = *this;
+			++(*this);
+			return temp;
+		}
 
-			if (this->decompression_buffer_byte_size() % sizeof(T) != 0)
-			{
-				throw std::runtime_error(
-					std::format(
-						"Unable to dereference iterator as the decompressed size is not a multiple of {}." \
-						" Got {:L} bytes. This is likely an internal decompression error.",
-						sizeof(T), decompression_buffer_byte_size()
-					)
-				);
-			}
+		channel_iterator& operator--()
+		{
+			return *this -= 1;
+		}
 
-			std::span<T> item_span(reinterpret_cast<T*>(m_DecompressionBuffer.data()), m_DecompressionBufferSize / sizeof(T));
-			return container::chunk_span<T>(item_span, m_Width, m_Height, m_ChunkIndex, this->chunk_bytes());
+		channel_iterator operator--(int)
+		{
+			channel_iterator temp = *this;
+			--(*this);
+			return temp;
 		}
 
-		// Pre-increment operator: move to the next chunk
-		channel_iterator& operator++()
+		channel_iterator operator+(difference_type offset) const
 		{
-			++m_ChunkIndex;
-			std::visit([&](auto& schunk)
-				{
-					if (m_ChunkIndex > schunk.num_chunks())
-					{
-						throw std::out_of_range("Iterator: count exceeds number of chunks");
-					};
-				}, *m_Schunk);
-			return *this;
+			channel_iterator temp = *this;
+			temp += offset;
+			return temp;
+		}
+
+		friend channel_iterator operator+(difference_type offset, const channel_iterator& it)
+		{
+			return it + offset;
 		}
 
-		channel_iterator& operator++(int)
+		channel_iterator operator-(difference_type offset) const
 		{
 			channel_iterator temp = *this;
-			++(*this);
+			temp -= offset;
 			return temp;
 		}
 
+		/// Distance in chunks between two iterators over the same channel.
+		difference_type operator-(const channel_iterator& other) const noexcept
+		{
+			return static_cast<difference_type>(m_ChunkIndex) - static_cast<difference_type>(other.m_ChunkIndex);
+		}
+
+		/// Dereference the chunk `offset` positions away from this iterator without moving it.
+		///
+		/// The returned view borrows this iterator's internal buffer just like operator*, it is
+		/// invalidated by the next dereference (at any position).
+		value_type operator[](difference_type offset) const
+		{
+			return this->dereference_chunk(static_cast<size_t>(static_cast<difference_type>(m_ChunkIndex) + offset));
+		}
+
 		bool operator==(const channel_iterator& other) const noexcept
 		{
 			return m_ChunkIndex == other.m_ChunkIndex && m_Schunk == other.m_Schunk;
@@ -171,54 +215,229 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			return m_ChunkIndex != other.m_ChunkIndex || m_Schunk != other.m_Schunk;
 		}
 
+		auto operator<=>(const channel_iterator& other) const noexcept
+		{
+			return m_ChunkIndex <=> other.m_ChunkIndex;
+		}
+
 		/// Return the chunk index the iterator is currently at.
 		size_t chunk_index() const noexcept { return m_ChunkIndex; }
 
 		/// Return the chunk size of all but the last chunk.
 		size_t chunk_elements() const noexcept
 		{
-			return std::visit([&](auto& schunk) -> size_t
+			return this->dispatch_schunk([&](auto& schunk) -> size_t
 				{
 					return schunk.chunk_elements();
-				}, *m_Schunk);
+				});
 		}
 
 		/// Return the chunk size of all but the last chunk.
 		size_t chunk_bytes() const noexcept
 		{
-			return std::visit([&](auto& schunk) -> size_t
+			return this->dispatch_schunk([&](auto& schunk) -> size_t
 				{
 					return schunk.chunk_bytes();
-				}, *m_Schunk);
+				});
 		}
 
-	private:
+		/// Enable or disable background prefetching of the next chunk.
+		///
+		/// With prefetching enabled, dereferencing the iterator additionally decompresses the upcoming chunk
+		/// on a worker thread (using its own pooled decompression context and buffer) so the next dereference
+		/// only has to adopt the already-decompressed data. This roughly doubles the transient memory footprint
+		/// of the iteration in exchange for hiding the decode latency of streaming passes.
+		void prefetch(bool enabled) noexcept
+		{
+			m_PrefetchEnabled = enabled;
+		}
 
-		/// Buffers for storing compressed and decompressed data. These hold enough data for ChunkSize
-		/// but may be smaller, thus we keep track of m_CompressionBufferSize and m_DecompressionBufferSize
-		util::default_init_vector<std::byte> m_CompressionBuffer;
-		bool m_CompressionBufferWasRefitted = false;
-		size_t m_CompressionBufferSize = 0;	// The fitted size of the container (only holding the compressed size)
+		/// Whether background prefetching of the next chunk is enabled.
+		bool prefetch() const noexcept
+		{
+			return m_PrefetchEnabled;
+		}
 
-		std::vector<std::byte> m_DecompressionBuffer;
-		bool m_DecompressionBufferWasRefitted = false;
-		size_t m_DecompressionBufferSize = 0;	// The fitted size of the container (only holding the decompressed size)
+		/// Enable or disable read-only iteration.
+		///
+		/// A read-only iterator never writes back into the super-chunk, regardless of what happens
+		/// to the dereferenced view, so pure scans skip the compression on every advance. Obtained
+		/// through `channel<T>::begin() const`.
+		void read_only(bool enabled) noexcept
+		{
+			m_ReadOnly = enabled;
+		}
+
+		/// Whether the iterator is in read-only mode and never writes back.
+		bool read_only() const noexcept
+		{
+			return m_ReadOnly;
+		}
 
-		/// Pointers to the blosc2 structs. The data is owned by the `channel` struct and we just have a view over it.
+		/// Set the pointwise transforms to fuse into each decode, applied in order right after a
+		/// chunk is decompressed. Used by read-only iteration over a channel with a pending `map`
+		/// queue (mutable iteration materializes the queue up front instead).
+		void transforms(std::vector<std::function<void(std::span<T>)>> transforms) noexcept
+		{
+			m_Transforms = std::move(transforms);
+		}
+
+	private:
+
+		/// A chunk decompressed ahead of time by the prefetch worker, adopted on the next dereference.
+		struct prefetched_chunk
+		{
+			std::vector<std::byte> buffer;
+			size_t fitted_size = 0;
+			size_t chunk_index = 0;
+		};
+
+		/// Buffers for storing compressed and decompressed data. These hold enough data for ChunkSize
+		/// but may be smaller, thus we keep track of m_CompressionBufferSize and m_DecompressionBufferSize.
+		/// The buffers are a cache of the dereferenced chunk rather than part of the iterator's logical
+		/// state (the chunk index), they are mutable so dereferencing stays const as the iterator concepts require.
+		mutable util::default_init_vector<std::byte> m_CompressionBuffer;
+		mutable bool m_CompressionBufferWasRefitted = false;
+		mutable size_t m_CompressionBufferSize = 0;	// The fitted size of the container (only holding the compressed size)
+
+		mutable std::vector<std::byte> m_DecompressionBuffer;
+		mutable bool m_DecompressionBufferWasRefitted = false;
+		mutable size_t m_DecompressionBufferSize = 0;	// The fitted size of the container (only holding the decompressed size)
+
+		/// Pointer to the blosc2 struct. The data is owned by the `channel` struct and we just have a view over it.
 		blosc2::schunk_var_ptr<T> m_Schunk;
-		blosc2::context_raw_ptr m_CompressionContext = nullptr;
-		blosc2::context_raw_ptr	m_DecompressionContext = nullptr;
+		/// Direct pointer into the variant when it holds a `blosc2::schunk<T>`, nullptr otherwise.
+		/// Kept alive by m_Schunk, resolved once at construction, see `dispatch_schunk`.
+		blosc2::schunk<T>* m_DirectSchunk = nullptr;
 
 		size_t m_ChunkIndex = 0;
+		/// Which chunk the decompression buffer currently holds, only meaningful while
+		/// m_DecompressionBufferWasRefitted is set. Tracked separately from m_ChunkIndex so
+		/// write-back targets the right chunk after random-access seeks and `operator[]`.
+		mutable size_t m_BufferChunkIndex = 0;
 		size_t m_Width = 0;
 		size_t m_Height = 0;
+		size_t m_TileWidth = 0;
+		size_t m_TileHeight = 0;
+		/// Thread count for the contexts leased from the global pool on decode and write-back.
+		size_t m_Nthreads = 1;
+
+		/// Compression parameters the write-back contexts are leased with, mirroring the owning channel.
+		enums::codec m_Codec = enums::codec::lz4;
+		uint8_t m_CompressionLevel = 9;
+		size_t m_BlockSize = 0;
+		enums::filter m_Filter = enums::filter::shuffle;
 
 		/// this is set in the dereference operator to only initialize on first access
 		/// not on setup.
-		bool m_Initialized = false;
+		mutable bool m_Initialized = false;
+
+		bool m_PrefetchEnabled = false;
+
+		/// Read-only iterators never write back, see `read_only`.
+		bool m_ReadOnly = false;
+
+		/// Hash of the decompressed buffer as of decode time (after any fused transforms), the
+		/// dirty gate for write-back. Part of the buffer cache, not the logical iterator state.
+		mutable uint64_t m_DecodeContentHash = 0;
+
+		/// Pointwise transforms fused into each decode, see `transforms`.
+		std::vector<std::function<void(std::span<T>)>> m_Transforms{};
+		/// In-flight background decompression of the upcoming chunk. Held through a shared_ptr so the
+		/// iterator stays copyable (copies share the in-flight result, whichever dereferences first adopts it).
+		mutable std::shared_ptr<std::future<prefetched_chunk>> m_Prefetched;
 
 	private:
 
+		/// Shared implementation of `operator*` and `operator[]`: make the decompression buffer hold
+		/// `chunk_index`, writing back the previously held chunk if necessary, and return a view over it.
+		value_type dereference_chunk(size_t chunk_index) const
+		{
+			_COMPRESSED_PROFILE_FUNCTION();
+
+			// Initialize the data, this allows the base iterator to be copied over
+			// quite cheaply
+			if (!m_Initialized)
+			{
+				m_CompressionBuffer.resize(blosc2::min_compressed_size(this->chunk_bytes()));
+				m_CompressionBufferSize = m_CompressionBuffer.size();
+				m_DecompressionBuffer.resize(blosc2::min_decompressed_size(this->chunk_bytes()));
+				m_DecompressionBufferSize = m_DecompressionBuffer.size();
+				m_Initialized = true;
+			}
+
+			if (!this->valid(chunk_index))
+			{
+				throw std::runtime_error("Invalid Iterator struct encountered, cannot dereference item");
+			}
+
+			// Repeated dereference of the same position (or `operator[]` with offset 0): the buffer
+			// already holds this chunk, hand out the existing view without decoding again.
+			if (!m_DecompressionBufferWasRefitted || m_BufferChunkIndex != chunk_index)
+			{
+				// Compress the previously decompressed chunk if one is held and its content actually
+				// changed since decode (see `buffer_dirty`), read-mostly passes skip the codec
+				// entirely. The buffer tracks its own chunk index so this stays correct after
+				// arbitrary seeks, not just `++`.
+				if (m_DecompressionBufferWasRefitted && this->buffer_dirty())
+				{
+					this->compress_chunk();
+					this->update_chunk(m_BufferChunkIndex);
+				}
+
+				// In most cases m_Decompressed.fitted_data should be identical to m_Decompressed.data. However, this is not true
+				// for the last chunk in the schunk which may not be the same decompressed size.
+				// If prefetching is enabled the chunk was (usually) already decompressed in the background while
+				// the caller was still processing the previous one, in which case we only have to adopt that buffer.
+				if (!this->consume_prefetch(chunk_index))
+				{
+					this->decompress_chunk(chunk_index);
+				}
+				m_BufferChunkIndex = chunk_index;
+
+				// Fuse any transforms handed down by the owning channel (read-only iteration over a
+				// channel with a pending `map` queue), then snapshot the content hash so write-back
+				// can tell an untouched buffer from a modified one.
+				auto fitted = std::span<T>(reinterpret_cast<T*>(m_DecompressionBuffer.data()), m_DecompressionBufferSize / sizeof(T));
+				for (const auto& transform : m_Transforms)
+				{
+					transform(fitted);
+				}
+				m_DecodeContentHash = hash_bytes(std::span<const std::byte>(m_DecompressionBuffer.data(), m_DecompressionBufferSize));
+			}
+			if (m_PrefetchEnabled)
+			{
+				this->launch_prefetch(chunk_index + 1);
+			}
+
+			if (this->decompression_buffer_byte_size() % sizeof(T) != 0)
+			{
+				throw std::runtime_error(
+					std::format(
+						"Unable to dereference iterator as the decompressed size is not a multiple of {}." \
+						" Got {:L} bytes. This is likely an internal decompression error.",
+						sizeof(T), decompression_buffer_byte_size()
+					)
+				);
+			}
+
+			std::span<T> item_span(reinterpret_cast<T*>(m_DecompressionBuffer.data()), m_DecompressionBufferSize / sizeof(T));
+			return container::chunk_span<T>(item_span, m_Width, m_Height, chunk_index, this->chunk_bytes(), m_TileWidth, m_TileHeight);
+		}
+
+		/// Invoke `func` with the concrete super-chunk, bypassing the variant dispatch when the
+		/// fully-materialized `blosc2::schunk<T>` is held. The schunk wrappers are `final` so the
+		/// calls behind this devirtualize, which matters on the per-chunk hot path of the iteration.
+		template <typename Func>
+		decltype(auto) dispatch_schunk(Func&& func) const
+		{
+			if (m_DirectSchunk)
+			{
+				return func(*m_DirectSchunk);
+			}
+			return std::visit(std::forward<Func>(func), *m_Schunk);
+		}
+
 		size_t compression_buffer_byte_size() const noexcept
 		{
 			return m_CompressionBufferSize;
@@ -239,8 +458,8 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			return m_DecompressionBuffer.size();
 		}
 
-		/// Check for validity of this struct.
-		bool valid() const
+		/// Check for validity of this struct for dereferencing `chunk_index`.
+		bool valid(size_t chunk_index) const
 		{
 			if (!m_Schunk)
 			{
@@ -248,17 +467,10 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 			}
 			return std::visit([&](auto& schunk)
 				{
-					// Check that the schunk, compression and decompression ptrs are not null
-					bool ptrs_valid = m_Schunk && m_CompressionContext && m_DecompressionContext;
-					if (!ptrs_valid)
-					{
-						return false;
-					}
-
 					bool compression_size_valid = m_CompressionBufferSize <= m_CompressionBuffer.size();
 					bool decompression_size_valid = m_DecompressionBufferSize <= m_DecompressionBuffer.size();
 
-					bool idx_valid = m_ChunkIndex < schunk.num_chunks();
+					bool idx_valid = chunk_index < schunk.num_chunks();
 					bool compressed_data_valid = compression_buffer_max_byte_size() >= blosc2::min_compressed_size(this->chunk_bytes());
 					bool decompressed_data_valid = decompression_buffer_max_byte_size() >= blosc2::min_decompressed_size(this->chunk_bytes());
 
@@ -266,41 +478,147 @@ namespace NAMESPACE_COMPRESSED_IMAGE
 				}, *m_Schunk);
 		}
 
-		/// Decompress a chunk using the given context and chunk pointer. Decompressing into the buffer
-		void decompress_chunk(blosc2::context_raw_ptr decompression_context_ptr)
+		/// Adopt the prefetched decompression of `chunk_index` if one is available.
+		///
+		/// \return whether the chunk was adopted from the prefetch buffer, false means the caller
+		///         has to decompress synchronously (prefetching disabled, first dereference or a stale result).
+		bool consume_prefetch(size_t chunk_index) const
+		{
+			if (!m_Prefetched || !m_Prefetched->valid())
+			{
+				return false;
+			}
+			auto result = m_Prefetched->get();
+			m_Prefetched.reset();
+
+			// A stale result (e.g. after seeking or copying the iterator and advancing the copy) is simply dropped.
+			if (result.chunk_index != chunk_index)
+			{
+				return false;
+			}
+
+			m_DecompressionBuffer = std::move(result.buffer);
+			// The worker sizes its buffer to the full chunk capacity, keep it that way so later
+			// synchronous decodes of a full-size chunk are never constrained by a truncated one;
+			// only the fitted size below shrinks to the chunk's actual content.
+			m_DecompressionBuffer.resize(
+				std::max<size_t>(m_DecompressionBuffer.size(), blosc2::min_decompressed_size(this->chunk_bytes()))
+			);
+			m_DecompressionBufferSize = result.fitted_size;
+			m_DecompressionBufferWasRefitted = true;
+			return true;
+		}
+
+		/// Kick off decompression of `chunk_index` on a worker thread, no-op if the index is out of range.
+		///
+		/// The worker owns its buffer and leases a single-threaded context from the global pool so it never
+		/// races the iterator's own contexts, and it keeps the super-chunk alive through the shared_ptr.
+		void launch_prefetch(size_t chunk_index) const
+		{
+			auto num_chunks = this->dispatch_schunk([](auto& schunk) { return schunk.num_chunks(); });
+			if (chunk_index >= num_chunks)
+			{
+				m_Prefetched.reset();
+				return;
+			}
+
+			auto schunk_ptr = m_Schunk;
+			auto buffer_bytes = blosc2::min_decompressed_size(this->chunk_bytes());
+			m_Prefetched = std::make_shared<std::future<prefetched_chunk>>(std::async(std::launch::async,
+				[schunk_ptr, chunk_index, buffer_bytes]()
+				{
+					auto lease = blosc2::global_context_pool().checkout_decompression(1);
+
+					prefetched_chunk result;
+					result.chunk_index = chunk_index;
+					result.buffer.resize(buffer_bytes);
+
+					auto buffer_span = std::span<T>(reinterpret_cast<T*>(result.buffer.data()), result.buffer.size() / sizeof(T));
+					std::visit([&](auto& schunk)
+						{
+							schunk.chunk(lease.get(), buffer_span, chunk_index);
+							result.fitted_size = schunk.chunk_bytes(chunk_index);
+						}, *schunk_ptr);
+
+					return result;
+				}));
+		}
+
+		/// Decompress `chunk_index` into the decompression buffer.
+		///
+		/// Leases an exclusive context from the global pool, blosc2 modifies contexts on use so the
+		/// channel-owned context cannot be shared across concurrently dereferenced iterator copies.
+		void decompress_chunk(size_t chunk_index) const
 		{
 			_COMPRESSED_PROFILE_FUNCTION();
-			auto buffer_span = std::span<T>(reinterpret_cast<T*>(m_DecompressionBuffer.data()), m_DecompressionBufferSize / sizeof(T));
+			auto lease = blosc2::global_context_pool().checkout_decompression(m_Nthreads);
+			// Size the destination from the buffer's capacity, not from m_DecompressionBufferSize
+			// which holds the fitted size of the previously decoded chunk. After a truncated final
+			// chunk that fitted size is too small for a full chunk, which random access (seeking
+			// backwards, `operator[]`) can revisit at any time.
+			auto buffer_span = std::span<T>(reinterpret_cast<T*>(m_DecompressionBuffer.data()), m_DecompressionBuffer.size() / sizeof(T));
 			
 			// apply the decompression.
-			std::visit([&](auto& schunk) 
+			this->dispatch_schunk([&](auto& schunk) 
 				{
-					schunk.chunk(decompression_context_ptr, buffer_span, m_ChunkIndex);
-					m_DecompressionBufferSize = schunk.chunk_bytes(m_ChunkIndex);
+					schunk.chunk(lease.get(), buffer_span, chunk_index);
+					m_DecompressionBufferSize = schunk.chunk_bytes(chunk_index);
 					m_DecompressionBufferWasRefitted = true;
-				}, *m_Schunk);
+				});
+		}
+
+		/// FNV-1a over the decompressed bytes, the same cheap well-distributed scheme the dedup
+		/// chunk store uses for its compressed bytes.
+		static uint64_t hash_bytes(std::span<const std::byte> bytes) noexcept
+		{
+			uint64_t hash = 0xcbf29ce484222325ull;
+			for (const auto byte : bytes)
+			{
+				hash ^= static_cast<uint64_t>(byte);
+				hash *= 0x100000001b3ull;
+			}
+			return hash;
 		}
 
-		/// Compress a chunk from the decompressed view into the compressed view
-		void compress_chunk(blosc2::context_raw_ptr compression_context_ptr)
+		/// Whether the decompressed buffer changed since it was decoded and has to be written back.
+		///
+		/// Compared via the content hash snapshotted at decode time, so read-mostly passes -- which
+		/// previously paid a full compression on every advance -- skip the codec for untouched
+		/// chunks. A 64-bit hash collision between the old and the new content would drop a write,
+		/// which is vanishingly unlikely for chunk-sized buffers. Read-only iterators are never
+		/// dirty.
+		bool buffer_dirty() const
+		{
+			if (m_ReadOnly)
+			{
+				return false;
+			}
+			auto bytes = std::span<const std::byte>(m_DecompressionBuffer.data(), m_DecompressionBufferSize);
+			return hash_bytes(bytes) != m_DecodeContentHash;
+		}
+
+		/// Compress the decompressed view into the compression buffer, leasing an exclusive pooled
+		/// context with the compression parameters of the owning channel.
+		void compress_chunk() const
 		{
 			_COMPRESSED_PROFILE_FUNCTION();
+			auto lease = blosc2::global_context_pool().checkout_compression<T>(m_Nthreads, m_Codec, m_CompressionLevel, m_BlockSize, m_Filter);
 			std::span<T> fitted = { reinterpret_cast<T*>(m_DecompressionBuffer.data()), m_DecompressionBufferSize / sizeof(T) };
-			auto compressed_size = blosc2::compress(compression_context_ptr, fitted, m_CompressionBuffer);
+			auto compressed_size = blosc2::compress(lease.get(), fitted, m_CompressionBuffer);
 			
 			m_CompressionBufferSize = compressed_size;
 			m_CompressionBufferWasRefitted = true;
 		}
 
 		/// Update and replace the chunk inside of the superchunk at the given index.
-		void update_chunk(size_t chunk_index)
+		void update_chunk(size_t chunk_index) const
 		{
 			_COMPRESSED_PROFILE_FUNCTION();
 			auto byte_span = std::span<std::byte>(m_CompressionBuffer.data(), this->compression_buffer_byte_size());
-			std::visit([&](auto& schunk)
+			this->dispatch_schunk([&](auto& schunk)
 				{
 					schunk.set_chunk(byte_span, chunk_index);
-				}, *m_Schunk);
+				});
 		}
 	};
 
@@ -0,0 +1,246 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "macros.h"
+#include "enums.h"
+#include "constants.h"
+#include "image.h"
+#include "util.h"
+#include "blosc2/util.h"
+#include "detail/scoped_timer.h"
+#include "detail/thread_affinity.h"
+#include "detail/thread_budget.h"
+
+#ifdef COMPRESSED_IMAGE_OIIO_AVAILABLE
+#include <OpenImageIO/imageio.h>
+#endif // COMPRESSED_IMAGE_OIIO_AVAILABLE
+
+
+namespace NAMESPACE_COMPRESSED_IMAGE
+{
+
+#ifdef COMPRESSED_IMAGE_OIIO_AVAILABLE
+
+	namespace detail
+	{
+
+		/// Estimate the transient scratch memory one `image<T>::read` pipeline will allocate for the
+		/// given file: the double-buffered interleaved buffers, the deinterleave buffers and the
+		/// compression scratch (see `read_impl`). The worst case of all channels being contiguous is
+		/// assumed, actual usage may be lower when the requested channels split into smaller runs.
+		template <typename T>
+		size_t estimate_read_scratch_bytes(const std::filesystem::path& filepath, int subimage, size_t chunk_size)
+		{
+			auto input_ptr = OIIO::ImageInput::open(filepath);
+			if (!input_ptr)
+			{
+				throw std::invalid_argument(std::format("File {} does not exist on disk", filepath.string()));
+			}
+			if (!input_ptr->seek_subimage(subimage, 0))
+			{
+				throw std::invalid_argument(
+					std::format(
+						"File '{}' does not have a subimage {}, cannot seek to it", filepath.string(), subimage
+					)
+				);
+			}
+			const OIIO::ImageSpec& spec = input_ptr->spec();
+
+			size_t chunk_size_aligned = 0;
+			if (spec.tile_height != 0)
+			{
+				chunk_size_aligned = util::align_chunk_to_tile_bytes<T>(spec.width, spec.tile_height, chunk_size);
+			}
+			else
+			{
+				chunk_size_aligned = util::align_chunk_to_scanlines_bytes<T>(spec.width, chunk_size);
+			}
+
+			const size_t num_channels = static_cast<size_t>(spec.nchannels);
+			// Two interleaved swap buffers of chunk_size * nchannels plus one deinterleave buffer
+			// per channel plus the compression scratch.
+			return chunk_size_aligned * num_channels * 3 + blosc2::min_compressed_size(chunk_size_aligned);
+		}
+
+	} // detail
+
+
+	/// \brief Read multiple image files concurrently under a shared memory budget.
+	///
+	/// Requires CompressedImage to have been compiled with OpenImageIO support.
+	///
+	/// Calling `image<T>::read` from a caller-owned thread pool both oversubscribes the blosc2
+	/// worker threads and lets every call allocate its own read scratch. This schedules the reads
+	/// over one internal worker pool instead: the number of concurrent pipelines is derived from
+	/// `memory_budget` divided by the largest per-file scratch estimate, so the transient memory
+	/// stays hard-capped no matter how many paths are passed. The workers register against the
+	/// library-wide thread budget (see `compressed::thread_budget`) so the blosc2 threads are
+	/// divided across the concurrently running pipelines rather than multiplied by them.
+	///
+	/// The files are read in work-stealing order but the returned images are in `paths` order.
+	///
+	/// \param paths The image files to read.
+	/// \param memory_budget The cap (in bytes) on the transient scratch memory of the batch,
+	///						 defaults to 1GB. The compressed images themselves do not count
+	///						 towards this. Must fit at least the scratch of the largest file.
+	/// \param subimage The subimage to extract the channels from (default: 0).
+	/// \param compression_codec The compression codec to use (default: LZ4).
+	/// \param compression_level The compression level (default: 9).
+	/// \param block_size The block size to apply to the compressed data.
+	/// \param chunk_size The chunk size to apply to the compressed data. Must be a multiple of sizeof(T).
+	///
+	/// \return The compressed images, one per path in the same order.
+	///
+	/// \throws std::invalid_argument if a file does not exist, the subimage is invalid or
+	///			`memory_budget` cannot fit the scratch of the largest file.
+	template <typename T>
+	std::vector<image<T>> read_batch(
+		std::span<const std::filesystem::path> paths,
+		size_t memory_budget = s_default_batch_memory_budget,
+		int subimage = 0,
+		enums::codec compression_codec = enums::codec::lz4,
+		size_t compression_level = 9,
+		size_t block_size = s_default_blocksize,
+		size_t chunk_size = s_default_chunksize
+	)
+	{
+		_COMPRESSED_PROFILE_FUNCTION();
+		if (paths.empty())
+		{
+			return {};
+		}
+
+		// Size the worker pool so that even with every pipeline at its worst-case scratch usage
+		// the budget holds.
+		size_t max_scratch_bytes = 0;
+		for (const auto& path : paths)
+		{
+			max_scratch_bytes = std::max(max_scratch_bytes, detail::estimate_read_scratch_bytes<T>(path, subimage, chunk_size));
+		}
+		if (max_scratch_bytes > memory_budget)
+		{
+			throw std::invalid_argument(
+				std::format(
+					"Cannot read batch within a memory budget of {:L} bytes as a single read pipeline already"
+					" requires up to {:L} bytes of scratch memory. Raise the budget or lower the chunk size.",
+					memory_budget, max_scratch_bytes
+				)
+			);
+		}
+
+		const size_t concurrency = std::min({
+			paths.size(),
+			memory_budget / max_scratch_bytes,
+			std::max<size_t>(thread_budget(), 1)
+			});
+
+		std::vector<std::optional<image<T>>> results(paths.size());
+		std::atomic<size_t> next_index = 0;
+		std::atomic<bool> failed = false;
+		std::mutex error_mutex;
+		std::exception_ptr first_error = nullptr;
+
+		auto worker = [&](size_t worker_index)
+			{
+				// Optionally pin the worker to one affinity group (see `compressed::affinity_groups`)
+				// so the pipeline and the scratch it first-touches stay on a single NUMA node.
+				detail::pin_current_thread(worker_index);
+
+				// Register against the global thread budget for the lifetime of the worker so the
+				// blosc2 threads are divided across the concurrently running pipelines.
+				auto budget_token = detail::register_thread_consumer();
+				while (!failed.load(std::memory_order_relaxed))
+				{
+					const size_t index = next_index.fetch_add(1, std::memory_order_relaxed);
+					if (index >= paths.size())
+					{
+						break;
+					}
+
+					try
+					{
+						results[index].emplace(image<T>::read(
+							paths[index],
+							subimage,
+							compression_codec,
+							compression_level,
+							block_size,
+							chunk_size
+						));
+					}
+					catch (...)
+					{
+						std::lock_guard<std::mutex> lock(error_mutex);
+						if (!first_error)
+						{
+							first_error = std::current_exception();
+						}
+						failed.store(true, std::memory_order_relaxed);
+					}
+				}
+			};
+
+		std::vector<std::thread> workers;
+		workers.reserve(concurrency);
+		for (auto worker_index : std::views::iota(size_t{ 0 }, concurrency))
+		{
+			workers.emplace_back(worker, worker_index);
+		}
+		for (auto& thread : workers)
+		{
+			thread.join();
+		}
+
+		if (first_error)
+		{
+			std::rethrow_exception(first_error);
+		}
+
+		std::vector<image<T>> images;
+		images.reserve(paths.size());
+		for (auto& result : results)
+		{
+			images.push_back(std::move(result.value()));
+		}
+		return images;
+	}
+
+
+	/// Convenience overload reading the batch from a vector of paths, see the span overload.
+	template <typename T>
+	std::vector<image<T>> read_batch(
+		const std::vector<std::filesystem::path>& paths,
+		size_t memory_budget = s_default_batch_memory_budget,
+		int subimage = 0,
+		enums::codec compression_codec = enums::codec::lz4,
+		size_t compression_level = 9,
+		size_t block_size = s_default_blocksize,
+		size_t chunk_size = s_default_chunksize
+	)
+	{
+		return read_batch<T>(
+			std::span<const std::filesystem::path>(paths),
+			memory_budget,
+			subimage,
+			compression_codec,
+			compression_level,
+			block_size,
+			chunk_size
+		);
+	}
+
+#endif // COMPRESSED_IMAGE_OIIO_AVAILABLE
+
+} // NAMESPACE_COMPRESSED_IMAGE
@@ -0,0 +1,310 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "macros.h"
+#include "enums.h"
+#include "constants.h"
+#include "image.h"
+#include "detail/oiio_util.h"
+#include "detail/scoped_timer.h"
+#include "detail/thread_affinity.h"
+#include "detail/thread_budget.h"
+
+#ifdef COMPRESSED_IMAGE_OIIO_AVAILABLE
+#include <OpenImageIO/imageio.h>
+#endif // COMPRESSED_IMAGE_OIIO_AVAILABLE
+
+
+namespace NAMESPACE_COMPRESSED_IMAGE
+{
+
+#ifdef COMPRESSED_IMAGE_OIIO_AVAILABLE
+
+	namespace detail
+	{
+
+		/// A single unit of work for `read_parallel`: one contiguous channel range of one subimage.
+		/// The ranges are what `detail::get_contiguous_channels` hands back for the subimage's full
+		/// channel list, so concatenating the per-range results in task order restores file order.
+		struct parallel_read_task
+		{
+			size_t subimage_index = 0;
+			int subimage = 0;
+			int chbegin = 0;
+			int chend = 0;
+		};
+
+	} // detail
+
+
+	/// \brief Read multiple subimages of a file, parallelizing over subimages and channel ranges.
+	///
+	/// Requires CompressedImage to have been compiled with OpenImageIO support.
+	///
+	/// `image<T>::read` walks the contiguous channel ranges of a subimage (e.g. {RGBA}, {Z},
+	/// {crypto00..}) one after another through a single `OIIO::ImageInput`. For deep multi-AOV
+	/// files with many such ranges that serializes both the decode and the re-compression. This
+	/// function instead turns every (subimage, contiguous channel range) pair into an independent
+	/// task with its own `ImageInput` and runs the per-range read pipelines concurrently, merging
+	/// the resulting channels back into one image per subimage in file order. The results are
+	/// identical to calling `image<T>::read` once per subimage.
+	///
+	/// Each worker registers against the library-wide thread budget (see `compressed::thread_budget`)
+	/// so the blosc2 threads are divided across the concurrently running pipelines rather than
+	/// multiplied by them. Note that every pipeline allocates its own read scratch, if you need a
+	/// hard cap on transient memory across many files use `compressed::read_batch` instead.
+	///
+	/// The tasks are pulled in work-stealing order but the returned images are in `subimages`
+	/// order with the channels of each image in file order.
+	///
+	/// \param filepath The image file to read.
+	/// \param subimages The subimages to read, one image is returned per entry.
+	/// \param compression_codec The compression codec to use (default: LZ4).
+	/// \param compression_level The compression level (default: 9).
+	/// \param block_size The block size to apply to the compressed data.
+	/// \param chunk_size The chunk size to apply to the compressed data. Must be a multiple of sizeof(T).
+	///
+	/// \return The compressed images, one per subimage in the same order.
+	///
+	/// \throws std::invalid_argument if the file does not exist or one of the subimages is invalid.
+	template <typename T>
+	std::vector<image<T>> read_parallel(
+		std::filesystem::path filepath,
+		std::vector<int> subimages,
+		enums::codec compression_codec = enums::codec::lz4,
+		size_t compression_level = 9,
+		size_t block_size = s_default_blocksize,
+		size_t chunk_size = s_default_chunksize
+	)
+	{
+		_COMPRESSED_PROFILE_FUNCTION();
+		if (subimages.empty())
+		{
+			return {};
+		}
+
+		// Probe the file once to collect the per-subimage specs and contiguous channel ranges,
+		// the workers then open their own handles.
+		auto probe_ptr = OIIO::ImageInput::open(filepath);
+		if (!probe_ptr)
+		{
+			throw std::invalid_argument(std::format("File {} does not exist on disk", filepath.string()));
+		}
+
+		std::vector<OIIO::ImageSpec> specs;
+		std::vector<detail::parallel_read_task> tasks;
+		for (auto subimage_index : std::views::iota(size_t{ 0 }, subimages.size()))
+		{
+			if (!probe_ptr->seek_subimage(subimages[subimage_index], 0))
+			{
+				throw std::invalid_argument(
+					std::format(
+						"File '{}' does not have a subimage {}, cannot seek to it",
+						filepath.string(), subimages[subimage_index]
+					)
+				);
+			}
+			specs.push_back(probe_ptr->spec());
+
+			for (const auto& [chbegin, chend] : detail::get_contiguous_channels(probe_ptr, specs.back().channelnames))
+			{
+				tasks.push_back(detail::parallel_read_task{ subimage_index, subimages[subimage_index], chbegin, chend });
+			}
+		}
+
+		// A single task means a single serial pipeline, don't bother spinning up workers and
+		// hand the already opened probe handle straight to `image<T>::read`.
+		if (tasks.size() < 2)
+		{
+			std::vector<image<T>> images;
+			images.push_back(image<T>::read(
+				std::move(probe_ptr),
+				specs.front().channelnames,
+				subimages.front(),
+				compression_codec,
+				compression_level,
+				block_size,
+				chunk_size
+			));
+			return images;
+		}
+		probe_ptr.reset();
+
+		const size_t concurrency = std::min(
+			tasks.size(),
+			std::max<size_t>(thread_budget(), 1)
+		);
+
+		std::vector<std::optional<image<T>>> results(tasks.size());
+		std::atomic<size_t> next_index = 0;
+		std::atomic<bool> failed = false;
+		std::mutex error_mutex;
+		std::exception_ptr first_error = nullptr;
+
+		auto worker = [&](size_t worker_index)
+			{
+				// Optionally pin the worker to one affinity group (see `compressed::affinity_groups`)
+				// so the pipeline and the scratch it first-touches stay on a single NUMA node.
+				detail::pin_current_thread(worker_index);
+
+				// Register against the global thread budget for the lifetime of the worker so the
+				// blosc2 threads are divided across the concurrently running pipelines.
+				auto budget_token = detail::register_thread_consumer();
+				while (!failed.load(std::memory_order_relaxed))
+				{
+					const size_t index = next_index.fetch_add(1, std::memory_order_relaxed);
+					if (index >= tasks.size())
+					{
+						break;
+					}
+
+					try
+					{
+						const auto& task = tasks[index];
+						auto input_ptr = OIIO::ImageInput::open(filepath);
+						if (!input_ptr)
+						{
+							throw std::runtime_error(
+								std::format("Failed to re-open file {} for parallel read", filepath.string())
+							);
+						}
+
+						const auto& channelnames = specs[task.subimage_index].channelnames;
+						std::vector<std::string> range_channelnames(
+							channelnames.begin() + task.chbegin,
+							channelnames.begin() + task.chend
+						);
+						results[index].emplace(image<T>::read(
+							std::move(input_ptr),
+							std::move(range_channelnames),
+							task.subimage,
+							compression_codec,
+							compression_level,
+							block_size,
+							chunk_size
+						));
+					}
+					catch (...)
+					{
+						std::lock_guard<std::mutex> lock(error_mutex);
+						if (!first_error)
+						{
+							first_error = std::current_exception();
+						}
+						failed.store(true, std::memory_order_relaxed);
+					}
+				}
+			};
+
+		std::vector<std::thread> workers;
+		workers.reserve(concurrency);
+		for (auto worker_index : std::views::iota(size_t{ 0 }, concurrency))
+		{
+			workers.emplace_back(worker, worker_index);
+		}
+		for (auto& thread : workers)
+		{
+			thread.join();
+		}
+
+		if (first_error)
+		{
+			std::rethrow_exception(first_error);
+		}
+
+		// Stitch the per-range partial images back together, one image per subimage. The tasks
+		// were generated in range order per subimage so moving the channels out in task order
+		// restores the file's channel order.
+		std::vector<image<T>> images;
+		images.reserve(subimages.size());
+		for (auto subimage_index : std::views::iota(size_t{ 0 }, subimages.size()))
+		{
+			std::vector<compressed::channel<T>> channels;
+			std::vector<std::string> channelnames;
+			for (auto task_index : std::views::iota(size_t{ 0 }, tasks.size()))
+			{
+				if (tasks[task_index].subimage_index != subimage_index)
+				{
+					continue;
+				}
+				auto& partial = results[task_index].value();
+				for (auto& channel : partial.channels())
+				{
+					channels.push_back(std::move(channel));
+				}
+				for (auto& channelname : partial.channelnames())
+				{
+					channelnames.push_back(std::move(channelname));
+				}
+			}
+
+			auto img = image<T>(
+				std::move(channels),
+				static_cast<size_t>(specs[subimage_index].width),
+				static_cast<size_t>(specs[subimage_index].height),
+				std::move(channelnames)
+			);
+			img.metadata(image<T>::read_oiio_metadata(specs[subimage_index]));
+			images.push_back(std::move(img));
+		}
+		return images;
+	}
+
+
+	/// \brief Read a single image file, parallelizing over its contiguous channel ranges.
+	///
+	/// Requires CompressedImage to have been compiled with OpenImageIO support.
+	///
+	/// Convenience overload over the multi-subimage `read_parallel` reading a single subimage,
+	/// see that overload for the parallelization strategy. Files whose channels form fewer than
+	/// two contiguous ranges (e.g. a plain RGBA image) gain nothing from the parallel mode and
+	/// are simply read through a single serial pipeline. The result is identical to
+	/// `image<T>::read` on the same file.
+	///
+	/// \param filepath The image file to read.
+	/// \param subimage The subimage to extract the channels from (default: 0).
+	/// \param compression_codec The compression codec to use (default: LZ4).
+	/// \param compression_level The compression level (default: 9).
+	/// \param block_size The block size to apply to the compressed data.
+	/// \param chunk_size The chunk size to apply to the compressed data. Must be a multiple of sizeof(T).
+	///
+	/// \return The compressed image, equivalent to `image<T>::read(filepath, subimage, ...)`.
+	///
+	/// \throws std::invalid_argument if the file does not exist or the subimage is invalid.
+	template <typename T>
+	image<T> read_parallel(
+		std::filesystem::path filepath,
+		int subimage = 0,
+		enums::codec compression_codec = enums::codec::lz4,
+		size_t compression_level = 9,
+		size_t block_size = s_default_blocksize,
+		size_t chunk_size = s_default_chunksize
+	)
+	{
+		_COMPRESSED_PROFILE_FUNCTION();
+		auto images = read_parallel<T>(
+			std::move(filepath),
+			std::vector<int>{ subimage },
+			compression_codec,
+			compression_level,
+			block_size,
+			chunk_size
+		);
+		return std::move(images.front());
+	}
+
+#endif // COMPRESSED_IMAGE_OIIO_AVAILABLE
+
+} // NAMESPACE_COMPRESSED_IMAGE
@@ -204,7 +204,10 @@ start_y = chunk_index * channel.chunk_size() // channel.width()
 
 from there you can compute the full extents of the chunk.
 
-This overload allows you to reuse a buffer rather than having to keep setting up a new one, to use it you should so 
+This overload decompresses straight into the passed array without any intermediate allocation or copy,
+releasing the GIL while blosc2 does its work so other python threads may continue running.
+
+It allows you to reuse a buffer rather than having to keep setting up a new one, to use it you should do
 something along the lines of the below code example. A channels chunks are guaranteed to be the same size for all chunks
 except the last one, so we can reuse the same buffer again.
 
@@ -232,9 +235,29 @@ Replace a chunk's contents with a new array. This array must match the size `cha
 :param chunk_index: Index of the chunk to update. Must be less than self.num_chunks
 :param array: 1D numpy array to set onto the chunk.
             )doc")
-                    .def("get_decompressed", &compressed_py::dynamic_channel::get_decompressed,
+                    .def("get_decompressed",
+                        py::overload_cast<>(&compressed_py::dynamic_channel::get_decompressed, py::const_),
                         R"doc(
+The GIL is released while the data is decompressed so other python threads may continue running.
+
 :return: The full decompressed data as a 2D numpy array.
+            )doc")
+                    .def("get_decompressed",
+                        py::overload_cast<py::array&>(&compressed_py::dynamic_channel::get_decompressed, py::const_),
+                        py::arg("array"),
+                        R"doc(
+Get the full decompressed data into a caller-provided, preallocated numpy array without any
+intermediate allocation or copy. The GIL is released while the data is decompressed so other
+python threads may continue running, making this the preferred overload for multi-threaded
+dataloaders.
+
+.. code-block:: python
+
+    buffer = np.ndarray((channel.height, channel.width), dtype=channel.dtype)
+    channel.get_decompressed(buffer)
+
+:param array: A C-contiguous 1D numpy array of size width * height or 2D numpy array of shape
+    (height, width) with a dtype matching the channel.
             )doc")
                     .def("update_nthreads", &compressed_py::dynamic_channel::update_nthreads,
                         py::arg("nthreads"), py::arg("block_size") = compressed::s_default_blocksize,
@@ -280,10 +280,20 @@ namespace compressed_py
 						throw std::invalid_argument("Array length does not match number of chunk elements.");
 					}
 
+					// Validate contiguity, we decompress straight into the buffer so the elements
+					// must be laid out the way blosc2 writes them.
+					if (array.strides(0) != static_cast<py::ssize_t>(sizeof(T)))
+					{
+						throw std::invalid_argument("Array must be C-contiguous.");
+					}
+
 					// Get a mutable span and fill it
 					auto buf = static_cast<T*>(array.mutable_data());
 					std::span<T> buffer(buf, ch_ptr->chunk_elems(chunk_idx));
 
+					// The decompression itself does not touch any python state so other python
+					// threads may continue running while blosc2 does its work.
+					py::gil_scoped_release release;
 					ch_ptr->get_chunk(buffer, chunk_idx);
 
 				}, base_variant_class::m_ClassVariant);
@@ -297,7 +307,12 @@ namespace compressed_py
 				{
 					using T = typename std::decay_t<decltype(*ch_ptr)>::value_type;
 					compressed::util::default_init_vector<T> buffer(this->chunk_elems(chunk_idx));
-					ch_ptr->get_chunk(std::span<T>(buffer), chunk_idx);
+					{
+						// Release the GIL while blosc2 decompresses, the buffer is local so no
+						// python state is touched until the numpy array is created below.
+						py::gil_scoped_release release;
+						ch_ptr->get_chunk(std::span<T>(buffer), chunk_idx);
+					}
 
 					// Use the size, ptr overload of array_t. Since array_t is an extension of py::array we can
 					// implicitly cast back down.
@@ -338,13 +353,82 @@ namespace compressed_py
 		{
 			return std::visit([](auto&& ch_ptr) -> py::array
 				{
-					auto decompressed = ch_ptr->get_decompressed();
+					using T = typename std::decay_t<decltype(*ch_ptr)>::value_type;
+					std::vector<T> decompressed;
+					{
+						// Release the GIL while blosc2 decompresses, the buffer is local so no
+						// python state is touched until the numpy array is created below.
+						py::gil_scoped_release release;
+						decompressed = ch_ptr->get_decompressed();
+					}
 
 					// This will handle converting it into a 2d numpy array.
 					return py_img_util::to_py_array(std::move(decompressed), ch_ptr->width(), ch_ptr->height());
 				}, base_variant_class::m_ClassVariant);
 		}
 
+		/// Fill the passed array with the full decompressed data, avoiding the allocation of the
+		/// other overload. The array may be 1D of size width * height or 2D of shape (height, width).
+		void get_decompressed(py::array& array) const
+		{
+			std::visit([&](auto&& ch_ptr) -> void
+				{
+					using T = typename std::decay_t<decltype(*ch_ptr)>::value_type;
+
+					// Validate dtype
+					if (!py::isinstance<py::array_t<T>>(array))
+					{
+						throw std::invalid_argument("Array must have dtype matching channel element type.");
+					}
+
+					// Validate dimensions, a flat buffer of the full size or a (height, width)
+					// shaped image are both accepted.
+					const auto num_elements = static_cast<py::ssize_t>(ch_ptr->uncompressed_size());
+					if (array.ndim() == 1)
+					{
+						if (array.shape(0) != num_elements)
+						{
+							throw std::invalid_argument("Array length does not match width * height.");
+						}
+					}
+					else if (array.ndim() == 2)
+					{
+						if (array.shape(0) != static_cast<py::ssize_t>(ch_ptr->height()) ||
+							array.shape(1) != static_cast<py::ssize_t>(ch_ptr->width()))
+						{
+							throw std::invalid_argument("Array shape does not match (height, width).");
+						}
+					}
+					else
+					{
+						throw std::invalid_argument("Array must be 1- or 2-dimensional.");
+					}
+
+					// Validate contiguity, we decompress straight into the buffer so the elements
+					// must be laid out the way blosc2 writes them.
+					if (array.strides(array.ndim() - 1) != static_cast<py::ssize_t>(sizeof(T)) ||
+						(array.ndim() == 2 && array.strides(0) != static_cast<py::ssize_t>(sizeof(T) * ch_ptr->width())))
+					{
+						throw std::invalid_argument("Array must be C-contiguous.");
+					}
+
+					auto buf = static_cast<T*>(array.mutable_data());
+					std::span<T> buffer(buf, static_cast<size_t>(num_elements));
+
+					// Decompress chunk by chunk straight into the caller's buffer with the GIL
+					// released, the chunks partition the data in order so each one maps to a
+					// contiguous subspan.
+					py::gil_scoped_release release;
+					size_t offset = 0;
+					for (size_t chunk_idx = 0; chunk_idx < ch_ptr->num_chunks(); ++chunk_idx)
+					{
+						const auto chunk_elems = ch_ptr->chunk_elems(chunk_idx);
+						ch_ptr->get_chunk(buffer.subspan(offset, chunk_elems), chunk_idx);
+						offset += chunk_elems;
+					}
+				}, base_variant_class::m_ClassVariant);
+		}
+
 		void update_nthreads(size_t nthreads, size_t block_size = compressed::s_default_blocksize)
 		{
 			std::visit([=](auto&& ch_ptr)
@@ -235,4 +235,31 @@ class TestCompressedChannelParametrized:
         for i in range(channel.num_chunks()):
             chunk = channel.get_chunk(i)
 
-            assert np.all(chunk == i)
\ No newline at end of file
+            assert np.all(chunk == i)
+
+    def test_get_decompressed_into_buffer(self, width: int, height: int, dtype: npt.DTypeLike):
+        arr = np.arange(width * height, dtype=np.uint64).astype(dtype).reshape((height, width))
+        channel = compressed.Channel(
+            arr,
+            width,
+            height,
+        )
+
+        # 2D (height, width) buffer
+        buffer_2d = np.ndarray((height, width), dtype)
+        channel.get_decompressed(buffer_2d)
+        assert np.array_equal(buffer_2d, channel.get_decompressed())
+
+        # Flat buffer of width * height elements
+        buffer_1d = np.ndarray((width * height,), dtype)
+        channel.get_decompressed(buffer_1d)
+        assert np.array_equal(buffer_1d.reshape((height, width)), buffer_2d)
+
+        # Mismatched shapes and dtypes are rejected
+        with pytest.raises(ValueError):
+            channel.get_decompressed(np.ndarray((height, width + 1), dtype))
+        with pytest.raises(ValueError):
+            channel.get_decompressed(np.ndarray((width * height + 1,), dtype))
+        # Non-contiguous views cannot be decompressed into directly
+        with pytest.raises(ValueError):
+            channel.get_decompressed(np.ndarray((height, width * 2), dtype)[:, ::2])
@@ -0,0 +1,93 @@
+#include "doctest.h"
+
+#include <algorithm>
+#include <span>
+#include <vector>
+#include <numeric>
+
+#include <compressed/autotune.h>
+#include <compressed/channel.h>
+
+#include "util.h"
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Autotune picks a candidate parametrized")
+{
+	test_util::parametrize<uint8_t, uint16_t, uint32_t, float>([&]<typename T>([[maybe_unused]] T type)
+		{
+			// Highly compressible ramp data, every candidate should comfortably beat the ratio target.
+			std::vector<T> data(65536);
+			std::iota(data.begin(), data.end(), T{ 0 });
+
+			auto candidates = compressed::default_tuning_candidates();
+			auto result = compressed::autotune<T>(
+				std::span<const T>(data),
+				std::span<const compressed::tuning_candidate>(candidates),
+				1.0,
+				4,
+				16384
+			);
+
+			CHECK(result.met_ratio_target);
+			CHECK(result.ratio > 1.0);
+			CHECK(result.compression_throughput > 0.0);
+			CHECK(result.decompression_throughput > 0.0);
+
+			// The chosen configuration has to be one of the candidates.
+			auto matches = std::any_of(candidates.begin(), candidates.end(), [&](const auto& candidate)
+				{
+					return candidate.codec == result.codec
+						&& candidate.compression_level == result.compression_level
+						&& candidate.block_size == result.block_size;
+				});
+			CHECK(matches);
+
+			// And it is directly usable as a parameter source for channel construction.
+			auto channel = compressed::channel<T>(
+				std::span<const T>(data),
+				256,
+				256,
+				result.codec,
+				result.compression_level,
+				result.block_size
+			);
+			CHECK(channel.get_decompressed() == data);
+		});
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Autotune unreachable ratio target")
+{
+	// Incompressible-ish noise with an absurd ratio target, the best-ratio candidate is
+	// returned but flagged as having missed the target.
+	std::vector<uint8_t> data(16384);
+	uint32_t state = 0x12345678;
+	for (auto& value : data)
+	{
+		state = state * 1664525 + 1013904223;
+		value = static_cast<uint8_t>(state >> 24);
+	}
+
+	auto result = compressed::autotune<uint8_t>(std::span<const uint8_t>(data), 1000.0);
+	CHECK(!result.met_ratio_target);
+	CHECK(result.ratio > 0.0);
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Autotune empty candidates"
+	* doctest::no_breaks(true)
+	* doctest::no_output(true)
+	* doctest::should_fail(true))
+{
+	std::vector<uint8_t> data(128);
+	auto result = compressed::autotune<uint8_t>(
+		std::span<const uint8_t>(data),
+		std::span<const compressed::tuning_candidate>{}
+	);
+}
@@ -1,9 +1,15 @@
 #include "doctest.h"
 
+#include <execution>
 #include <ranges>
+#include <thread>
 #include <span>
 #include <vector>
 #include <algorithm>
+#include <coroutine>
+#include <latch>
+#include <mutex>
+#include <numeric>
 #include <string>
 
 #include <OpenImageIO/half.h>
@@ -87,6 +93,103 @@ TEST_CASE("Channel get attributes"
 }
 
 
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Channel chunk cache roundtrip")
+{
+	auto vec = std::vector<uint8_t>(8192);
+	std::iota(vec.begin(), vec.end(), 0);
+	auto channel = compressed::channel<uint8_t>(std::span<uint8_t>(vec), 128, 64, compressed::enums::codec::lz4, 9, 128, 4096);
+
+	channel.cache_budget(1024 * 1024);
+	CHECK(channel.cache_budget() == 1024 * 1024);
+
+	auto buffer = std::vector<uint8_t>(channel.chunk_elems());
+	channel.get_chunk(std::span<uint8_t>(buffer), 0);
+	auto first = buffer;
+
+	// Second access is served from the cache and must match the decompressed data.
+	channel.get_chunk(std::span<uint8_t>(buffer), 0);
+	CHECK(buffer == first);
+
+	// Overwriting the chunk invalidates the cached entry.
+	auto replacement = std::vector<uint8_t>(channel.chunk_elems(), 42);
+	channel.set_chunk(std::span<uint8_t>(replacement), 0);
+	channel.get_chunk(std::span<uint8_t>(buffer), 0);
+	CHECK(buffer == replacement);
+
+	// Disabling the cache keeps the channel fully functional.
+	channel.cache_budget(0);
+	CHECK(channel.cache_budget() == 0);
+	channel.get_chunk(std::span<uint8_t>(buffer), 0);
+	CHECK(buffer == replacement);
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Channel buffer pool recycling")
+{
+	auto vec = std::vector<uint8_t>(8192);
+	std::iota(vec.begin(), vec.end(), 0);
+	auto channel = compressed::channel<uint8_t>(std::span<uint8_t>(vec), 128, 64, compressed::enums::codec::lz4, 9, 128, 4096);
+
+	auto pool = std::make_shared<compressed::detail::byte_buffer_pool>(8);
+	channel.buffer_pool(pool);
+	CHECK(channel.buffer_pool() == pool);
+
+	// Rewriting chunks cycles the replaced buffers through the pool.
+	auto replacement = std::vector<uint8_t>(channel.chunk_elems(), 42);
+	channel.set_chunk(std::span<uint8_t>(replacement), 0);
+	channel.set_chunk(std::span<uint8_t>(replacement), 1);
+	CHECK(pool->num_pooled() > 0);
+
+	auto roundtripped = channel.get_decompressed();
+	test_util::check_vector_verbose(roundtripped, static_cast<uint8_t>(42));
+
+	// Detaching the pool keeps the channel fully functional.
+	channel.buffer_pool(nullptr);
+	CHECK(channel.buffer_pool() == nullptr);
+	channel.set_chunk(std::span<uint8_t>(replacement), 0);
+	test_util::check_vector_verbose(channel.get_decompressed(), static_cast<uint8_t>(42));
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Channel for_each_chunk")
+{
+	auto vec = std::vector<uint8_t>(8192, 255);
+	auto channel = compressed::channel<uint8_t>(std::span<uint8_t>(vec), 128, 64, compressed::enums::codec::lz4, 9, 128, 4096);
+
+	SUBCASE("Modify")
+	{
+		channel.for_each_chunk(std::execution::par, [](compressed::container::chunk_span<uint8_t> chunk)
+			{
+				for (auto& pixel : chunk)
+				{
+					pixel = 128;
+				}
+			});
+
+		auto roundtripped = channel.get_decompressed();
+		test_util::check_vector_verbose(roundtripped, static_cast<uint8_t>(128));
+	}
+
+	SUBCASE("Read const")
+	{
+		const auto& const_channel = channel;
+		const_channel.for_each_chunk([](compressed::container::chunk_span<const uint8_t> chunk)
+			{
+				for (const auto& pixel : chunk)
+				{
+					CHECK(pixel == 255);
+				}
+			});
+	}
+}
+
+
 // -----------------------------------------------------------------------------------
 // -----------------------------------------------------------------------------------
 TEST_CASE("Channel iterate")
@@ -123,4 +226,1027 @@ TEST_CASE("Channel iterate")
 			}
 		}
 	}
-}
\ No newline at end of file
+}
+
+
+TEST_CASE("Channel get_roi")
+{
+	test_util::parametrize<uint8_t, uint16_t, uint32_t, float>([&]<typename T>([[maybe_unused]] T type)
+		{
+			constexpr size_t width = 64;
+			constexpr size_t height = 64;
+
+			auto vec = std::vector<T>(width * height);
+			std::iota(vec.begin(), vec.end(), 0);
+
+			// Small chunks so the requested strips cross chunk boundaries.
+			auto channel = compressed::channel<T>(
+				std::span<const T>(vec),
+				width,
+				height,
+				compressed::enums::codec::lz4,
+				9,
+				256,
+				1024
+			);
+			CHECK(channel.num_chunks() > 1);
+
+			SUBCASE("Strip within a single chunk")
+			{
+				auto buffer = std::vector<T>(2 * width);
+				channel.get_roi(1, 3, std::span<T>(buffer));
+				for (auto idx : std::views::iota(size_t{ 0 }, buffer.size()))
+				{
+					CHECK(buffer[idx] == vec[width + idx]);
+				}
+			}
+			SUBCASE("Strip crossing chunk boundaries")
+			{
+				constexpr size_t y_begin = 10;
+				constexpr size_t y_end = 50;
+				auto buffer = std::vector<T>((y_end - y_begin) * width);
+				channel.get_roi(y_begin, y_end, std::span<T>(buffer));
+				for (auto idx : std::views::iota(size_t{ 0 }, buffer.size()))
+				{
+					CHECK(buffer[idx] == vec[y_begin * width + idx]);
+				}
+			}
+			SUBCASE("Full height matches get_decompressed")
+			{
+				auto buffer = std::vector<T>(width * height);
+				channel.get_roi(0, height, std::span<T>(buffer));
+				CHECK(buffer == channel.get_decompressed());
+			}
+		});
+}
+
+
+TEST_CASE("Channel get_roi out of range"
+	* doctest::no_breaks(true)
+	* doctest::no_output(true)
+	* doctest::should_fail(true))
+{
+	auto vec = std::vector<uint8_t>(64 * 64);
+	auto channel = compressed::channel<uint8_t>(std::span<const uint8_t>(vec), 64, 64);
+
+	auto buffer = std::vector<uint8_t>(64);
+	channel.get_roi(63, 65, std::span<uint8_t>(buffer));
+}
+
+
+
+TEST_CASE("Channel statistics")
+{
+	test_util::parametrize<uint8_t, uint16_t, uint32_t, float>([&]<typename T>([[maybe_unused]] T type)
+		{
+			constexpr size_t width = 64;
+			constexpr size_t height = 64;
+
+			// First half 10, second half 20 so min/max/mean and the histogram split are known exactly.
+			auto vec = std::vector<T>(width * height, static_cast<T>(10));
+			std::fill(vec.begin() + vec.size() / 2, vec.end(), static_cast<T>(20));
+
+			auto channel = compressed::channel<T>(
+				std::span<const T>(vec),
+				width,
+				height,
+				compressed::enums::codec::lz4,
+				9,
+				256,
+				1024
+			);
+			CHECK(channel.num_chunks() > 1);
+
+			SUBCASE("Streaming reduction")
+			{
+				auto stats = channel.statistics();
+				CHECK(stats.minimum == static_cast<T>(10));
+				CHECK(stats.maximum == static_cast<T>(20));
+				CHECK(stats.mean == doctest::Approx(15.0));
+				CHECK(stats.histogram.empty());
+			}
+			SUBCASE("Histogram")
+			{
+				auto stats = channel.statistics(2);
+				CHECK(stats.histogram.size() == 2);
+				CHECK(stats.histogram[0] == vec.size() / 2);
+				CHECK(stats.histogram[1] == vec.size() / 2);
+			}
+			SUBCASE("Recorded per-chunk statistics")
+			{
+				// Enabling tracking and rewriting every chunk records min/max/sum at compression
+				// time, after which the query combines those without decoding.
+				channel.track_chunk_statistics(true);
+				CHECK(channel.track_chunk_statistics());
+
+				for (auto chunk_idx : std::views::iota(size_t{ 0 }, channel.num_chunks()))
+				{
+					auto buffer = std::vector<T>(channel.chunk_elems(chunk_idx));
+					channel.get_chunk(std::span<T>(buffer), chunk_idx);
+					channel.set_chunk(std::span<T>(buffer), chunk_idx);
+				}
+
+				auto stats = channel.statistics();
+				CHECK(stats.minimum == static_cast<T>(10));
+				CHECK(stats.maximum == static_cast<T>(20));
+				CHECK(stats.mean == doctest::Approx(15.0));
+			}
+		});
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+TEST_CASE("Channel clone")
+{
+	test_util::parametrize<uint8_t, uint16_t, uint32_t, float>([&]<typename T>([[maybe_unused]] T type)
+		{
+			constexpr size_t width = 64;
+			constexpr size_t height = 64;
+
+			auto vec = std::vector<T>(width * height);
+			std::iota(vec.begin(), vec.end(), static_cast<T>(0));
+
+			auto channel = compressed::channel<T>(
+				std::span<const T>(vec),
+				width,
+				height,
+				compressed::enums::codec::lz4,
+				9,
+				256,
+				1024
+			);
+			CHECK(channel.num_chunks() > 1);
+
+			auto cloned = channel.clone();
+			CHECK(cloned.width() == channel.width());
+			CHECK(cloned.height() == channel.height());
+			CHECK(cloned.num_chunks() == channel.num_chunks());
+			test_util::check_vector_verbose(cloned.get_decompressed(), channel.get_decompressed());
+
+			// Mutating the clone must leave the original untouched.
+			auto overwrite = std::vector<T>(cloned.chunk_elems(0), static_cast<T>(1));
+			cloned.set_chunk(std::span<T>(overwrite), 0);
+			test_util::check_vector_verbose(channel.get_decompressed(), vec);
+			CHECK(cloned.get_decompressed()[0] == static_cast<T>(1));
+		});
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+TEST_CASE("Channel tiled layout")
+{
+	test_util::parametrize<uint8_t, uint16_t, uint32_t, float>([&]<typename T>([[maybe_unused]] T type)
+		{
+			constexpr size_t width = 64;
+			constexpr size_t height = 64;
+			constexpr size_t tile_width = 32;
+			constexpr size_t tile_height = 32;
+
+			auto vec = std::vector<T>(width * height);
+			std::iota(vec.begin(), vec.end(), static_cast<T>(0));
+
+			auto channel = compressed::channel<T>::tiled(
+				std::span<const T>(vec),
+				width,
+				height,
+				tile_width,
+				tile_height,
+				compressed::enums::codec::lz4,
+				9,
+				256
+			);
+
+			CHECK(channel.is_tiled());
+			CHECK(channel.tile_width() == tile_width);
+			CHECK(channel.tile_height() == tile_height);
+			CHECK(channel.num_tiles_x() == width / tile_width);
+			CHECK(channel.num_tiles_y() == height / tile_height);
+			CHECK(channel.num_chunks() == (width / tile_width) * (height / tile_height));
+
+			SUBCASE("Decompression restores scanline order")
+			{
+				test_util::check_vector_verbose(channel.get_decompressed(), vec);
+			}
+			SUBCASE("Tile access")
+			{
+				auto tile = std::vector<T>(tile_width * tile_height);
+				channel.get_tile(1, 1, std::span<T>(tile));
+
+				auto expected = std::vector<T>(tile_width * tile_height);
+				for (auto row : std::views::iota(size_t{ 0 }, tile_height))
+				{
+					for (auto col : std::views::iota(size_t{ 0 }, tile_width))
+					{
+						expected[row * tile_width + col] = vec[(tile_height + row) * width + tile_width + col];
+					}
+				}
+				test_util::check_vector_verbose(tile, expected);
+			}
+			SUBCASE("Rectangular ROI straddling tile boundaries")
+			{
+				constexpr size_t x_begin = 10;
+				constexpr size_t x_end = 50;
+				constexpr size_t y_begin = 5;
+				constexpr size_t y_end = 40;
+
+				auto roi = std::vector<T>((x_end - x_begin) * (y_end - y_begin));
+				channel.get_roi(x_begin, x_end, y_begin, y_end, std::span<T>(roi));
+
+				auto expected = std::vector<T>(roi.size());
+				for (auto y : std::views::iota(y_begin, y_end))
+				{
+					for (auto x : std::views::iota(x_begin, x_end))
+					{
+						expected[(y - y_begin) * (x_end - x_begin) + (x - x_begin)] = vec[y * width + x];
+					}
+				}
+				test_util::check_vector_verbose(roi, expected);
+			}
+			SUBCASE("Iteration yields tile coordinates")
+			{
+				size_t chunk_idx = 0;
+				for (auto chunk : channel)
+				{
+					CHECK(chunk.tiled());
+					CHECK(chunk.tile_x() == chunk_idx % (width / tile_width));
+					CHECK(chunk.tile_y() == chunk_idx / (width / tile_width));
+					CHECK(chunk.x(0) == chunk.tile_x() * tile_width);
+					CHECK(chunk.y(0) == chunk.tile_y() * tile_height);
+					++chunk_idx;
+				}
+				CHECK(chunk_idx == channel.num_chunks());
+			}
+			SUBCASE("Rectangular ROI matches on the scanline-strip layout")
+			{
+				// The 2D overload also works on regular channels via per-row partial decompression.
+				auto strip_channel = compressed::channel<T>(
+					std::span<const T>(vec),
+					width,
+					height,
+					compressed::enums::codec::lz4,
+					9,
+					256,
+					1024
+				);
+				CHECK(!strip_channel.is_tiled());
+
+				auto roi = std::vector<T>(16 * 16);
+				strip_channel.get_roi(size_t{ 8 }, size_t{ 24 }, size_t{ 8 }, size_t{ 24 }, std::span<T>(roi));
+
+				auto expected = std::vector<T>(roi.size());
+				for (auto y : std::views::iota(size_t{ 8 }, size_t{ 24 }))
+				{
+					for (auto x : std::views::iota(size_t{ 8 }, size_t{ 24 }))
+					{
+						expected[(y - 8) * 16 + (x - 8)] = vec[y * width + x];
+					}
+				}
+				test_util::check_vector_verbose(roi, expected);
+			}
+		});
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+TEST_CASE("Channel tiled layout invalid usage"
+	* doctest::no_breaks(true)
+	* doctest::no_output(true)
+	* doctest::should_fail(true))
+{
+	constexpr size_t width = 64;
+	constexpr size_t height = 64;
+	auto vec = std::vector<uint8_t>(width * height, 1);
+
+	SUBCASE("Tile dimensions do not divide the channel dimensions")
+	{
+		auto channel = compressed::channel<uint8_t>::tiled(std::span<const uint8_t>(vec), width, height, 48, 32);
+	}
+	SUBCASE("Scanline ROI on a tiled channel")
+	{
+		auto channel = compressed::channel<uint8_t>::tiled(
+			std::span<const uint8_t>(vec), width, height, 32, 32, compressed::enums::codec::lz4, 9, 256
+		);
+		auto buffer = std::vector<uint8_t>(width * 4);
+		channel.get_roi(size_t{ 0 }, size_t{ 4 }, std::span<uint8_t>(buffer));
+	}
+	SUBCASE("Tile access on a scanline-strip channel")
+	{
+		auto channel = compressed::channel<uint8_t>(std::span<const uint8_t>(vec), width, height);
+		auto buffer = std::vector<uint8_t>(32 * 32);
+		channel.get_tile(0, 0, std::span<uint8_t>(buffer));
+	}
+	SUBCASE("Tile coordinates out of range")
+	{
+		auto channel = compressed::channel<uint8_t>::tiled(
+			std::span<const uint8_t>(vec), width, height, 32, 32, compressed::enums::codec::lz4, 9, 256
+		);
+		auto buffer = std::vector<uint8_t>(32 * 32);
+		channel.get_tile(2, 0, std::span<uint8_t>(buffer));
+	}
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+TEST_CASE("Channel half-float shuffle filter")
+{
+	constexpr size_t width = 64;
+	constexpr size_t height = 64;
+
+	// Half-float bit patterns: sign 0, constant exponent (values in [1, 2)) and a varying mantissa,
+	// stored as uint16_t since the bit layout is all the filter ever sees.
+	auto vec = std::vector<uint16_t>(width * height);
+	for (auto idx : std::views::iota(size_t{ 0 }, vec.size()))
+	{
+		vec[idx] = static_cast<uint16_t>(0x3c00u | (idx % 1024));
+	}
+
+	auto channel = compressed::channel<uint16_t>(
+		std::span<const uint16_t>(vec),
+		width,
+		height,
+		compressed::enums::codec::lz4,
+		9,
+		256,
+		1024,
+		compressed::enums::filter::half_shuffle
+	);
+	CHECK(channel.compression_filter() == compressed::enums::filter::half_shuffle);
+
+	// The filter must be exactly invertible, including through the per-chunk recompression paths.
+	test_util::check_vector_verbose(channel.get_decompressed(), vec);
+
+	auto buffer = std::vector<uint16_t>(channel.chunk_elems(0));
+	channel.get_chunk(std::span<uint16_t>(buffer), 0);
+	channel.set_chunk(std::span<uint16_t>(buffer), 0);
+	test_util::check_vector_verbose(channel.get_decompressed(), vec);
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+TEST_CASE("Channel half-float shuffle filter on non-2-byte type"
+	* doctest::no_breaks(true)
+	* doctest::no_output(true)
+	* doctest::should_fail(true))
+{
+	constexpr size_t width = 16;
+	constexpr size_t height = 16;
+	auto vec = std::vector<float>(width * height, 1.0f);
+
+	auto channel = compressed::channel<float>(
+		std::span<const float>(vec),
+		width,
+		height,
+		compressed::enums::codec::lz4,
+		9,
+		256,
+		1024,
+		compressed::enums::filter::half_shuffle
+	);
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+TEST_CASE("Channel concurrent set_chunk")
+{
+	test_util::parametrize<uint8_t, uint16_t, uint32_t, float>([&]<typename T>([[maybe_unused]] T type)
+		{
+			constexpr size_t width = 64;
+			constexpr size_t height = 64;
+
+			auto channel = compressed::channel<T>::zeros(
+				width,
+				height,
+				compressed::enums::codec::lz4,
+				9,
+				256,
+				1024
+			);
+			CHECK(channel.num_chunks() > 1);
+
+			// Simulate render workers committing buckets: one thread per chunk, all writing
+			// their own chunk of the same channel concurrently.
+			auto expected = std::vector<T>(width * height);
+			std::iota(expected.begin(), expected.end(), static_cast<T>(0));
+
+			auto threads = std::vector<std::thread>();
+			size_t element_offset = 0;
+			for (auto chunk_idx : std::views::iota(size_t{ 0 }, channel.num_chunks()))
+			{
+				const size_t chunk_elems = channel.chunk_elems(chunk_idx);
+				threads.emplace_back([&channel, &expected, chunk_idx, element_offset, chunk_elems]()
+					{
+						auto buffer = std::vector<T>(
+							expected.begin() + element_offset,
+							expected.begin() + element_offset + chunk_elems
+						);
+						channel.set_chunk(std::span<T>(buffer), chunk_idx);
+					});
+				element_offset += chunk_elems;
+			}
+			for (auto& thread : threads)
+			{
+				thread.join();
+			}
+
+			test_util::check_vector_verbose(channel.get_decompressed(), expected);
+		});
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Channel get_decompressed into caller buffer")
+{
+	test_util::parametrize<uint8_t, uint16_t, uint32_t, float>([&]<typename T>([[maybe_unused]] T type)
+		{
+			constexpr size_t width = 64;
+			constexpr size_t height = 64;
+			std::vector<T> data(width * height);
+			std::iota(data.begin(), data.end(), static_cast<T>(0));
+
+			SUBCASE("scanline layout across multiple chunks")
+			{
+				auto channel = compressed::channel<T>(
+					std::span<const T>(data),
+					width,
+					height,
+					compressed::enums::codec::lz4,
+					9,
+					size_t{ 256 },
+					size_t{ 1024 }
+				);
+
+				std::vector<T> buffer(width * height);
+				channel.get_decompressed(std::span<T>(buffer));
+				test_util::check_vector_verbose(buffer, channel.get_decompressed());
+			}
+
+			SUBCASE("tiled layout scatters back to scanline order")
+			{
+				auto channel = compressed::channel<T>::tiled(
+					std::span<const T>(data),
+					width,
+					height,
+					32,
+					32,
+					compressed::enums::codec::lz4,
+					9,
+					size_t{ 256 }
+				);
+
+				std::vector<T> buffer(width * height);
+				channel.get_decompressed(std::span<T>(buffer));
+				test_util::check_vector_verbose(buffer, data);
+			}
+		});
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Channel get_decompressed buffer too small"
+	* doctest::no_breaks(true)
+	* doctest::no_output(true)
+	* doctest::should_fail(true))
+{
+	std::vector<uint8_t> data(64 * 64);
+	auto channel = compressed::channel<uint8_t>(std::span<const uint8_t>(data), 64, 64);
+
+	std::vector<uint8_t> buffer(64);
+	channel.get_decompressed(std::span<uint8_t>(buffer));
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Channel compression statistics")
+{
+	SUBCASE("materialized channel")
+	{
+		constexpr size_t width = 64;
+		constexpr size_t height = 64;
+		std::vector<uint16_t> data(width * height);
+		std::iota(data.begin(), data.end(), static_cast<uint16_t>(0));
+
+		auto channel = compressed::channel<uint16_t>(
+			std::span<const uint16_t>(data),
+			width,
+			height,
+			compressed::enums::codec::zstd,
+			9,
+			size_t{ 256 },
+			size_t{ 2048 }
+		);
+
+		auto stats = channel.compression_statistics();
+		CHECK(stats["width"] == width);
+		CHECK(stats["height"] == height);
+		CHECK(stats["layout"] == "scanline");
+		CHECK(stats["storage"] == "schunk");
+		CHECK(stats["codec"] == "zstd");
+		CHECK(stats["compression_level"] == 9);
+		CHECK(stats["filter"] == "shuffle");
+		CHECK(stats["num_chunks"] == channel.num_chunks());
+		CHECK(stats["num_lazy_chunks"] == 0);
+		CHECK(stats["compressed_bytes"] == channel.compressed_bytes());
+		CHECK(stats["uncompressed_bytes"] == width * height * sizeof(uint16_t));
+		CHECK(stats["compression_ratio"].get<double>() > 0.0);
+
+		CHECK(stats["chunks"].size() == channel.num_chunks());
+		size_t uncompressed_sum = 0;
+		for (const auto& chunk : stats["chunks"])
+		{
+			CHECK(chunk["lazy"] == false);
+			CHECK(chunk["compressed_bytes"].get<size_t>() > 0);
+			uncompressed_sum += chunk["uncompressed_bytes"].get<size_t>();
+		}
+		CHECK(uncompressed_sum == width * height * sizeof(uint16_t));
+	}
+
+	SUBCASE("lazy channel reports unmaterialized chunks")
+	{
+		auto channel = compressed::channel<uint8_t>::zeros(1024, 1024);
+
+		auto stats = channel.compression_statistics();
+		CHECK(stats["storage"] == "lazy_schunk");
+		CHECK(stats["num_lazy_chunks"] == channel.num_chunks());
+		for (const auto& chunk : stats["chunks"])
+		{
+			CHECK(chunk["lazy"] == true);
+			CHECK(chunk["compressed_bytes"] == sizeof(uint8_t));
+		}
+
+		// Materializing a chunk flips its lazy state in the report.
+		std::vector<uint8_t> chunk_data(channel.chunk_elems(0), uint8_t{ 25 });
+		channel.set_chunk(std::span<uint8_t>(chunk_data), 0);
+
+		stats = channel.compression_statistics();
+		CHECK(stats["num_lazy_chunks"] == channel.num_chunks() - 1);
+		CHECK(stats["chunks"][0]["lazy"] == false);
+		CHECK(stats["chunks"][0]["compressed_bytes"].get<size_t>() > sizeof(uint8_t));
+	}
+}
+
+
+// ----------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------
+TEST_CASE("Channel flip vertical")
+{
+	test_util::parametrize<uint8_t, uint16_t, uint32_t, float>([&]<typename T>([[maybe_unused]] T type)
+		{
+			constexpr size_t width = 64;
+			constexpr size_t height = 32;
+			std::vector<T> data(width * height);
+			std::iota(data.begin(), data.end(), static_cast<T>(0));
+
+			std::vector<T> flipped(width * height);
+			for (size_t y = 0; y < height; ++y)
+			{
+				std::copy(
+					data.begin() + y * width,
+					data.begin() + (y + 1) * width,
+					flipped.begin() + (height - 1 - y) * width
+				);
+			}
+
+			SUBCASE("One scanline per chunk")
+			{
+				// The flip is pure chunk reordering, the compressed size must not change at all.
+				auto channel = compressed::channel<T>(
+					std::span<const T>(data), width, height,
+					compressed::enums::codec::lz4, 9, 32, width * sizeof(T)
+				);
+				const auto csize_before = channel.compressed_bytes();
+
+				channel.flip_vertical();
+				CHECK(channel.compressed_bytes() == csize_before);
+				test_util::check_vector_verbose(channel.get_decompressed(), flipped);
+			}
+			SUBCASE("Multiple scanlines per chunk")
+			{
+				// Four rows per chunk, the height divides evenly so mirrored chunk pairs swap.
+				auto channel = compressed::channel<T>(
+					std::span<const T>(data), width, height,
+					compressed::enums::codec::lz4, 9, 128, width * 4 * sizeof(T)
+				);
+				channel.flip_vertical();
+				test_util::check_vector_verbose(channel.get_decompressed(), flipped);
+
+				// Flipping twice restores the original.
+				channel.flip_vertical();
+				test_util::check_vector_verbose(channel.get_decompressed(), data);
+			}
+			SUBCASE("Partial last chunk")
+			{
+				constexpr size_t odd_height = 30;
+				std::vector<T> odd_data(data.begin(), data.begin() + width * odd_height);
+				std::vector<T> odd_flipped(width * odd_height);
+				for (size_t y = 0; y < odd_height; ++y)
+				{
+					std::copy(
+						odd_data.begin() + y * width,
+						odd_data.begin() + (y + 1) * width,
+						odd_flipped.begin() + (odd_height - 1 - y) * width
+					);
+				}
+
+				auto channel = compressed::channel<T>(
+					std::span<const T>(odd_data), width, odd_height,
+					compressed::enums::codec::lz4, 9, 128, width * 4 * sizeof(T)
+				);
+				channel.flip_vertical();
+				test_util::check_vector_verbose(channel.get_decompressed(), odd_flipped);
+			}
+			SUBCASE("Tiled layout")
+			{
+				auto channel = compressed::channel<T>::tiled(
+					std::span<const T>(data), width, height, 16, 16,
+					compressed::enums::codec::lz4, 9, 128
+				);
+				channel.flip_vertical();
+				CHECK(channel.is_tiled());
+				test_util::check_vector_verbose(channel.get_decompressed(), flipped);
+			}
+		});
+}
+
+
+// ----------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------
+TEST_CASE("Channel crop y")
+{
+	test_util::parametrize<uint8_t, uint16_t, uint32_t, float>([&]<typename T>([[maybe_unused]] T type)
+		{
+			constexpr size_t width = 64;
+			constexpr size_t height = 32;
+			std::vector<T> data(width * height);
+			std::iota(data.begin(), data.end(), static_cast<T>(0));
+
+			auto reference = [&](size_t y_begin, size_t y_end)
+				{
+					return std::vector<T>(data.begin() + y_begin * width, data.begin() + y_end * width);
+				};
+
+			SUBCASE("Chunk aligned range")
+			{
+				// Four rows per chunk and both bounds on chunk boundaries: the crop is pure
+				// chunk dropping in the compressed domain.
+				auto channel = compressed::channel<T>(
+					std::span<const T>(data), width, height,
+					compressed::enums::codec::lz4, 9, 128, width * 4 * sizeof(T)
+				);
+				channel.crop_y(8, 24);
+				CHECK(channel.height() == 16);
+				CHECK(channel.width() == width);
+				test_util::check_vector_verbose(channel.get_decompressed(), reference(8, 24));
+			}
+			SUBCASE("Boundary chunk re-encode")
+			{
+				// The bottom bound cuts into a chunk, only that chunk gets re-encoded.
+				auto channel = compressed::channel<T>(
+					std::span<const T>(data), width, height,
+					compressed::enums::codec::lz4, 9, 128, width * 4 * sizeof(T)
+				);
+				channel.crop_y(8, 22);
+				CHECK(channel.height() == 14);
+				test_util::check_vector_verbose(channel.get_decompressed(), reference(8, 22));
+			}
+			SUBCASE("Unaligned begin falls back to rebuild")
+			{
+				auto channel = compressed::channel<T>(
+					std::span<const T>(data), width, height,
+					compressed::enums::codec::lz4, 9, 128, width * 4 * sizeof(T)
+				);
+				channel.crop_y(3, 27);
+				CHECK(channel.height() == 24);
+				test_util::check_vector_verbose(channel.get_decompressed(), reference(3, 27));
+			}
+			SUBCASE("Tiled channel")
+			{
+				auto channel = compressed::channel<T>::tiled(
+					std::span<const T>(data), width, height, 16, 16,
+					compressed::enums::codec::lz4, 9, 128
+				);
+				// The cropped height no longer divides the tile grid, the channel is rebuilt
+				// with the scanline-strip layout.
+				channel.crop_y(5, 21);
+				CHECK(channel.height() == 16);
+				CHECK_FALSE(channel.is_tiled());
+				test_util::check_vector_verbose(channel.get_decompressed(), reference(5, 21));
+			}
+		});
+}
+
+
+// ----------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------
+TEST_CASE("Channel crop y invalid range"
+	* doctest::no_breaks(true)
+	* doctest::no_output(true)
+	* doctest::should_fail(true))
+{
+	std::vector<uint8_t> data(64 * 32, 0);
+	auto channel = compressed::channel<uint8_t>(
+		std::span<const uint8_t>(data), 64, 32,
+		compressed::enums::codec::lz4, 9, 128, 1024
+	);
+	channel.crop_y(16, 8);
+}
+
+
+// ----------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------
+TEST_CASE("Channel copy-on-write share")
+{
+	constexpr size_t width = 64;
+	constexpr size_t height = 32;
+	std::vector<uint8_t> data(width * height);
+	std::iota(data.begin(), data.end(), static_cast<uint8_t>(0));
+
+	auto channel = compressed::channel<uint8_t>(
+		std::span<const uint8_t>(data), width, height,
+		compressed::enums::codec::lz4, 9, 128, width * 4
+	);
+
+	SUBCASE("Sharing is O(1) and both sides read the same data")
+	{
+		auto view = channel.share();
+		CHECK(channel.shares_storage());
+		CHECK(view.shares_storage());
+		CHECK(view.compressed_bytes() == channel.compressed_bytes());
+		test_util::check_vector_verbose(view.get_decompressed(), data);
+	}
+	SUBCASE("Writing through the view detaches it")
+	{
+		auto view = channel.share();
+
+		std::vector<uint8_t> replacement(view.chunk_elems(0), 42);
+		view.set_chunk(std::span<uint8_t>(replacement), 0);
+
+		CHECK_FALSE(channel.shares_storage());
+		CHECK_FALSE(view.shares_storage());
+
+		// The view sees its write, the original keeps the snapshot.
+		auto view_data = view.get_decompressed();
+		test_util::check_vector_verbose(
+			std::vector<uint8_t>(view_data.begin(), view_data.begin() + replacement.size()),
+			replacement
+		);
+		test_util::check_vector_verbose(channel.get_decompressed(), data);
+	}
+	SUBCASE("Mutating the original leaves the view untouched")
+	{
+		auto view = channel.share();
+		channel.flip_vertical();
+		test_util::check_vector_verbose(view.get_decompressed(), data);
+	}
+	SUBCASE("A view of a view shares the same storage")
+	{
+		auto view = channel.share();
+		auto view_2 = view.share();
+		CHECK(view_2.shares_storage());
+		test_util::check_vector_verbose(view_2.get_decompressed(), data);
+	}
+}
+
+
+// ----------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------
+TEST_CASE("Channel contiguous frame storage")
+{
+	constexpr size_t width = 64;
+	constexpr size_t height = 32;
+	std::vector<uint8_t> data(width * height);
+	std::iota(data.begin(), data.end(), static_cast<uint8_t>(0));
+
+	auto channel = compressed::channel<uint8_t>(
+		std::span<const uint8_t>(data), width, height,
+		compressed::enums::codec::lz4, 9, 128, width * 4
+	);
+
+	CHECK(channel.make_contiguous());
+	CHECK(channel.contiguous_payload().size() == channel.compressed_bytes());
+	test_util::check_vector_verbose(channel.get_decompressed(), data);
+
+	// Chunk writes keep working on frame-backed storage.
+	std::vector<uint8_t> replacement(channel.chunk_elems(1), 7);
+	channel.set_chunk(std::span<uint8_t>(replacement), 1);
+	auto roundtrip = channel.get_decompressed();
+	test_util::check_vector_verbose(
+		std::vector<uint8_t>(
+			roundtrip.begin() + channel.chunk_elems(),
+			roundtrip.begin() + channel.chunk_elems() + replacement.size()
+		),
+		replacement
+	);
+}
+
+
+// ----------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------
+TEST_CASE("Channel contiguous payload requires frame storage"
+	* doctest::no_breaks(true)
+	* doctest::no_output(true)
+	* doctest::should_fail(true))
+{
+	std::vector<uint8_t> data(64 * 32, 0);
+	auto channel = compressed::channel<uint8_t>(
+		std::span<const uint8_t>(data), 64, 32,
+		compressed::enums::codec::lz4, 9, 128, 1024
+	);
+	auto payload = channel.contiguous_payload();
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Channel lazy transform queue")
+{
+	constexpr size_t width = 256;
+	constexpr size_t height = 64;
+	std::vector<float> data(width * height);
+	std::iota(data.begin(), data.end(), 0.0f);
+
+	// Small chunks so the channel holds several of them and the queue demonstrably runs per chunk.
+	auto channel = compressed::channel<float>(
+		std::span<const float>(data), width, height,
+		compressed::enums::codec::lz4, 9, compressed::s_default_blocksize, width * 16 * sizeof(float)
+	);
+
+	std::vector<float> expected(data.size());
+	for (size_t idx = 0; idx < data.size(); ++idx)
+	{
+		expected[idx] = data[idx] * 2.0f + 1.0f;
+	}
+
+	SUBCASE("Chained maps fuse into every decode path")
+	{
+		channel.map([](std::span<float> chunk) { for (auto& px : chunk) { px *= 2.0f; } });
+		channel.map([](std::span<float> chunk) { for (auto& px : chunk) { px += 1.0f; } });
+		CHECK(channel.num_pending_transforms() == 2);
+
+		auto decompressed = channel.get_decompressed();
+		test_util::check_vector_verbose(decompressed, expected);
+
+		std::vector<float> chunk_buffer(channel.chunk_elems(0));
+		channel.get_chunk(std::span<float>(chunk_buffer), 0);
+		test_util::check_vector_verbose(
+			chunk_buffer,
+			std::vector<float>(expected.begin(), expected.begin() + chunk_buffer.size())
+		);
+
+		std::vector<float> roi(width * 4);
+		channel.get_roi(size_t{ 8 }, size_t{ 12 }, std::span<float>(roi));
+		test_util::check_vector_verbose(
+			roi,
+			std::vector<float>(expected.begin() + 8 * width, expected.begin() + 12 * width)
+		);
+
+		// Reads never materialize the queue, the compressed storage is untouched.
+		CHECK(channel.num_pending_transforms() == 2);
+	}
+
+	SUBCASE("Baking materializes the queue exactly once")
+	{
+		channel.map([](std::span<float> chunk) { for (auto& px : chunk) { px *= 2.0f; } });
+		channel.map([](std::span<float> chunk) { for (auto& px : chunk) { px += 1.0f; } });
+
+		channel.bake_transforms();
+		CHECK(channel.num_pending_transforms() == 0);
+
+		// The transforms live in the storage now, decoding must not re-apply them.
+		auto decompressed = channel.get_decompressed();
+		test_util::check_vector_verbose(decompressed, expected);
+	}
+
+	SUBCASE("Mutations bake the queue implicitly")
+	{
+		channel.map([](std::span<float> chunk) { for (auto& px : chunk) { px *= 2.0f; } });
+		channel.map([](std::span<float> chunk) { for (auto& px : chunk) { px += 1.0f; } });
+
+		// set_chunk applies to data written after the maps were recorded, so the queue is baked
+		// first and the freshly written chunk stays untransformed.
+		std::vector<float> replacement(channel.chunk_elems(0), 42.0f);
+		channel.set_chunk(std::span<float>(replacement), 0);
+		CHECK(channel.num_pending_transforms() == 0);
+
+		auto decompressed = channel.get_decompressed();
+		auto patched = expected;
+		std::fill(patched.begin(), patched.begin() + replacement.size(), 42.0f);
+		test_util::check_vector_verbose(decompressed, patched);
+	}
+
+	SUBCASE("Views and clones carry the queue along")
+	{
+		channel.map([](std::span<float> chunk) { for (auto& px : chunk) { px *= 2.0f; } });
+		channel.map([](std::span<float> chunk) { for (auto& px : chunk) { px += 1.0f; } });
+
+		auto view = channel.share();
+		auto copy = channel.clone();
+		CHECK(view.num_pending_transforms() == 2);
+		CHECK(copy.num_pending_transforms() == 2);
+
+		test_util::check_vector_verbose(view.get_decompressed(), expected);
+		test_util::check_vector_verbose(copy.get_decompressed(), expected);
+	}
+}
+
+
+namespace
+{
+	// Minimal fire-and-forget coroutine for driving `get_chunk_async` in tests, real consumers
+	// bring their own task type / executor.
+	struct fire_and_forget
+	{
+		struct promise_type
+		{
+			fire_and_forget get_return_object() { return {}; }
+			std::suspend_never initial_suspend() noexcept { return {}; }
+			std::suspend_never final_suspend() noexcept { return {}; }
+			void return_void() {}
+			void unhandled_exception() { std::terminate(); }
+		};
+	};
+
+	fire_and_forget decode_chunk_async(
+		const compressed::channel<float>& channel,
+		std::span<float> buffer,
+		size_t chunk_idx,
+		std::vector<size_t>& decoded_indices,
+		std::mutex& mutex,
+		std::latch& latch
+	)
+	{
+		auto chunk = co_await channel.get_chunk_async(buffer, chunk_idx);
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			decoded_indices.push_back(chunk.chunk_index());
+		}
+		latch.count_down();
+	}
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Channel async chunk decode")
+{
+	constexpr size_t width = 256;
+	constexpr size_t height = 64;
+	std::vector<float> data(width * height);
+	std::iota(data.begin(), data.end(), 0.0f);
+
+	auto channel = compressed::channel<float>(
+		std::span<const float>(data), width, height,
+		compressed::enums::codec::lz4, 9, compressed::s_default_blocksize, width * 16 * sizeof(float)
+	);
+	const size_t num_chunks = channel.num_chunks();
+
+	// Kick off every decode at once, each await suspends the coroutine instead of blocking a
+	// caller thread. Collect results under a mutex and verify after the latch, doctest
+	// assertions are not thread-safe.
+	std::vector<std::vector<float>> buffers(num_chunks);
+	std::vector<size_t> decoded_indices;
+	std::mutex mutex;
+	std::latch latch(static_cast<std::ptrdiff_t>(num_chunks));
+	for (size_t chunk_idx = 0; chunk_idx < num_chunks; ++chunk_idx)
+	{
+		buffers[chunk_idx].resize(channel.chunk_elems(chunk_idx));
+		decode_chunk_async(channel, std::span<float>(buffers[chunk_idx]), chunk_idx, decoded_indices, mutex, latch);
+	}
+	latch.wait();
+
+	CHECK(decoded_indices.size() == num_chunks);
+	size_t offset = 0;
+	for (size_t chunk_idx = 0; chunk_idx < num_chunks; ++chunk_idx)
+	{
+		auto expected = std::vector<float>(data.begin() + offset, data.begin() + offset + buffers[chunk_idx].size());
+		test_util::check_vector_verbose(buffers[chunk_idx], expected);
+		offset += buffers[chunk_idx].size();
+	}
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Channel async chunk decode with undersized buffer"
+	* doctest::no_breaks(true)
+	* doctest::no_output(true)
+	* doctest::should_fail(true))
+{
+	constexpr size_t width = 256;
+	constexpr size_t height = 64;
+	std::vector<float> data(width * height, 1.0f);
+
+	auto channel = compressed::channel<float>(std::span<const float>(data), width, height);
+
+	// Parameter errors surface eagerly from the call itself, not from inside the await.
+	std::vector<float> buffer(channel.chunk_elems(0) / 2);
+	auto awaitable = channel.get_chunk_async(std::span<float>(buffer), 0);
+}
@@ -0,0 +1,100 @@
+#include "doctest.h"
+
+#include <algorithm>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <vector>
+
+#include <compressed/channel.h>
+#include <compressed/channel_builder.h>
+
+#include "util.h"
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+TEST_CASE("Channel builder matches single-pass construction")
+{
+	test_util::parametrize<uint8_t, uint16_t, uint32_t, float>([&]<typename T>([[maybe_unused]] T type)
+		{
+			constexpr size_t width = 64;
+			constexpr size_t height = 64;
+
+			auto vec = std::vector<T>(width * height);
+			std::iota(vec.begin(), vec.end(), static_cast<T>(0));
+
+			auto reference = compressed::channel<T>(
+				std::span<const T>(vec),
+				width,
+				height,
+				compressed::enums::codec::lz4,
+				9,
+				256,
+				1024
+			);
+
+			SUBCASE("Scanline by scanline")
+			{
+				auto builder = compressed::channel_builder<T>(width, height, compressed::enums::codec::lz4, 9, 256, 1024);
+				for (auto y : std::views::iota(size_t{ 0 }, height))
+				{
+					builder.push_scanline(std::span<const T>(vec.data() + y * width, width));
+					CHECK(builder.scanlines_pushed() == y + 1);
+				}
+				CHECK(builder.complete());
+
+				auto channel = std::move(builder).finalize();
+				CHECK(channel.num_chunks() == reference.num_chunks());
+				test_util::check_vector_verbose(channel.get_decompressed(), reference.get_decompressed());
+			}
+			SUBCASE("Uneven scanline batches")
+			{
+				// Batches that straddle the chunk boundary exercise the accumulator split logic.
+				auto builder = compressed::channel_builder<T>(width, height, compressed::enums::codec::lz4, 9, 256, 1024);
+				size_t y = 0;
+				size_t batch = 3;
+				while (y < height)
+				{
+					const size_t num_scanlines = std::min(batch, height - y);
+					builder.push_scanlines(std::span<const T>(vec.data() + y * width, num_scanlines * width));
+					y += num_scanlines;
+					batch = batch % 7 + 1;
+				}
+				CHECK(builder.complete());
+
+				auto channel = std::move(builder).finalize();
+				test_util::check_vector_verbose(channel.get_decompressed(), reference.get_decompressed());
+			}
+		});
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+TEST_CASE("Channel builder invalid usage"
+	* doctest::no_breaks(true)
+	* doctest::no_output(true)
+	* doctest::should_fail(true))
+{
+	constexpr size_t width = 16;
+	constexpr size_t height = 4;
+	auto vec = std::vector<uint8_t>(width * height, 1);
+
+	auto builder = compressed::channel_builder<uint8_t>(width, height);
+
+	SUBCASE("Partial scanline")
+	{
+		builder.push_scanlines(std::span<const uint8_t>(vec.data(), width - 1));
+	}
+	SUBCASE("Too many scanlines")
+	{
+		builder.push_scanlines(std::span<const uint8_t>(vec));
+		builder.push_scanline(std::span<const uint8_t>(vec.data(), width));
+	}
+	SUBCASE("Finalize incomplete")
+	{
+		builder.push_scanline(std::span<const uint8_t>(vec.data(), width));
+		auto channel = std::move(builder).finalize();
+	}
+}
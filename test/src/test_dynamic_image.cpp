@@ -0,0 +1,138 @@
+#include "doctest.h"
+
+#include <filesystem>
+#include <numeric>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <compressed/dynamic_image.h>
+
+#include "util.h"
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Dynamic image mixed precision channels")
+{
+	constexpr size_t width = 64;
+	constexpr size_t height = 32;
+
+	std::vector<uint8_t> mask(width * height);
+	std::iota(mask.begin(), mask.end(), uint8_t{ 0 });
+	std::vector<float> depth(width * height);
+	std::iota(depth.begin(), depth.end(), 0.0f);
+
+	compressed::dynamic_image image(width, height);
+	image.add_channel(compressed::channel<uint8_t>(std::span<const uint8_t>(mask), width, height), "mask");
+	image.add_channel(compressed::channel<float>(std::span<const float>(depth), width, height), "depth");
+
+	SUBCASE("Channels keep their native element size side by side")
+	{
+		CHECK(image.num_channels() == 2);
+		CHECK(image.channel_element_size(0) == sizeof(uint8_t));
+		CHECK(image.channel_element_size(1) == sizeof(float));
+		CHECK(image.channelnames() == std::vector<std::string>{ "mask", "depth" });
+	}
+
+	SUBCASE("Typed access roundtrips the data")
+	{
+		auto decompressed_mask = image.channel_as<uint8_t>("mask").get_decompressed();
+		test_util::check_vector_verbose(decompressed_mask, mask);
+
+		auto decompressed_depth = image.channel_as<float>(1).get_decompressed();
+		test_util::check_vector_verbose(decompressed_depth, depth);
+	}
+
+	SUBCASE("Visiting the variant reaches the type-independent channel interface")
+	{
+		for (auto& channel : image.channels())
+		{
+			std::visit([&](auto& typed)
+			{
+				CHECK(typed.width() == width);
+				CHECK(typed.height() == height);
+			}, channel);
+		}
+	}
+
+	SUBCASE("Removing a channel keeps names and indices in sync")
+	{
+		image.remove_channel("mask");
+		CHECK(image.num_channels() == 1);
+		CHECK(image.channelnames() == std::vector<std::string>{ "depth" });
+		CHECK(image.channel_element_size(0) == sizeof(float));
+	}
+
+	CHECK(image.compression_ratio() > 0.0);
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Dynamic image typed access with mismatched type"
+	* doctest::no_breaks(true)
+	* doctest::no_output(true)
+	* doctest::should_fail(true))
+{
+	constexpr size_t width = 16;
+	constexpr size_t height = 16;
+	std::vector<float> data(width * height, 1.0f);
+
+	compressed::dynamic_image image(width, height);
+	image.add_channel(compressed::channel<float>(std::span<const float>(data), width, height), "depth");
+
+	// The channel is stored as float, requesting it as uint8_t has to throw.
+	auto& channel = image.channel_as<uint8_t>("depth");
+	(void)channel;
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Dynamic image from typed image")
+{
+	constexpr size_t width = 32;
+	constexpr size_t height = 32;
+
+	std::vector<uint16_t> red(width * height, uint16_t{ 1 });
+	std::vector<uint16_t> green(width * height, uint16_t{ 2 });
+	std::vector<std::span<const uint16_t>> channels{ std::span<const uint16_t>(red), std::span<const uint16_t>(green) };
+
+	auto typed = compressed::image<uint16_t>(channels, width, height, { "R", "G" });
+	auto dynamic = compressed::dynamic_image(std::move(typed));
+
+	CHECK(dynamic.width() == width);
+	CHECK(dynamic.height() == height);
+	CHECK(dynamic.num_channels() == 2);
+	CHECK(dynamic.channel_element_size(0) == sizeof(uint16_t));
+
+	auto decompressed = dynamic.channel_as<uint16_t>("G").get_decompressed();
+	test_util::check_vector_verbose(decompressed, green);
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Dynamic image read at native precision")
+{
+	auto base_path = std::filesystem::current_path() / "images" / "uv_grid_2048x2048.jpg";
+	auto image = compressed::dynamic_image::read(base_path);
+
+	// A jpg stores all of its channels as uint8, each slot of the dynamic image has to
+	// reflect that rather than a promoted precision.
+	CHECK(image.num_channels() == 3);
+	CHECK(image.width() == 2048);
+	CHECK(image.height() == 2048);
+	for (size_t idx = 0; idx < image.num_channels(); ++idx)
+	{
+		CHECK(image.channel_element_size(idx) == sizeof(uint8_t));
+	}
+
+	auto expected = test_util::read_oiio<uint8_t>(base_path);
+	for (size_t idx = 0; idx < image.num_channels(); ++idx)
+	{
+		auto decompressed = image.channel_as<uint8_t>(idx).get_decompressed();
+		test_util::check_vector_verbose(decompressed, expected[idx]);
+	}
+}
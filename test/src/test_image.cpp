@@ -3,10 +3,14 @@
 #include <ranges>
 #include <string>
 #include <cstdint>
+#include <numeric>
+#include <fstream>
 
 #include <OpenImageIO/half.h>
 
 #include <compressed/image.h>
+#include <compressed/read_batch.h>
+#include <compressed/read_parallel.h>
 #include <compressed/ranges.h>
 #include <compressed/util.h>
 #include <compressed/blosc2/wrapper.h>
@@ -856,4 +860,819 @@ TEST_CASE("Zip modify image channels larger to chunk size parametrized")
 			}
 		}
 	);
-}
\ No newline at end of file
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Save and load roundtrip parametrized")
+{
+	test_util::parametrize<uint8_t, uint16_t, uint32_t, float>([&]<typename T>([[maybe_unused]] T type)
+		{
+			auto channel_r_data = std::vector<T>(1024, static_cast<T>(255));
+			auto channel_g_data = std::vector<T>(1024, static_cast<T>(0));
+			auto channel_b_data = std::vector<T>(1024, static_cast<T>(199));
+
+			auto image = compressed::image<T>(
+				std::vector<std::vector<T>>{ channel_r_data, channel_g_data, channel_b_data },
+				64,
+				16,
+				{ "R", "G", "B" },
+				compressed::enums::codec::lz4,
+				9,
+				256,
+				768
+			);
+			image.metadata()["author"] = "roundtrip";
+			image.metadata()["frame"] = 25;
+
+			auto path = std::filesystem::temp_directory_path() / "compressed_image_roundtrip.cimg";
+			image.save(path);
+			auto loaded = compressed::image<T>::load(path);
+
+			CHECK(loaded.width() == image.width());
+			CHECK(loaded.height() == image.height());
+			CHECK(loaded.num_channels() == image.num_channels());
+			CHECK(loaded.channelnames() == image.channelnames());
+			CHECK(loaded.metadata() == image.metadata());
+			CHECK(loaded.channel(0).compression() == compressed::enums::codec::lz4);
+			CHECK(loaded.channel(0).compression_level() == 9);
+
+			test_util::compare_images(loaded.get_decompressed(), image.get_decompressed(), "roundtrip");
+			std::filesystem::remove(path);
+		});
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Save and load roundtrip lazy channel")
+{
+	auto channels = std::vector<compressed::channel<uint8_t>>{};
+	channels.push_back(compressed::channel<uint8_t>::full(64, 16, static_cast<uint8_t>(128)));
+
+	auto image = compressed::image<uint8_t>(std::move(channels), 64, 16, { "R" });
+
+	auto path = std::filesystem::temp_directory_path() / "compressed_image_roundtrip_lazy.cimg";
+	image.save(path);
+	auto loaded = compressed::image<uint8_t>::load(path);
+
+	CHECK(loaded.width() == 64);
+	CHECK(loaded.height() == 16);
+	CHECK(loaded.num_channels() == 1);
+	test_util::check_vector_verbose(loaded.channel(0).get_decompressed(), static_cast<uint8_t>(128));
+	std::filesystem::remove(path);
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE(
+	"Load non-native file"
+	* doctest::no_breaks(true)
+	* doctest::no_output(true)
+	* doctest::should_fail(true)
+)
+{
+	std::string name = "uv_grid_2048x2048.jpg";
+	auto path = std::filesystem::current_path() / "images" / name;
+
+	// this should fail as the file is not in the native serialization format
+	auto image = compressed::image<uint8_t>::load(path);
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Get and set chunk planes parametrized")
+{
+	test_util::parametrize<uint8_t, uint16_t, uint32_t, float>([&]<typename T>([[maybe_unused]] T type)
+		{
+			constexpr size_t width = 64;
+			constexpr size_t height = 16;
+
+			auto channel_r = std::vector<T>(width * height, static_cast<T>(10));
+			auto channel_g = std::vector<T>(width * height, static_cast<T>(20));
+			auto channel_b = std::vector<T>(width * height, static_cast<T>(30));
+
+			auto image = compressed::image<T>(
+				std::vector<std::vector<T>>{ channel_r, channel_g, channel_b },
+				width,
+				height,
+				{ "R", "G", "B" },
+				compressed::enums::codec::lz4,
+				9,
+				256,
+				768
+			);
+			auto num_chunks = image.channel(0).num_chunks();
+			CHECK(num_chunks > 1);
+
+			SUBCASE("Get planes of all channels")
+			{
+				for (auto chunk_idx : std::views::iota(size_t{ 0 }, num_chunks))
+				{
+					auto planes = image.get_chunk_planes(chunk_idx);
+					CHECK(planes.size() == 3);
+					test_util::check_vector_verbose(planes[0], static_cast<T>(10));
+					test_util::check_vector_verbose(planes[1], static_cast<T>(20));
+					test_util::check_vector_verbose(planes[2], static_cast<T>(30));
+				}
+			}
+			SUBCASE("Get planes into caller buffers")
+			{
+				auto buffer_r = std::vector<T>(image.channel(0).chunk_elems(0));
+				auto buffer_g = std::vector<T>(image.channel(1).chunk_elems(0));
+				auto buffer_b = std::vector<T>(image.channel(2).chunk_elems(0));
+				auto buffers = std::vector<std::span<T>>{ std::span<T>(buffer_r), std::span<T>(buffer_g), std::span<T>(buffer_b) };
+
+				image.get_chunk_planes(std::span<std::span<T>>(buffers), 0);
+				test_util::check_vector_verbose(buffer_r, static_cast<T>(10));
+				test_util::check_vector_verbose(buffer_g, static_cast<T>(20));
+				test_util::check_vector_verbose(buffer_b, static_cast<T>(30));
+			}
+			SUBCASE("Set planes of all channels")
+			{
+				for (auto chunk_idx : std::views::iota(size_t{ 0 }, num_chunks))
+				{
+					auto planes = image.get_chunk_planes(chunk_idx);
+					for (auto& plane : planes)
+					{
+						for (auto& value : plane)
+						{
+							value = static_cast<T>(value + 1);
+						}
+					}
+
+					auto buffers = std::vector<std::span<T>>{};
+					for (auto& plane : planes)
+					{
+						buffers.push_back(std::span<T>(plane));
+					}
+					image.set_chunk_planes(std::span<std::span<T>>(buffers), chunk_idx);
+				}
+
+				test_util::check_vector_verbose(image.channel(0).get_decompressed(), static_cast<T>(11));
+				test_util::check_vector_verbose(image.channel(1).get_decompressed(), static_cast<T>(21));
+				test_util::check_vector_verbose(image.channel(2).get_decompressed(), static_cast<T>(31));
+			}
+		});
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Get chunk planes invalid index"
+	* doctest::no_breaks(true)
+	* doctest::no_output(true)
+	* doctest::should_fail(true))
+{
+	auto data = std::vector<uint8_t>(64 * 16);
+	auto image = compressed::image<uint8_t>(
+		std::vector<std::vector<uint8_t>>{ data },
+		64,
+		16
+	);
+
+	auto planes = image.get_chunk_planes(image.channel(0).num_chunks());
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Write image roundtrip")
+{
+	std::string name = "uv_grid_2048x2048.jpg";
+	auto path = std::filesystem::current_path() / "images" / name;
+	auto image = compressed::image<uint8_t>::read(
+		path,
+		0,
+		compressed::enums::codec::lz4,
+		9,
+		4096,
+		16384
+	);
+
+	// Write out to a lossless format and read it back in, the pixels have to survive unchanged.
+	auto out_path = std::filesystem::temp_directory_path() / "compressed_image_write_roundtrip.tif";
+	image.write(out_path);
+	CHECK(std::filesystem::exists(out_path));
+
+	auto roundtripped = compressed::image<uint8_t>::read(out_path);
+	CHECK(roundtripped.width() == image.width());
+	CHECK(roundtripped.height() == image.height());
+	CHECK(roundtripped.num_channels() == image.num_channels());
+	test_util::compare_images(image.get_decompressed(), roundtripped.get_decompressed(), "write_roundtrip");
+
+	std::filesystem::remove(out_path);
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Image get_roi matches decompressed slice")
+{
+	constexpr size_t width = 64;
+	constexpr size_t height = 32;
+
+	auto channel_r = std::vector<uint8_t>(width * height);
+	auto channel_g = std::vector<uint8_t>(width * height);
+	std::iota(channel_r.begin(), channel_r.end(), 0);
+	std::iota(channel_g.begin(), channel_g.end(), 128);
+
+	auto image = compressed::image<uint8_t>(
+		std::vector<std::vector<uint8_t>>{ channel_r, channel_g },
+		width,
+		height,
+		{ "R", "G" },
+		compressed::enums::codec::lz4,
+		9,
+		256,
+		1024
+	);
+
+	constexpr size_t y_begin = 5;
+	constexpr size_t y_end = 21;
+	auto planes = image.get_roi(y_begin, y_end);
+	CHECK(planes.size() == 2);
+
+	auto full = image.get_decompressed();
+	for (auto channel_idx : std::views::iota(size_t{ 0 }, planes.size()))
+	{
+		CHECK(planes[channel_idx].size() == (y_end - y_begin) * width);
+		for (auto idx : std::views::iota(size_t{ 0 }, planes[channel_idx].size()))
+		{
+			CHECK(planes[channel_idx][idx] == full[channel_idx][y_begin * width + idx]);
+		}
+	}
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Read batch matches serial reads")
+{
+	std::vector<std::filesystem::path> paths = {
+		std::filesystem::current_path() / "images" / "uv_grid_2048x2048.jpg",
+		std::filesystem::current_path() / "images" / "multilayer_1920x1080.exr",
+		std::filesystem::current_path() / "images" / "uv_grid_2048x2048.jpg",
+	};
+
+	auto images = compressed::read_batch<uint8_t>(paths);
+	CHECK(images.size() == paths.size());
+
+	for (auto idx : std::views::iota(size_t{ 0 }, paths.size()))
+	{
+		auto reference = compressed::image<uint8_t>::read(paths[idx]);
+		CHECK(images[idx].width() == reference.width());
+		CHECK(images[idx].height() == reference.height());
+		CHECK(images[idx].num_channels() == reference.num_channels());
+
+		auto batch_data = images[idx].get_decompressed();
+		auto reference_data = reference.get_decompressed();
+		for (auto channel_idx : std::views::iota(size_t{ 0 }, batch_data.size()))
+		{
+			test_util::check_vector_verbose(batch_data[channel_idx], reference_data[channel_idx]);
+		}
+	}
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Read batch budget too small for a single pipeline"
+	* doctest::no_breaks(true)
+	* doctest::no_output(true)
+	* doctest::should_fail(true))
+{
+	std::vector<std::filesystem::path> paths = {
+		std::filesystem::current_path() / "images" / "uv_grid_2048x2048.jpg",
+	};
+	auto images = compressed::read_batch<uint8_t>(paths, size_t{ 1024 });
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Read parallel matches serial read")
+{
+	std::string name = "multilayer_1920x1080.exr";
+	auto path = std::filesystem::current_path() / "images" / name;
+
+	auto parallel = compressed::read_parallel<uint8_t>(path);
+	auto reference = compressed::image<uint8_t>::read(path);
+
+	CHECK(parallel.width() == reference.width());
+	CHECK(parallel.height() == reference.height());
+	CHECK(parallel.num_channels() == reference.num_channels());
+	CHECK(parallel.channelnames() == reference.channelnames());
+	CHECK(parallel.metadata() == reference.metadata());
+
+	auto parallel_data = parallel.get_decompressed();
+	auto reference_data = reference.get_decompressed();
+	for (auto channel_idx : std::views::iota(size_t{ 0 }, parallel_data.size()))
+	{
+		test_util::check_vector_verbose(parallel_data[channel_idx], reference_data[channel_idx]);
+	}
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Read parallel single range falls back to serial pipeline")
+{
+	std::string name = "uv_grid_2048x2048.jpg";
+	auto path = std::filesystem::current_path() / "images" / name;
+
+	auto parallel = compressed::read_parallel<uint8_t>(path);
+	auto reference = compressed::image<uint8_t>::read(path);
+
+	CHECK(parallel.channelnames() == reference.channelnames());
+
+	auto parallel_data = parallel.get_decompressed();
+	auto reference_data = reference.get_decompressed();
+	for (auto channel_idx : std::views::iota(size_t{ 0 }, parallel_data.size()))
+	{
+		test_util::check_vector_verbose(parallel_data[channel_idx], reference_data[channel_idx]);
+	}
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Read parallel with affinity groups enabled")
+{
+	std::string name = "multilayer_1920x1080.exr";
+	auto path = std::filesystem::current_path() / "images" / name;
+
+	// Pinning is a pure placement hint, with groups enabled the results have to be
+	// bit-identical to the unpinned read. On machines with fewer CPUs than groups the
+	// pinning silently degrades to a no-op which this exercises just as well.
+	auto previous = compressed::affinity_groups();
+	compressed::affinity_groups(2);
+
+	auto parallel = compressed::read_parallel<uint8_t>(path);
+	auto reference = compressed::image<uint8_t>::read(path);
+
+	compressed::affinity_groups(previous);
+	CHECK(compressed::affinity_groups() == previous);
+
+	CHECK(parallel.channelnames() == reference.channelnames());
+	auto parallel_data = parallel.get_decompressed();
+	auto reference_data = reference.get_decompressed();
+	for (auto channel_idx : std::views::iota(size_t{ 0 }, parallel_data.size()))
+	{
+		test_util::check_vector_verbose(parallel_data[channel_idx], reference_data[channel_idx]);
+	}
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Read parallel multipart file across subimages")
+{
+	std::string name = "multipart.0001.exr";
+	auto path = std::filesystem::current_path() / "images" / name;
+
+	std::vector<int> subimages = { 0, 1, 2 };
+	auto images = compressed::read_parallel<uint8_t>(path, subimages);
+	CHECK(images.size() == subimages.size());
+
+	for (auto idx : std::views::iota(size_t{ 0 }, subimages.size()))
+	{
+		auto reference = compressed::image<uint8_t>::read(path, subimages[idx]);
+		CHECK(images[idx].width() == reference.width());
+		CHECK(images[idx].height() == reference.height());
+		CHECK(images[idx].channelnames() == reference.channelnames());
+
+		auto image_data = images[idx].get_decompressed();
+		auto image_ref = test_util::read_oiio<uint8_t>(path, subimages[idx]);
+		test_util::compare_images(image_data, image_ref, name);
+	}
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Read parallel invalid subimage"
+	* doctest::no_breaks(true)
+	* doctest::no_output(true)
+	* doctest::should_fail(true))
+{
+	std::string name = "uv_grid_2048x2048.jpg";
+	auto path = std::filesystem::current_path() / "images" / name;
+
+	auto image = compressed::read_parallel<uint8_t>(path, 9999);
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Image mip pyramid")
+{
+	test_util::parametrize<uint8_t, uint16_t, uint32_t, float>([&]<typename T>([[maybe_unused]] T type)
+		{
+			constexpr size_t width = 64;
+			constexpr size_t height = 48;
+
+			// Reference box filter mirroring the pyramid generation: floor-halved dimensions
+			// with the 2x2 lookups clamped at the edges.
+			auto downsample_ref = [](const std::vector<T>& data, size_t w, size_t h)
+				{
+					const size_t ow = w / 2 > 0 ? w / 2 : 1;
+					const size_t oh = h / 2 > 0 ? h / 2 : 1;
+					std::vector<T> out(ow * oh);
+					for (auto y : std::views::iota(size_t{ 0 }, oh))
+					{
+						const size_t y0 = y * 2;
+						const size_t y1 = y0 + 1 < h ? y0 + 1 : h - 1;
+						for (auto x : std::views::iota(size_t{ 0 }, ow))
+						{
+							const size_t x0 = x * 2;
+							const size_t x1 = x0 + 1 < w ? x0 + 1 : w - 1;
+							if constexpr (std::is_integral_v<T>)
+							{
+								const int64_t sum = static_cast<int64_t>(data[y0 * w + x0]) + data[y0 * w + x1]
+									+ data[y1 * w + x0] + data[y1 * w + x1];
+								out[y * ow + x] = static_cast<T>((sum + 2) / 4);
+							}
+							else
+							{
+								out[y * ow + x] = static_cast<T>(
+									(data[y0 * w + x0] + data[y0 * w + x1] + data[y1 * w + x0] + data[y1 * w + x1])
+									/ static_cast<T>(4));
+							}
+						}
+					}
+					return out;
+				};
+
+			std::vector<std::vector<T>> channels;
+			for (auto channel_idx : std::views::iota(size_t{ 0 }, size_t{ 3 }))
+			{
+				std::vector<T> data(width * height);
+				for (auto y : std::views::iota(size_t{ 0 }, height))
+				{
+					for (auto x : std::views::iota(size_t{ 0 }, width))
+					{
+						data[y * width + x] = static_cast<T>(x + y * 2 + channel_idx);
+					}
+				}
+				channels.push_back(std::move(data));
+			}
+			auto reference = channels;
+
+			auto image = compressed::image<T>(channels, width, height);
+			CHECK(image.num_mip_levels() == 0);
+
+			image.generate_mips();
+			// 64x48 -> 32x24 -> 16x12 -> 8x6 -> 4x3 -> 2x1 -> 1x1
+			CHECK(image.num_mip_levels() == 6);
+
+			// Request a deeper level first, the levels above it have to be filled in on the way.
+			CHECK(image.mip_level(1).size() == 3);
+
+			size_t level_width = width;
+			size_t level_height = height;
+			for (auto level : std::views::iota(size_t{ 0 }, image.num_mip_levels()))
+			{
+				const auto& level_channels = image.mip_level(level);
+				CHECK(level_channels.size() == 3);
+
+				level_width = level_width / 2 > 0 ? level_width / 2 : 1;
+				level_height = level_height / 2 > 0 ? level_height / 2 : 1;
+				for (auto channel_idx : std::views::iota(size_t{ 0 }, level_channels.size()))
+				{
+					reference[channel_idx] = downsample_ref(
+						reference[channel_idx],
+						level_width * 2 > width ? width : level_width * 2,
+						level_height * 2 > height ? height : level_height * 2
+					);
+					CHECK(level_channels[channel_idx].width() == level_width);
+					CHECK(level_channels[channel_idx].height() == level_height);
+					test_util::check_vector_verbose(
+						level_channels[channel_idx].get_decompressed(),
+						reference[channel_idx]
+					);
+				}
+			}
+		});
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Image mip pyramid over tiled channels")
+{
+	constexpr size_t width = 64;
+	constexpr size_t height = 48;
+
+	std::vector<uint8_t> data(width * height);
+	for (auto y : std::views::iota(size_t{ 0 }, height))
+	{
+		for (auto x : std::views::iota(size_t{ 0 }, width))
+		{
+			data[y * width + x] = static_cast<uint8_t>(x + y * 2);
+		}
+	}
+
+	std::vector<compressed::channel<uint8_t>> channels;
+	channels.push_back(compressed::channel<uint8_t>::tiled(
+		std::span<const uint8_t>(data),
+		width,
+		height,
+		16,
+		16,
+		compressed::enums::codec::lz4,
+		9,
+		128
+	));
+	auto image = compressed::image<uint8_t>(std::move(channels), width, height);
+	image.generate_mips();
+
+	std::vector<uint8_t> expected(32 * 24);
+	for (auto y : std::views::iota(size_t{ 0 }, size_t{ 24 }))
+	{
+		for (auto x : std::views::iota(size_t{ 0 }, size_t{ 32 }))
+		{
+			const int64_t sum = static_cast<int64_t>(data[(y * 2) * width + x * 2])
+				+ data[(y * 2) * width + x * 2 + 1]
+				+ data[(y * 2 + 1) * width + x * 2]
+				+ data[(y * 2 + 1) * width + x * 2 + 1];
+			expected[y * 32 + x] = static_cast<uint8_t>((sum + 2) / 4);
+		}
+	}
+
+	const auto& level = image.mip_level(0);
+	CHECK(level.front().width() == 32);
+	CHECK(level.front().height() == 24);
+	CHECK(!level.front().is_tiled());
+	test_util::check_vector_verbose(level.front().get_decompressed(), expected);
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Image mip pyramid invalid access"
+	* doctest::no_breaks(true)
+	* doctest::no_output(true)
+	* doctest::should_fail(true))
+{
+	std::vector<std::vector<uint8_t>> channels = { std::vector<uint8_t>(16 * 16) };
+	auto image = compressed::image<uint8_t>(std::move(channels), 16, 16);
+
+	SUBCASE("mip_level without generate_mips")
+	{
+		[[maybe_unused]] const auto& level = image.mip_level(0);
+	}
+	SUBCASE("mip_level out of range")
+	{
+		image.generate_mips();
+		[[maybe_unused]] const auto& level = image.mip_level(64);
+	}
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Image compression statistics")
+{
+	constexpr size_t width = 64;
+	constexpr size_t height = 64;
+	std::vector<std::vector<uint16_t>> channels;
+	for (auto channel_idx : std::views::iota(size_t{ 0 }, size_t{ 3 }))
+	{
+		std::vector<uint16_t> data(width * height, static_cast<uint16_t>(channel_idx));
+		channels.push_back(std::move(data));
+	}
+	auto image = compressed::image<uint16_t>(std::move(channels), width, height);
+
+	auto stats = image.compression_statistics();
+	CHECK(stats["width"] == width);
+	CHECK(stats["height"] == height);
+	CHECK(stats["num_channels"] == 3);
+	CHECK(stats["uncompressed_bytes"] == 3 * width * height * sizeof(uint16_t));
+	CHECK(stats["compression_ratio"].get<double>() > 0.0);
+
+	CHECK(stats["channels"].size() == 3);
+	size_t compressed_sum = 0;
+	auto channelnames = image.channelnames();
+	for (auto channel_idx : std::views::iota(size_t{ 0 }, size_t{ 3 }))
+	{
+		const auto& entry = stats["channels"][channel_idx];
+		CHECK(entry["name"] == channelnames[channel_idx]);
+		CHECK(entry["chunks"].size() == entry["num_chunks"].get<size_t>());
+		compressed_sum += entry["compressed_bytes"].get<size_t>();
+	}
+	CHECK(stats["compressed_bytes"] == compressed_sum);
+}
+
+
+// ----------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------
+TEST_CASE("Image chunk deduplication")
+{
+	// Three channels dominated by the same constant region, mimicking matte AOVs: most
+	// chunks compress to identical bytes within and across the channels.
+	constexpr size_t width = 256;
+	constexpr size_t height = 256;
+	std::vector<uint8_t> constant(width * height, 0);
+	std::vector<uint8_t> mixed(width * height, 0);
+	std::iota(mixed.begin() + mixed.size() / 2, mixed.end(), static_cast<uint8_t>(0));
+
+	std::vector<compressed::channel<uint8_t>> channels;
+	channels.push_back(compressed::channel<uint8_t>(
+		std::span<const uint8_t>(constant), width, height,
+		compressed::enums::codec::lz4, 9, 256, 4096
+	));
+	channels.push_back(compressed::channel<uint8_t>(
+		std::span<const uint8_t>(constant), width, height,
+		compressed::enums::codec::lz4, 9, 256, 4096
+	));
+	channels.push_back(compressed::channel<uint8_t>(
+		std::span<const uint8_t>(mixed), width, height,
+		compressed::enums::codec::lz4, 9, 256, 4096
+	));
+
+	auto image = compressed::image<uint8_t>(std::move(channels), width, height, { "A", "B", "C" });
+
+	size_t compressed_before = 0;
+	for (const auto& channel : image.channels())
+	{
+		compressed_before += channel.compressed_bytes();
+	}
+
+	auto saved = image.deduplicate_chunks();
+	CHECK(saved > 0);
+
+	size_t compressed_after = 0;
+	for (const auto& channel : image.channels())
+	{
+		compressed_after += channel.compressed_bytes();
+	}
+	// The per-channel sizes only see in-channel sharing, the cross-channel part of the
+	// saving is reported by deduplicate_chunks() itself.
+	CHECK(compressed_after < compressed_before);
+	CHECK(saved >= compressed_before - compressed_after);
+
+	// The data itself is untouched by the deduplication.
+	test_util::check_vector_verbose(image.channel(0).get_decompressed(), constant);
+	test_util::check_vector_verbose(image.channel(2).get_decompressed(), mixed);
+
+	// Copy-on-write: modifying a shared chunk in one channel must not leak into the other.
+	auto chunk_elems = image.channel(0).chunk_elems();
+	std::vector<uint8_t> replacement(chunk_elems, 42);
+	image.channel(0).set_chunk(std::span<uint8_t>(replacement), 0);
+
+	auto modified = image.channel(0).get_decompressed();
+	auto untouched = image.channel(1).get_decompressed();
+	CHECK(std::all_of(modified.begin(), modified.begin() + chunk_elems, [](uint8_t value) { return value == 42; }));
+	test_util::check_vector_verbose(untouched, constant);
+}
+
+
+// ----------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------
+TEST_CASE("Image vertical flip and y-crop")
+{
+	constexpr size_t width = 64;
+	constexpr size_t height = 32;
+	std::vector<uint8_t> data(width * height);
+	std::iota(data.begin(), data.end(), static_cast<uint8_t>(0));
+
+	std::vector<uint8_t> flipped(width * height);
+	for (size_t y = 0; y < height; ++y)
+	{
+		std::copy(
+			data.begin() + y * width,
+			data.begin() + (y + 1) * width,
+			flipped.begin() + (height - 1 - y) * width
+		);
+	}
+
+	auto make_image = [&]()
+		{
+			std::vector<compressed::channel<uint8_t>> channels;
+			channels.push_back(compressed::channel<uint8_t>(
+				std::span<const uint8_t>(data), width, height,
+				compressed::enums::codec::lz4, 9, 128, width * 4
+			));
+			channels.push_back(compressed::channel<uint8_t>(
+				std::span<const uint8_t>(data), width, height,
+				compressed::enums::codec::lz4, 9, 128, width * 4
+			));
+			return compressed::image<uint8_t>(std::move(channels), width, height, { "r", "g" });
+		};
+
+	SUBCASE("Flip applies to all channels and discards mips")
+	{
+		auto image = make_image();
+		image.generate_mips();
+		CHECK(image.num_mip_levels() > 0);
+
+		image.flip_vertical();
+		CHECK(image.num_mip_levels() == 0);
+		for (auto& channel : image.channels())
+		{
+			test_util::check_vector_verbose(channel.get_decompressed(), flipped);
+		}
+	}
+	SUBCASE("Crop updates the image dimensions")
+	{
+		auto image = make_image();
+		image.crop_y(8, 24);
+		CHECK(image.height() == 16);
+		CHECK(image.width() == width);
+
+		std::vector<uint8_t> cropped(data.begin() + 8 * width, data.begin() + 24 * width);
+		for (auto& channel : image.channels())
+		{
+			CHECK(channel.height() == 16);
+			test_util::check_vector_verbose(channel.get_decompressed(), cropped);
+		}
+	}
+}
+
+
+// ----------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------
+TEST_CASE("Read with constrained scratch memory budget")
+{
+	std::string name = "uv_grid_2048x2048.jpg";
+	auto path = std::filesystem::current_path() / "images" / name;
+
+	// A budget of a single byte clamps to the floor of one channel per pass, the three
+	// contiguous RGB channels get read in three narrow passes instead of one wide one.
+	auto image = compressed::image<uint8_t>::read(
+		path,
+		0,
+		compressed::enums::codec::lz4,
+		9,
+		compressed::s_default_blocksize,
+		compressed::s_default_chunksize,
+		1
+	);
+	auto image_data = image.get_decompressed();
+	auto image_ref = test_util::read_oiio<uint8_t>(path);
+	test_util::compare_images(image_data, image_ref, name);
+
+	auto image_default = compressed::image<uint8_t>::read(path);
+
+	// The peak scratch allocation is reported through the statistics surface and must be
+	// strictly lower for the budgeted read.
+	auto budgeted_peak = image.compression_statistics()["read_scratch_peak_bytes"].get<size_t>();
+	auto default_peak = image_default.compression_statistics()["read_scratch_peak_bytes"].get<size_t>();
+	CHECK(budgeted_peak > 0);
+	CHECK(budgeted_peak < default_peak);
+}
+
+
+// ----------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------
+TEST_CASE("Image share_channel copy-on-write view")
+{
+	constexpr size_t width = 64;
+	constexpr size_t height = 32;
+	std::vector<uint8_t> data(width * height);
+	std::iota(data.begin(), data.end(), static_cast<uint8_t>(0));
+
+	std::vector<compressed::channel<uint8_t>> channels;
+	channels.push_back(compressed::channel<uint8_t>(
+		std::span<const uint8_t>(data), width, height,
+		compressed::enums::codec::lz4, 9, 128, width * 4
+	));
+	auto image = compressed::image<uint8_t>(std::move(channels), width, height, { "r" });
+
+	auto view = image.share_channel("r");
+	CHECK(image.channels().size() == 1);
+	test_util::check_vector_verbose(view.get_decompressed(), data);
+
+	// Writes through the view never leak back into the image.
+	std::vector<uint8_t> replacement(view.chunk_elems(0), 7);
+	view.set_chunk(std::span<uint8_t>(replacement), 0);
+	test_util::check_vector_verbose(image.channel(0).get_decompressed(), data);
+}
+
+
+// ----------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------
+TEST_CASE("Read compressed image from an in-memory blob")
+{
+	std::string name = "uv_grid_2048x2048.jpg";
+	auto path = std::filesystem::current_path() / "images" / name;
+
+	// Pull the encoded file into memory, from here on no disk access happens.
+	std::ifstream file(path, std::ios::binary);
+	REQUIRE(file.good());
+	std::vector<std::byte> blob(std::filesystem::file_size(path));
+	file.read(reinterpret_cast<char*>(blob.data()), blob.size());
+
+	auto image = compressed::image<uint8_t>::read_from_memory(
+		std::span<const std::byte>(blob),
+		name
+	);
+	auto image_data = image.get_decompressed();
+	auto image_ref = test_util::read_oiio<uint8_t>(path);
+
+	test_util::compare_images(image_data, image_ref, name);
+}
@@ -0,0 +1,50 @@
+#include "doctest.h"
+
+#include <numeric>
+#include <span>
+#include <vector>
+
+#include <compressed/image_algo.h>
+
+#include "util.h"
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Interleave deinterleave roundtrip parametrized")
+{
+	test_util::parametrize<uint8_t, uint16_t, uint32_t, float>([&]<typename T>([[maybe_unused]] T type)
+		{
+			// Deliberately not a multiple of the internal block size so the remainder path of the
+			// blocked kernels is exercised alongside the specialized 1-4 channel kernels.
+			constexpr size_t num_pixels = 16'384 + 37;
+			for (size_t num_channels : { size_t{ 1 }, size_t{ 2 }, size_t{ 3 }, size_t{ 4 }, size_t{ 5 } })
+			{
+				std::vector<std::vector<T>> channels(num_channels);
+				std::vector<std::span<const T>> channel_spans{};
+				for (size_t i = 0; i < num_channels; ++i)
+				{
+					channels[i].resize(num_pixels);
+					std::iota(channels[i].begin(), channels[i].end(), static_cast<T>(i));
+					channel_spans.push_back(std::span<const T>(channels[i]));
+				}
+
+				std::vector<T> interleaved(num_pixels * num_channels);
+				compressed::image_algo::interleave(std::span<T>(interleaved), channel_spans);
+
+				// Spot-check the interleaved layout.
+				for (size_t i = 0; i < num_channels; ++i)
+				{
+					CHECK(interleaved[i] == channels[i][0]);
+					CHECK(interleaved[(num_pixels - 1) * num_channels + i] == channels[i][num_pixels - 1]);
+				}
+
+				std::vector<std::vector<T>> roundtripped(num_channels, std::vector<T>(num_pixels));
+				compressed::image_algo::deinterleave(std::span<const T>(interleaved), roundtripped);
+				for (size_t i = 0; i < num_channels; ++i)
+				{
+					test_util::check_vector_verbose(roundtripped[i], channels[i]);
+				}
+			}
+		});
+}
@@ -4,6 +4,9 @@
 #include <span>
 #include <vector>
 #include <algorithm>
+#include <execution>
+#include <iterator>
+#include <numeric>
 #include <string>
 
 #include <compressed/image.h>
@@ -81,3 +84,391 @@ TEST_CASE("Iterator: comparison")
 	CHECK(it_other != it);
 	CHECK(it_other != it_2);
 }
+
+
+
+TEST_CASE("Iterator: prefetching matches serial access")
+{
+	std::string name = "uv_grid_2048x2048.jpg";
+	auto path = std::filesystem::current_path() / "images" / name;
+	auto image = compressed::image<uint8_t>::read(
+		path,
+		0,
+		compressed::enums::codec::lz4,
+		9,
+		4096,
+		16384
+	);
+
+	auto& r = image.channel(0);
+	auto expected = r.get_decompressed();
+
+	// Walking with the prefetching iterator has to yield exactly the same chunks as the
+	// regular iterator, the background decompression is an implementation detail.
+	size_t count = 0;
+	size_t offset = 0;
+	auto it = r.async_begin();
+	CHECK(it.prefetch());
+	for (; it != r.end(); ++it)
+	{
+		auto chunk = *it;
+		CHECK(chunk.chunk_index() == count);
+		for (auto value : chunk)
+		{
+			CHECK(value == expected[offset]);
+			++offset;
+		}
+		++count;
+	}
+	CHECK(offset == expected.size());
+}
+
+
+TEST_CASE("Iterator: prefetching writeback")
+{
+	std::string name = "uv_grid_2048x2048.jpg";
+	auto path = std::filesystem::current_path() / "images" / name;
+	auto image = compressed::image<uint8_t>::read(
+		path,
+		0,
+		compressed::enums::codec::lz4,
+		9,
+		4096,
+		16384
+	);
+
+	auto& r = image.channel(0);
+	{
+		auto it = r.async_begin();
+		for (; it != r.end(); ++it)
+		{
+			auto chunk = *it;
+			std::fill(chunk.begin(), chunk.end(), static_cast<uint8_t>(127));
+		}
+	}
+
+	auto modified = r.get_decompressed();
+	test_util::check_vector_verbose(modified, static_cast<uint8_t>(127));
+}
+
+// The iterator satisfies the C++20 random-access iterator concept so channels can be
+// partitioned and sliced by standard algorithms and range adaptors without per-chunk decodes.
+static_assert(std::random_access_iterator<compressed::channel_iterator<uint8_t>>);
+static_assert(std::ranges::random_access_range<decltype(std::declval<compressed::channel<float>&>().chunks())>);
+
+
+TEST_CASE("Iterator: random access seek and arithmetic")
+{
+	std::string name = "uv_grid_2048x2048.jpg";
+	auto path = std::filesystem::current_path() / "images" / name;
+	auto image = compressed::image<uint8_t>::read(
+		path,
+		0,
+		compressed::enums::codec::lz4,
+		9,
+		4096,
+		16384
+	);
+
+	auto& r = image.channel(0);
+	auto expected = r.get_decompressed();
+	const auto num_chunks = static_cast<std::ptrdiff_t>(r.num_chunks());
+	const auto chunk_elems = r.chunk_elems();
+
+	auto it = r.begin();
+	auto end = r.end();
+	CHECK(end - it == num_chunks);
+
+	// Seeking is pure index arithmetic, only the dereference decodes.
+	it += 5;
+	CHECK(it.chunk_index() == 5);
+	{
+		auto chunk = *it;
+		CHECK(chunk.chunk_index() == 5);
+		CHECK(chunk[0] == expected[5 * chunk_elems]);
+	}
+
+	auto it_2 = it + 3;
+	CHECK(it_2 - it == 3);
+	CHECK(it < it_2);
+	CHECK(it_2 > it);
+	CHECK(it <= it_2);
+	CHECK_FALSE(it_2 >= end - 1);
+
+	--it_2;
+	CHECK(it_2.chunk_index() == 7);
+
+	// operator[] dereferences relative to the iterator without moving it.
+	{
+		auto chunk = it_2[-7];
+		CHECK(chunk.chunk_index() == 0);
+		CHECK(chunk[0] == expected[0]);
+		CHECK(it_2.chunk_index() == 7);
+	}
+
+	// Seeking backwards re-decodes just as well as forwards.
+	it -= 5;
+	CHECK(it == r.begin());
+	{
+		auto chunk = *(end - 1);
+		CHECK(chunk.chunk_index() == static_cast<size_t>(num_chunks - 1));
+		CHECK(chunk[0] == expected[(num_chunks - 1) * chunk_elems]);
+	}
+}
+
+
+TEST_CASE("Iterator: writeback after random access seeks")
+{
+	std::string name = "uv_grid_2048x2048.jpg";
+	auto path = std::filesystem::current_path() / "images" / name;
+	auto image = compressed::image<uint8_t>::read(
+		path,
+		0,
+		compressed::enums::codec::lz4,
+		9,
+		4096,
+		16384
+	);
+
+	auto& r = image.channel(0);
+	auto expected = r.get_decompressed();
+	const auto chunk_elems = r.chunk_elems();
+
+	{
+		// Modify chunk 3 through a seeked iterator, then jump backwards to chunk 1: the
+		// pending modification has to be written back to chunk 3, not chunk 2.
+		auto it = r.begin() + 3;
+		auto chunk = *it;
+		std::fill(chunk.begin(), chunk.end(), static_cast<uint8_t>(50));
+
+		it -= 2;
+		auto other = *it;
+		std::fill(other.begin(), other.end(), static_cast<uint8_t>(60));
+	}
+
+	auto modified = r.get_decompressed();
+	for (size_t idx = 0; idx < modified.size(); ++idx)
+	{
+		const auto chunk_idx = idx / chunk_elems;
+		if (chunk_idx == 3)
+		{
+			CHECK(modified[idx] == 50);
+		}
+		else if (chunk_idx == 1)
+		{
+			CHECK(modified[idx] == 60);
+		}
+		else
+		{
+			CHECK(modified[idx] == expected[idx]);
+		}
+	}
+}
+
+
+TEST_CASE("Iterator: chunks range adaptor")
+{
+	std::string name = "uv_grid_2048x2048.jpg";
+	auto path = std::filesystem::current_path() / "images" / name;
+	auto image = compressed::image<uint8_t>::read(
+		path,
+		0,
+		compressed::enums::codec::lz4,
+		9,
+		4096,
+		16384
+	);
+
+	auto& r = image.channel(0);
+	auto expected = r.get_decompressed();
+	const auto num_chunks = r.num_chunks();
+	const auto chunk_elems = r.chunk_elems();
+
+	auto range = r.chunks();
+	CHECK(static_cast<size_t>(std::ranges::distance(range)) == num_chunks);
+
+	// Slicing through a range adaptor only decodes the chunks that are actually visited.
+	size_t count = num_chunks - 2;
+	for (auto chunk : range | std::views::drop(num_chunks - 2))
+	{
+		CHECK(chunk.chunk_index() == count);
+		CHECK(chunk[0] == expected[count * chunk_elems]);
+		++count;
+	}
+	CHECK(count == num_chunks);
+
+	// Parallel read over the partitioned range, each worker walks its own iterator copy with
+	// its own pooled contexts. Collect per-chunk values and verify serially, doctest
+	// assertions are not thread-safe.
+	std::vector<uint8_t> first_values(num_chunks);
+	std::for_each(std::execution::par, range.begin(), range.end(), [&](auto chunk)
+		{
+			first_values[chunk.chunk_index()] = chunk[0];
+		});
+	for (size_t idx = 0; idx < num_chunks; ++idx)
+	{
+		CHECK(first_values[idx] == expected[idx * chunk_elems]);
+	}
+}
+
+
+TEST_CASE("Iterator: seek out of bounds"
+	* doctest::no_breaks(true)
+	* doctest::no_output(true)
+	* doctest::should_fail(true))
+{
+	std::string name = "uv_grid_2048x2048.jpg";
+	auto path = std::filesystem::current_path() / "images" / name;
+	auto image = compressed::image<uint8_t>::read(path);
+
+	auto& r = image.channel(0);
+	auto it = r.begin();
+	it += static_cast<std::ptrdiff_t>(r.num_chunks()) + 1;
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Iterator: checksum-gated write-back")
+{
+	constexpr size_t width = 128;
+	constexpr size_t height = 64;
+	std::vector<float> data(width * height);
+	std::iota(data.begin(), data.end(), 0.0f);
+
+	auto channel = compressed::channel<float>(
+		std::span<const float>(data), width, height,
+		compressed::enums::codec::lz4, 9, compressed::s_default_blocksize, width * 16 * sizeof(float)
+	);
+
+	SUBCASE("A pure read pass leaves the data intact")
+	{
+		for (auto chunk : channel)
+		{
+			CHECK(chunk.size() > 0);
+		}
+		test_util::check_vector_verbose(channel.get_decompressed(), data);
+	}
+
+	SUBCASE("Modified chunks are still written back")
+	{
+		// Only touch the second chunk, the dirty gate has to recompress exactly that one while
+		// the untouched chunks skip the codec.
+		for (auto chunk : channel)
+		{
+			if (chunk.chunk_index() == 1)
+			{
+				for (auto& px : chunk)
+				{
+					px += 100.0f;
+				}
+			}
+		}
+
+		auto expected = data;
+		const size_t chunk_elems = channel.chunk_elems();
+		for (size_t idx = chunk_elems; idx < 2 * chunk_elems; ++idx)
+		{
+			expected[idx] += 100.0f;
+		}
+		test_util::check_vector_verbose(channel.get_decompressed(), expected);
+	}
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Iterator: read-only iteration over a const channel")
+{
+	constexpr size_t width = 128;
+	constexpr size_t height = 64;
+	std::vector<float> data(width * height);
+	std::iota(data.begin(), data.end(), 0.0f);
+
+	auto channel = compressed::channel<float>(
+		std::span<const float>(data), width, height,
+		compressed::enums::codec::lz4, 9, compressed::s_default_blocksize, width * 16 * sizeof(float)
+	);
+
+	SUBCASE("Writes through the read-only view never persist")
+	{
+		const auto& const_channel = channel;
+		for (auto chunk : const_channel)
+		{
+			for (auto& px : chunk)
+			{
+				px = 0.0f;
+			}
+		}
+		test_util::check_vector_verbose(channel.get_decompressed(), data);
+	}
+
+	SUBCASE("Pending map transforms are fused into each dereference")
+	{
+		channel.map([](std::span<float> chunk) { for (auto& px : chunk) { px *= 2.0f; } });
+
+		const auto& const_channel = channel;
+		size_t chunk_offset = 0;
+		for (auto chunk : const_channel)
+		{
+			for (size_t idx = 0; idx < chunk.size(); ++idx)
+			{
+				CHECK(chunk[idx] == data[chunk_offset + idx] * 2.0f);
+			}
+			chunk_offset += chunk.size();
+		}
+
+		// Read-only iteration never materializes the queue, the storage stays untouched.
+		CHECK(channel.num_pending_transforms() == 1);
+	}
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Iterator: random access across a truncated final chunk")
+{
+	// 70 scanlines at 16 scanlines per chunk leaves a truncated 6-scanline final chunk, so
+	// revisiting a full-size chunk after decoding the last one has to re-expand the buffer.
+	constexpr size_t width = 128;
+	constexpr size_t height = 70;
+	std::vector<float> data(width * height);
+	std::iota(data.begin(), data.end(), 0.0f);
+
+	auto channel = compressed::channel<float>(
+		std::span<const float>(data), width, height,
+		compressed::enums::codec::lz4, 9, compressed::s_default_blocksize, width * 16 * sizeof(float)
+	);
+	const size_t num_chunks = channel.num_chunks();
+	const size_t chunk_elems = channel.chunk_elems();
+	REQUIRE(channel.chunk_elems(num_chunks - 1) < chunk_elems);
+
+	auto it = channel.begin();
+	{
+		// operator[] seeks forward to the truncated chunk without moving the iterator.
+		auto chunk = it[static_cast<std::ptrdiff_t>(num_chunks - 1)];
+		CHECK(chunk.size() == channel.chunk_elems(num_chunks - 1));
+		CHECK(chunk[0] == data[(num_chunks - 1) * chunk_elems]);
+	}
+	{
+		// Dereferencing a full-size chunk right after holding the truncated one.
+		auto chunk = *it;
+		CHECK(chunk.size() == chunk_elems);
+		CHECK(chunk[0] == data[0]);
+	}
+
+	// The same roundtrip through explicit seeks, ending on a backwards jump.
+	it += static_cast<std::ptrdiff_t>(num_chunks - 1);
+	{
+		auto chunk = *it;
+		CHECK(chunk.size() == channel.chunk_elems(num_chunks - 1));
+	}
+	it -= static_cast<std::ptrdiff_t>(num_chunks - 1);
+	{
+		auto chunk = *it;
+		CHECK(chunk.size() == chunk_elems);
+	}
+
+	// A pure read pass, the data has to come out untouched.
+	test_util::check_vector_verbose(channel.get_decompressed(), data);
+}
@@ -5,11 +5,17 @@
 #include <vector>
 #include <algorithm>
 #include <thread>
+#include <mutex>
 #include <string>
 #include <numeric>
+#include <filesystem>
 
+#include <compressed/channel.h>
 #include <compressed/blosc2/schunk.h>
+#include <compressed/blosc2/mmapschunk.h>
+#include <compressed/blosc2/dedupschunk.h>
 #include <compressed/blosc2/wrapper.h>
+#include <compressed/detail/codec_scheduler.h>
 
 #include "util.h"
 
@@ -72,4 +78,470 @@ TEST_CASE("Schunk: initialize with data")
 				CHECK(chunk.size() == 256 / sizeof(T));
 			}
 		});
-}
\ No newline at end of file
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Schunk: parallel construction matches the serial path")
+{
+	test_util::parametrize<uint8_t, uint16_t, uint32_t, float>([&]<typename T>([[maybe_unused]] T type)
+		{
+			// Non chunk-aligned size so the remainder chunk is exercised as well.
+			std::vector<T> data(4096 + 64 / sizeof(T));
+			std::iota(data.begin(), data.end(), T{ 0 });
+
+			auto ctx = compressed::blosc2::create_compression_context<T>(
+				1,
+				compressed::enums::codec::lz4,
+				9,
+				64
+			);
+			compressed::blosc2::schunk<T> serial(std::span<const T>(data), 64, 256, ctx);
+			compressed::blosc2::schunk<T> parallel(
+				std::span<const T>(data), 64, 256, compressed::enums::codec::lz4, 9
+			);
+
+			CHECK(parallel.num_chunks() == serial.num_chunks());
+
+			auto decomp_ctx = compressed::blosc2::create_decompression_context(std::thread::hardware_concurrency());
+			SUBCASE("Check decompressed")
+			{
+				auto decompressed = parallel.to_uncompressed(decomp_ctx);
+				CHECK(decompressed.size() == data.size());
+				CHECK(decompressed == data);
+			}
+			SUBCASE("Per-chunk roundtrip")
+			{
+				for (auto idx : std::views::iota(size_t{ 0 }, parallel.num_chunks()))
+				{
+					auto chunk_parallel = parallel.chunk(decomp_ctx, idx);
+					auto chunk_serial = serial.chunk(decomp_ctx, idx);
+					CHECK(chunk_parallel == chunk_serial);
+				}
+			}
+		});
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Mmap schunk: initialize with data")
+{
+	test_util::parametrize<uint8_t, uint16_t, uint32_t, float>([&]<typename T>([[maybe_unused]] T type)
+		{
+			std::vector<T> data(4096);
+			std::iota(data.begin(), data.end(), T{ 0 });
+
+			auto ctx = compressed::blosc2::create_compression_context<T>(
+				std::thread::hardware_concurrency(),
+				compressed::enums::codec::lz4,
+				9,
+				128
+			);
+			auto spill_path = std::filesystem::temp_directory_path() / "compressed_image_mmap_schunk.spill";
+			compressed::blosc2::mmap_schunk<T> super_chunk(std::span<const T>(data), spill_path, 64, 256, ctx);
+			CHECK(std::filesystem::exists(spill_path));
+
+			auto decomp_ctx = compressed::blosc2::create_decompression_context(std::thread::hardware_concurrency());
+			SUBCASE("Check decompressed")
+			{
+				// We expect the same number of elements
+				auto decompressed = super_chunk.to_uncompressed(decomp_ctx);
+				CHECK(decompressed.size() == 4096);
+				CHECK(decompressed == data);
+			}
+			SUBCASE("Get chunk")
+			{
+				auto chunk = super_chunk.chunk(decomp_ctx, 0);
+				CHECK(chunk.size() == 256 / sizeof(T));
+			}
+			SUBCASE("Set chunk in place")
+			{
+				auto replacement = std::vector<T>(256 / sizeof(T), static_cast<T>(42));
+				super_chunk.set_chunk(ctx, std::span<T>(replacement), 0);
+				auto chunk = super_chunk.chunk(decomp_ctx, 0);
+				CHECK(chunk == replacement);
+			}
+		});
+
+	// The spill file is owned by the schunk and removed with it.
+	CHECK(!std::filesystem::exists(std::filesystem::temp_directory_path() / "compressed_image_mmap_schunk.spill"));
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Mmap schunk: append and grow")
+{
+	auto ctx = compressed::blosc2::create_compression_context<uint8_t>(
+		std::thread::hardware_concurrency(),
+		compressed::enums::codec::lz4,
+		9,
+		128
+	);
+	auto spill_path = std::filesystem::temp_directory_path() / "compressed_image_mmap_schunk_append.spill";
+	compressed::blosc2::mmap_schunk<uint8_t> super_chunk(spill_path, 128, 4096);
+
+	// Append enough chunks to force the mapping to grow beyond its initial capacity.
+	auto chunk_data = std::vector<uint8_t>(4096, 255);
+	for ([[maybe_unused]] auto idx : std::views::iota(size_t{ 0 }, size_t{ 8 }))
+	{
+		super_chunk.append_chunk(ctx, std::span<uint8_t>(chunk_data));
+	}
+	CHECK(super_chunk.num_chunks() == 8);
+
+	auto decomp_ctx = compressed::blosc2::create_decompression_context(std::thread::hardware_concurrency());
+	auto decompressed = super_chunk.to_uncompressed(decomp_ctx);
+	CHECK(decompressed.size() == 8 * 4096);
+	test_util::check_vector_verbose(decompressed, static_cast<uint8_t>(255));
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Context pool reuse")
+{
+	compressed::blosc2::context_pool pool;
+
+	// The first checkout creates a context, dropping the lease returns it to the pool so the
+	// second checkout with the same configuration reuses it.
+	{
+		auto lease = pool.checkout_decompression(2);
+		CHECK(lease.ctx() != nullptr);
+		CHECK(pool.num_pooled() == 0);
+	}
+	CHECK(pool.num_pooled() == 1);
+	{
+		auto lease = pool.checkout_decompression(2);
+		CHECK(pool.num_pooled() == 0);
+	}
+	CHECK(pool.num_pooled() == 1);
+
+	// A different configuration gets its own context.
+	{
+		auto comp_lease = pool.checkout_compression<uint8_t>(1, compressed::enums::codec::lz4, 9, 128);
+		CHECK(comp_lease.ctx() != nullptr);
+		CHECK(pool.num_pooled() == 1);
+	}
+	CHECK(pool.num_pooled() == 2);
+
+	pool.clear();
+	CHECK(pool.num_pooled() == 0);
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Thread budget sharing")
+{
+	auto previous = compressed::thread_budget();
+
+	compressed::thread_budget(8);
+	CHECK(compressed::thread_budget() == 8);
+
+	// The per-consumer share shrinks as more channels come alive but never drops below one.
+	auto vec = std::vector<uint8_t>(50);
+	std::vector<compressed::channel<uint8_t>> channels{};
+	for ([[maybe_unused]] auto idx : std::views::iota(size_t{ 0 }, size_t{ 16 }))
+	{
+		channels.push_back(compressed::channel<uint8_t>(std::span<uint8_t>(vec), 10, 5));
+	}
+	CHECK(compressed::detail::shared_nthreads() >= 1);
+	CHECK(compressed::detail::shared_nthreads() <= 8);
+
+	compressed::thread_budget(previous);
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Mmap schunk: channel roundtrip")
+{
+	auto vec = std::vector<uint8_t>(8192);
+	std::iota(vec.begin(), vec.end(), 0);
+
+	auto ctx = compressed::blosc2::create_compression_context<uint8_t>(
+		std::thread::hardware_concurrency(),
+		compressed::enums::codec::lz4,
+		9,
+		128
+	);
+	auto spill_path = std::filesystem::temp_directory_path() / "compressed_image_mmap_schunk_channel.spill";
+	auto super_chunk = compressed::blosc2::mmap_schunk<uint8_t>(std::span<const uint8_t>(vec), spill_path, 128, 4096, ctx);
+
+	auto channel = compressed::channel<uint8_t>(
+		compressed::blosc2::schunk_var<uint8_t>(std::move(super_chunk)), 128, 64
+	);
+	auto roundtripped = channel.get_decompressed();
+
+	CHECK(vec == roundtripped);
+}
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Dedup schunk: shares identical chunks")
+{
+	test_util::parametrize<uint8_t, uint16_t, uint32_t, float>([&]<typename T>([[maybe_unused]] T type)
+		{
+			// Constant data: every chunk compresses to the same bytes, the dedup conversion
+			// should collapse them to a single shared chunk.
+			std::vector<T> data(4096, static_cast<T>(7));
+
+			auto ctx = compressed::blosc2::create_compression_context<T>(
+				std::thread::hardware_concurrency(),
+				compressed::enums::codec::lz4,
+				9,
+				128
+			);
+			compressed::blosc2::schunk<T> super_chunk(std::span<const T>(data), 128, 1024, ctx);
+			const auto csize_before = super_chunk.csize();
+			const auto num_chunks = super_chunk.num_chunks();
+			CHECK(num_chunks == 4096 * sizeof(T) / 1024);
+
+			auto store = std::make_shared<compressed::blosc2::detail::chunk_store>();
+			compressed::blosc2::dedup_schunk<T> deduplicated(super_chunk, store);
+
+			CHECK(deduplicated.num_chunks() == num_chunks);
+			CHECK(deduplicated.num_unique_chunks() == 1);
+			CHECK(deduplicated.csize() < csize_before);
+			CHECK(deduplicated.csize() == store->total_bytes());
+
+			// Reads must be byte-for-byte identical to the original schunk.
+			auto decomp_ctx = compressed::blosc2::create_decompression_context(std::thread::hardware_concurrency());
+			auto decompressed = deduplicated.to_uncompressed(decomp_ctx);
+			CHECK(decompressed == data);
+		});
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Dedup schunk: copy on write")
+{
+	test_util::parametrize<uint8_t, uint16_t, uint32_t, float>([&]<typename T>([[maybe_unused]] T type)
+		{
+			std::vector<T> data(4096, static_cast<T>(7));
+
+			auto ctx = compressed::blosc2::create_compression_context<T>(
+				std::thread::hardware_concurrency(),
+				compressed::enums::codec::lz4,
+				9,
+				128
+			);
+			compressed::blosc2::schunk<T> super_chunk(std::span<const T>(data), 128, 1024, ctx);
+
+			auto store = std::make_shared<compressed::blosc2::detail::chunk_store>();
+			compressed::blosc2::dedup_schunk<T> deduplicated(super_chunk, store);
+			REQUIRE(deduplicated.num_unique_chunks() == 1);
+
+			// Writing to one chunk must detach it from the shared copy, not modify it in place.
+			const size_t chunk_elems = 1024 / sizeof(T);
+			std::vector<T> replacement(chunk_elems);
+			std::iota(replacement.begin(), replacement.end(), static_cast<T>(0));
+			deduplicated.set_chunk(ctx, std::span<T>(replacement), 1);
+
+			CHECK(deduplicated.num_unique_chunks() == 2);
+
+			auto decomp_ctx = compressed::blosc2::create_decompression_context(std::thread::hardware_concurrency());
+			auto chunk_0 = deduplicated.chunk(decomp_ctx, 0);
+			auto chunk_1 = deduplicated.chunk(decomp_ctx, 1);
+			CHECK(std::all_of(chunk_0.begin(), chunk_0.end(), [](T value) { return value == static_cast<T>(7); }));
+			CHECK(chunk_1 == replacement);
+
+			// Rewriting the original constant content has to re-share with the still-live chunk.
+			std::vector<T> constant(chunk_elems, static_cast<T>(7));
+			deduplicated.set_chunk(ctx, std::span<T>(constant), 1);
+			CHECK(deduplicated.num_unique_chunks() == 1);
+		});
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Dict schunk: roundtrip through schunk-owned contexts")
+{
+	test_util::parametrize<uint8_t, uint16_t, uint32_t, float>([&]<typename T>([[maybe_unused]] T type)
+		{
+			// Many small chunks with a shared structure, the workload dictionaries exist for.
+			constexpr size_t chunk_elems = 512;
+			constexpr size_t num_chunks = 16;
+
+			auto schunk = compressed::blosc2::create_dict_schunk<T>(1, 9, 128);
+			std::vector<std::vector<T>> chunks;
+			for (size_t chunk_idx = 0; chunk_idx < num_chunks; ++chunk_idx)
+			{
+				std::vector<T> chunk(chunk_elems);
+				std::iota(chunk.begin(), chunk.end(), static_cast<T>(chunk_idx));
+				auto nchunks = compressed::blosc2::append_buffer(schunk, std::span<const T>(chunk));
+				CHECK(nchunks == chunk_idx + 1);
+				chunks.push_back(std::move(chunk));
+			}
+
+			for (size_t chunk_idx = 0; chunk_idx < num_chunks; ++chunk_idx)
+			{
+				std::vector<T> decompressed(chunk_elems);
+				auto nbytes = compressed::blosc2::decompress_chunk(schunk, chunk_idx, std::span<T>(decompressed));
+				CHECK(nbytes == chunk_elems * sizeof(T));
+				test_util::check_vector_verbose(decompressed, chunks[chunk_idx]);
+			}
+		});
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Dict compression rejects non-zstd codec"
+	* doctest::no_breaks(true)
+	* doctest::no_output(true)
+	* doctest::should_fail(true))
+{
+	auto ctx = compressed::blosc2::create_compression_context<uint8_t>(
+		1,
+		compressed::enums::codec::lz4,
+		9,
+		128,
+		compressed::enums::filter::shuffle,
+		true // use_dict
+	);
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Frame schunk: roundtrip and contiguous payload")
+{
+	test_util::parametrize<uint8_t, uint16_t, uint32_t, float>([&]<typename T>([[maybe_unused]] T type)
+		{
+			std::vector<T> data(4096);
+			std::iota(data.begin(), data.end(), T{ 0 });
+
+			auto ctx = compressed::blosc2::create_compression_context<T>(
+				std::thread::hardware_concurrency(),
+				compressed::enums::codec::lz4,
+				9,
+				128
+			);
+			auto decomp_ctx = compressed::blosc2::create_decompression_context(std::thread::hardware_concurrency());
+
+			compressed::blosc2::frame_schunk<T> frame(std::span<const T>(data), 64, 256, ctx);
+
+			SUBCASE("Decompressed data matches")
+			{
+				auto decompressed = frame.to_uncompressed(decomp_ctx);
+				test_util::check_vector_verbose(decompressed, data);
+			}
+			SUBCASE("Payload is the sum of the chunks")
+			{
+				CHECK(frame.payload().size() == frame.csize());
+				size_t total = 0;
+				for (size_t idx = 0; idx < frame.num_chunks(); ++idx)
+				{
+					total += frame.compressed_chunk(idx).size();
+				}
+				CHECK(total == frame.payload().size());
+			}
+			SUBCASE("Conversion from a heap-backed schunk is byte identical")
+			{
+				compressed::blosc2::schunk<T> heap(std::span<const T>(data), 64, 256, ctx);
+				compressed::blosc2::frame_schunk<T> converted(heap);
+				CHECK(converted.num_chunks() == heap.num_chunks());
+				CHECK(converted.csize() == heap.csize());
+				for (size_t idx = 0; idx < heap.num_chunks(); ++idx)
+				{
+					const auto& expected = heap.compressed_chunk(idx);
+					auto actual = converted.compressed_chunk(idx);
+					CHECK(std::equal(actual.begin(), actual.end(), expected.begin(), expected.end()));
+				}
+			}
+			SUBCASE("Overwriting a chunk shifts the payload correctly")
+			{
+				// Rewrite a middle chunk with different content; its compressed size will differ
+				// so the extents behind it have to be refitted.
+				std::vector<T> replacement(frame.chunk_elements(1), T{ 42 });
+				frame.set_chunk(ctx, std::span<T>(replacement), 1);
+
+				auto expected = data;
+				std::fill(
+					expected.begin() + frame.chunk_elements(),
+					expected.begin() + frame.chunk_elements() + replacement.size(),
+					T{ 42 }
+				);
+				auto decompressed = frame.to_uncompressed(decomp_ctx);
+				test_util::check_vector_verbose(decompressed, expected);
+			}
+		});
+}
+
+
+// -----------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------
+TEST_CASE("Codec scheduler slot accounting and priorities")
+{
+	compressed::detail::codec_scheduler scheduler;
+	scheduler.max_concurrency(1);
+	CHECK(scheduler.max_concurrency() == 1);
+	// The limit clamps to at least one slot, otherwise nothing could ever run.
+	scheduler.max_concurrency(0);
+	CHECK(scheduler.max_concurrency() == 1);
+
+	SUBCASE("Permits hold and return slots")
+	{
+		{
+			auto permit = scheduler.acquire(compressed::detail::codec_scheduler::priority::background);
+			CHECK(scheduler.num_running() == 1);
+		}
+		CHECK(scheduler.num_running() == 0);
+	}
+
+	SUBCASE("Interactive waiters are granted before background ones")
+	{
+		std::vector<int> grant_order{};
+		std::mutex order_mutex;
+
+		// Occupy the only slot so both waiters queue up behind it, then release it and
+		// check the decode-priority waiter went first even though it arrived second.
+		auto blocker = scheduler.acquire(compressed::detail::codec_scheduler::priority::background);
+
+		std::thread background([&]
+		{
+			auto permit = scheduler.acquire(compressed::detail::codec_scheduler::priority::background);
+			std::lock_guard<std::mutex> lock(order_mutex);
+			grant_order.push_back(1);
+		});
+		while (scheduler.num_waiting() < 1)
+		{
+			std::this_thread::yield();
+		}
+		std::thread interactive([&]
+		{
+			auto permit = scheduler.acquire(compressed::detail::codec_scheduler::priority::interactive);
+			std::lock_guard<std::mutex> lock(order_mutex);
+			grant_order.push_back(0);
+		});
+		while (scheduler.num_waiting() < 2)
+		{
+			std::this_thread::yield();
+		}
+
+		{
+			auto release = std::move(blocker);
+		}
+		interactive.join();
+		background.join();
+
+		REQUIRE(grant_order.size() == 2);
+		CHECK(grant_order[0] == 0);
+		CHECK(grant_order[1] == 1);
+		CHECK(scheduler.num_running() == 0);
+		CHECK(scheduler.num_waiting() == 0);
+	}
+
+	SUBCASE("Library-wide concurrency knob")
+	{
+		auto previous = compressed::codec_concurrency();
+		compressed::codec_concurrency(4);
+		CHECK(compressed::codec_concurrency() == 4);
+		compressed::codec_concurrency(previous);
+	}
+}
@@ -0,0 +1,86 @@
+#include "doctest.h"
+
+#include <atomic>
+#include <numeric>
+#include <span>
+#include <vector>
+
+#include <compressed/channel.h>
+#include <compressed/detail/scoped_timer.h>
+
+#include "util.h"
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+TEST_CASE("Telemetry counters track codec work")
+{
+	constexpr size_t width = 64;
+	constexpr size_t height = 64;
+
+	auto vec = std::vector<uint8_t>(width * height);
+	std::iota(vec.begin(), vec.end(), 0);
+
+	compressed::reset_telemetry();
+
+	auto channel = compressed::channel<uint8_t>(
+		std::span<const uint8_t>(vec),
+		width,
+		height,
+		compressed::enums::codec::lz4,
+		9,
+		256,
+		1024
+	);
+	CHECK(channel.num_chunks() > 1);
+
+	// Constructing the channel compresses every chunk, the byte counters refer to the
+	// uncompressed side of the codec.
+	auto after_compress = compressed::telemetry();
+	CHECK(after_compress.bytes_compressed >= vec.size() * sizeof(uint8_t));
+	CHECK(after_compress.chunks_compressed >= channel.num_chunks());
+
+	auto decompressed = channel.get_decompressed();
+	test_util::check_vector_verbose(decompressed, vec);
+
+	auto after_decompress = compressed::telemetry();
+	CHECK(after_decompress.bytes_decompressed >= vec.size() * sizeof(uint8_t));
+	CHECK(after_decompress.chunks_decompressed >= channel.num_chunks());
+
+	compressed::reset_telemetry();
+	auto after_reset = compressed::telemetry();
+	CHECK(after_reset.bytes_compressed == 0);
+	CHECK(after_reset.bytes_decompressed == 0);
+	CHECK(after_reset.chunks_compressed == 0);
+	CHECK(after_reset.chunks_decompressed == 0);
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+TEST_CASE("Telemetry profile callback receives scopes")
+{
+	constexpr size_t width = 64;
+	constexpr size_t height = 64;
+
+	auto vec = std::vector<uint8_t>(width * height, 1);
+	auto channel = compressed::channel<uint8_t>(
+		std::span<const uint8_t>(vec),
+		width,
+		height
+	);
+
+	std::atomic<size_t> num_events = 0;
+	compressed::profile_callback([&](const compressed::profile_event& event)
+		{
+			CHECK(!event.name.empty());
+			CHECK(event.end_us >= event.start_us);
+			++num_events;
+		});
+
+	auto decompressed = channel.get_decompressed();
+	compressed::profile_callback(nullptr);
+
+	CHECK(num_events.load() > 0);
+	test_util::check_vector_verbose(decompressed, vec);
+}